@@ -0,0 +1,90 @@
+/**
+ * @file bench.h
+ * @brief Small timing helpers shared by the mylib benchmarks.
+ * @author Guillaume
+ * @date 18/10/2026
+ */
+
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace bench
+{
+    /**
+     * @brief Runs a function until at least minSeconds elapsed and returns the best time of one call.
+     * @tparam Func Callable taking no argument.
+     * @param func The code to measure.
+     * @param minSeconds Minimum total measuring time.
+     * @return Fastest observed call, in seconds.
+     */
+    template<typename Func>
+    double measure(Func&& func, double minSeconds = 0.2)
+    {
+        using clock = std::chrono::steady_clock;
+
+        double best = 1e30;
+        double total = 0.0;
+        do
+        {
+            const auto start = clock::now();
+            func();
+            const double elapsed = std::chrono::duration<double>(clock::now() - start).count();
+            best = elapsed < best ? elapsed : best;
+            total += elapsed;
+        } while (total < minSeconds);
+
+        return best;
+    }
+
+    /**
+     * @brief Fills a range with uniform random values in [-1, 1].
+     * @param data First element.
+     * @param count Number of elements.
+     * @param seed Seed of the generator.
+     */
+    template<typename T>
+    void fillRandom(T* data, size_t count, unsigned seed = 42)
+    {
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+        for (size_t i = 0; i < count; ++i)
+            data[i] = T(distribution(generator));
+    }
+
+    /**
+     * @brief Thread counts of a strong scaling run: the powers of two below the number of hardware threads, then that number.
+     * @return 1, 2, 4, ..., hardware threads.
+     */
+    inline std::vector<size_t> threadCounts()
+    {
+        const size_t hardware = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1;
+
+        std::vector<size_t> counts;
+        for (size_t count = 1; count < hardware; count *= 2)
+            counts.push_back(count);
+        counts.push_back(hardware);
+        return counts;
+    }
+
+    void runGemm();
+    void runGemmParallel();
+    void runTranspose();
+    void runSparse();
+    void runTransform();
+    void runGemv();
+    void runBatched();
+    void runLayout();
+    void runPacked();
+    void runQuantized();
+    void runChain();
+    void runSort();
+    void runSortParallel();
+    void runMemory();
+    void runExecution();
+    void runScan();
+}
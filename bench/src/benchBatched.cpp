@@ -0,0 +1,63 @@
+/**
+ * @file benchBatched.cpp
+ * @brief Batched products of small matrices (3x3 to 16x16): one product call per pair against Math::batchedMultiply,
+ * on a batch that stays in L2 and on one streamed from memory.
+ * @author Guillaume
+ * @date 18/10/2026
+ */
+
+#include <cstdio>
+#include <vector>
+#include "bench.h"
+#include "mathLib.h"
+#include "myBatched.h"
+
+namespace
+{
+    template<typename T, size_t S>
+    void benchSize(size_t elements)
+    {
+        // Odd counts leave a partial last group
+        const size_t count = elements / (S * S) + 1;
+        std::vector<myMatrix<T, S, S>> a(count);
+        std::vector<myMatrix<T, S, S>> b(count);
+        std::vector<myMatrix<T, S, S>> c(count);
+        bench::fillRandom(a[0].data(), count * S * S, 1);
+        bench::fillRandom(b[0].data(), count * S * S, 2);
+
+        const double flops = 2.0 * count * S * S * S;
+        const double pairTime = bench::measure([&]
+        {
+            for (size_t i = 0; i < count; ++i)
+                Math::multiply(a[i], b[i], c[i]);
+        });
+        const double batchTime = bench::measure([&] { Math::batchedMultiply(a, b, c); });
+
+        std::printf("%2zux%-2zu %9zu %10.2f %10.2f %8.1fx %10.2f\n", S, S, count, flops / pairTime * 1e-9, flops / batchTime * 1e-9,
+            pairTime / batchTime, count / batchTime * 1e-6);
+    }
+
+    template<typename T>
+    void benchSizes(const char* typeName)
+    {
+        std::printf("%s (GFLOP/s)\n%5s %9s %10s %10s %9s %10s\n", typeName, "size", "count", "per pair", "batched", "speedup", "Mmat/s");
+        for (size_t elements : { size_t(16384), size_t(9000000) })
+        {
+            benchSize<T, 3>(elements);
+            benchSize<T, 4>(elements);
+            benchSize<T, 6>(elements);
+            benchSize<T, 8>(elements);
+            benchSize<T, 12>(elements);
+            benchSize<T, 16>(elements);
+        }
+    }
+}
+
+namespace bench
+{
+    void runBatched()
+    {
+        benchSizes<float>("float");
+        benchSizes<double>("double");
+    }
+}
@@ -0,0 +1,65 @@
+/**
+ * @file benchChain.cpp
+ * @brief Chains of differently shaped matrices: the left-to-right product of operator* against glg::chainMultiply.
+ * @author Guillaume
+ * @date 18/10/2026
+ */
+
+#include <array>
+#include <cstdio>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include "bench.h"
+#include "myChain.h"
+#include "myMatrix.h"
+
+namespace
+{
+    /**
+     * @brief Number of multiply-adds of the left-to-right order.
+     */
+    template<size_t count>
+    constexpr size_t leftToRightCost(const std::array<size_t, count + 1>& dims)
+    {
+        size_t cost = 0;
+        for (size_t i = 1; i < count; ++i)
+            cost += dims[0] * dims[i] * dims[i + 1];
+        return cost;
+    }
+
+    template<typename T, size_t... dims>
+    void benchChain(const char* name)
+    {
+        constexpr std::array<size_t, sizeof...(dims)> shape = { dims... };
+        constexpr size_t count = shape.size() - 1;
+
+        // Operand i is shape[i] x shape[i + 1], on the heap
+        auto operands = [&]<size_t... i>(std::index_sequence<i...>)
+        {
+            return std::make_tuple(std::make_unique<myMatrix<T, shape[i], shape[i + 1]>>()...);
+        }(std::make_index_sequence<count>());
+        std::apply([](auto&... matrix) { (bench::fillRandom(matrix->data(), matrix->Size(), unsigned(matrix->Size())), ...); }, operands);
+
+        using Result = myMatrix<T, shape[0], shape[count]>;
+        auto result = std::make_unique<Result>();
+        const double leftTime = bench::measure([&] { std::apply([&](auto&... matrix) { *result = (... * *matrix); }, operands); });
+        const double chainTime = bench::measure([&] { std::apply([&](auto&... matrix) { *result = glg::chainMultiply(*matrix...); }, operands); });
+
+        constexpr size_t leftCost = leftToRightCost<count>(shape);
+        constexpr size_t bestCost = glg::planChain<count>(shape).cost[0][count - 1];
+        std::printf("%-28s %12zu %12zu %10.3f %10.3f %8.1fx\n", name, leftCost, bestCost, leftTime * 1e3, chainTime * 1e3, leftTime / chainTime);
+    }
+}
+
+namespace bench
+{
+    void runChain()
+    {
+        std::printf("%-28s %12s %12s %10s %10s %9s\n", "chain (float)", "left MACs", "best MACs", "left ms", "best ms", "speedup");
+        benchChain<float, 512, 16, 512, 16, 512, 8>("512x16 ... 512x8 (5)");
+        benchChain<float, 10, 1000, 10, 1000, 10>("10x1000 x 1000x10 (4)");
+        benchChain<float, 64, 256, 32, 512, 8, 256, 4, 128, 1>("64x256 ... 128x1 (8)");
+        benchChain<float, 30, 35, 15, 5, 10, 20, 25>("30x35 ... 20x25 (6)");
+    }
+}
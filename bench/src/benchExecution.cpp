@@ -0,0 +1,64 @@
+/**
+ * @file benchExecution.cpp
+ * @brief Strong scaling of glg::transform, glg::reduce and glg::transform_reduce under the seq, par and par_unseq policies,
+ * on float buffers from the size of the last level cache to far beyond it.
+ * @author Guillaume
+ * @date 18/10/2026
+ */
+
+#include <cstdio>
+#include <memory>
+#include "bench.h"
+#include "myExecution.h"
+#include "myThreadPool.h"
+
+namespace
+{
+    void benchPolicies(size_t count)
+    {
+        auto x = std::make_unique<float[]>(count);
+        auto y = std::make_unique<float[]>(count);
+        auto out = std::make_unique<float[]>(count);
+        bench::fillRandom(x.get(), count, 1);
+        bench::fillRandom(y.get(), count, 2);
+
+        auto axpy = [](float a, float b) { return 2.0f * a + b; };
+        float sink = 0.0f;
+
+        const double seqTransform = bench::measure([&] { glg::transform(glg::execution::seq, x.get(), x.get() + count, y.get(), out.get(), axpy); });
+        const double seqReduce = bench::measure([&] { sink += glg::reduce(glg::execution::seq, x.get(), x.get() + count, 0.0f); });
+        const double seqDot = bench::measure([&] { sink += glg::transform_reduce(glg::execution::seq, x.get(), x.get() + count, y.get(), 0.0f); });
+        std::printf("%11zu %8s %10.2f %10.2f %10.2f\n", count, "seq", seqTransform * 1e3, seqReduce * 1e3, seqDot * 1e3);
+
+        for (size_t threads : bench::threadCounts())
+        {
+            glg::ThreadPool pool(threads);
+            const auto par = glg::execution::par.on(pool);
+            const auto parUnseq = glg::execution::par_unseq.on(pool);
+
+            const double transform = bench::measure([&] { glg::transform(par, x.get(), x.get() + count, y.get(), out.get(), axpy); });
+            const double reduce = bench::measure([&] { sink += glg::reduce(par, x.get(), x.get() + count, 0.0f); });
+            const double unseqReduce = bench::measure([&] { sink += glg::reduce(parUnseq, x.get(), x.get() + count, 0.0f); });
+            const double dot = bench::measure([&] { sink += glg::transform_reduce(par, x.get(), x.get() + count, y.get(), 0.0f); });
+            const double unseqDot = bench::measure([&] { sink += glg::transform_reduce(parUnseq, x.get(), x.get() + count, y.get(), 0.0f); });
+
+            std::printf("%11zu %8zu %10.2f %10.2f %10.2f %10.2f %10.2f\n", count, threads, transform * 1e3, reduce * 1e3, dot * 1e3,
+                unseqReduce * 1e3, unseqDot * 1e3);
+        }
+
+        // Keeps the reductions from being optimised away
+        if (sink == 1.0f)
+            std::printf("\n");
+    }
+}
+
+namespace bench
+{
+    void runExecution()
+    {
+        std::printf("float buffers (ms): transform 2x+y, reduce x, transform_reduce x.y\n");
+        std::printf("%11s %8s %10s %10s %10s %10s %10s\n", "size", "threads", "transform", "reduce", "dot", "unseq red", "unseq dot");
+        for (size_t count : { size_t(1) << 18, size_t(1) << 22, size_t(1) << 25 })
+            benchPolicies(count);
+    }
+}
@@ -0,0 +1,81 @@
+/**
+ * @file benchGemm.cpp
+ * @brief GFLOPS of the myMatrix product against a naive triple loop, from 4x4 to 2048x2048.
+ * @author Guillaume
+ * @date 18/10/2026
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include "bench.h"
+#include "mathLib.h"
+#include "myMatrix.h"
+
+namespace
+{
+    template<typename T, size_t N>
+    void naiveMultiply(const myMatrix<T, N, N>& lhs, const myMatrix<T, N, N>& rhs, myMatrix<T, N, N>& result)
+    {
+        const T* a = lhs.data();
+        const T* b = rhs.data();
+        T* c = result.data();
+        for (size_t i = 0; i < N; ++i)
+        {
+            for (size_t j = 0; j < N; ++j)
+            {
+                T sum = T(0);
+                for (size_t k = 0; k < N; ++k)
+                    sum += a[i * N + k] * b[k * N + j];
+                c[i * N + j] = sum;
+            }
+        }
+    }
+
+    template<typename T, size_t N>
+    void benchSize()
+    {
+        // Large fixed-size matrices do not fit on the stack
+        auto lhs = std::make_unique<myMatrix<T, N, N>>();
+        auto rhs = std::make_unique<myMatrix<T, N, N>>();
+        auto result = std::make_unique<myMatrix<T, N, N>>();
+        auto reference = std::make_unique<myMatrix<T, N, N>>();
+        bench::fillRandom(lhs->data(), N * N, 1);
+        bench::fillRandom(rhs->data(), N * N, 2);
+
+        const double flops = 2.0 * N * N * N;
+        const double gemmTime = bench::measure([&] { Math::multiply(*lhs, *rhs, *result); });
+
+        // The naive loop needs minutes beyond 1024
+        double naiveTime = 0.0;
+        double maxError = 0.0;
+        if (N <= 1024)
+        {
+            naiveTime = bench::measure([&] { naiveMultiply(*lhs, *rhs, *reference); });
+            for (size_t i = 0; i < N * N; ++i)
+                maxError = std::max(maxError, double(std::abs((*result)[i] - (*reference)[i])));
+        }
+
+        std::printf("%6zu %12.2f", N, flops / gemmTime * 1e-9);
+        if (N <= 1024)
+            std::printf(" %12.2f %9.1fx %12.2e\n", flops / naiveTime * 1e-9, naiveTime / gemmTime, maxError);
+        else
+            std::printf(" %12s %10s %12s\n", "-", "-", "-");
+    }
+
+    template<typename T, size_t... Sizes>
+    void benchSizes(const char* typeName)
+    {
+        std::printf("%s\n%6s %12s %12s %10s %12s\n", typeName, "N", "gemm GFLOPS", "naive GFLOPS", "speedup", "max error");
+        (benchSize<T, Sizes>(), ...);
+    }
+}
+
+namespace bench
+{
+    void runGemm()
+    {
+        benchSizes<float, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048>("float");
+        benchSizes<double, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048>("double");
+    }
+}
@@ -0,0 +1,54 @@
+/**
+ * @file benchGemmParallel.cpp
+ * @brief Strong scaling of the multithreaded GEMM, from one thread to every hardware thread.
+ * @author Guillaume
+ * @date 18/10/2026
+ */
+
+#include <cstdio>
+#include <vector>
+#include "bench.h"
+#include "myGemm.h"
+#include "myThreadPool.h"
+
+namespace
+{
+    template<typename T>
+    void benchScaling(const char* typeName)
+    {
+        std::printf("%s\n%6s %8s %10s %9s %11s\n", typeName, "N", "threads", "GFLOPS", "speedup", "efficiency");
+
+        for (size_t n : { 1024, 2048, 4096 })
+        {
+            std::vector<T> a(n * n);
+            std::vector<T> b(n * n);
+            std::vector<T> c(n * n);
+            bench::fillRandom(a.data(), a.size(), 1);
+            bench::fillRandom(b.data(), b.size(), 2);
+
+            const double flops = 2.0 * n * n * n;
+            double serialTime = 0.0;
+            for (size_t threads : bench::threadCounts())
+            {
+                glg::ThreadPool pool(threads);
+                const double time = bench::measure([&]
+                {
+                    Math::gemm<T>(pool, n, n, n, T(1), a.data(), n, 1, b.data(), n, 1, T(0), c.data(), n, 1);
+                }, 0.5);
+
+                serialTime = threads == 1 ? time : serialTime;
+                const double speedup = serialTime / time;
+                std::printf("%6zu %8zu %10.2f %8.2fx %10.0f%%\n", n, threads, flops / time * 1e-9, speedup, 100.0 * speedup / threads);
+            }
+        }
+    }
+}
+
+namespace bench
+{
+    void runGemmParallel()
+    {
+        benchScaling<float>("float");
+        benchScaling<double>("double");
+    }
+}
@@ -0,0 +1,64 @@
+/**
+ * @file benchGemv.cpp
+ * @brief Bandwidth of the GEMV kernel (y = A * x and y = A^T * x) against a bounds-checked getCell loop.
+ * @author Guillaume
+ * @date 18/10/2026
+ */
+
+#include <cstdio>
+#include <vector>
+#include "bench.h"
+#include "myDynMatrix.h"
+#include "myGemv.h"
+
+namespace
+{
+    template<typename T>
+    void getCellGemv(const myDynMatrix<T>& a, const T* x, T* y)
+    {
+        for (size_t i = 0; i < a.rows(); ++i)
+        {
+            T sum = T(0);
+            for (size_t j = 0; j < a.cols(); ++j)
+                sum += a.getCell(i, j) * x[j];
+            y[i] = sum;
+        }
+    }
+
+    template<typename T>
+    void benchSize(size_t rows, size_t cols)
+    {
+        myDynMatrix<T> a(rows, cols);
+        std::vector<T> x(rows > cols ? rows : cols);
+        std::vector<T> y(rows > cols ? rows : cols);
+        bench::fillRandom(a.data(), a.Size(), 1);
+        bench::fillRandom(x.data(), x.size(), 2);
+
+        // A dominates the traffic, it is read once per product
+        const double bytes = double(rows) * cols * sizeof(T);
+        const double naiveTime = bench::measure([&] { getCellGemv(a, x.data(), y.data()); });
+        const double gemvTime = bench::measure([&] { Math::gemv<T>(rows, cols, T(1), a.data(), cols, 1, x.data(), 1, T(0), y.data(), 1); });
+        const double transposedTime = bench::measure([&] { Math::gemv<T>(cols, rows, T(1), a.data(), 1, cols, x.data(), 1, T(0), y.data(), 1); });
+
+        std::printf("%5zu x %-5zu %10.2f %10.2f %10.2f %8.1fx\n", rows, cols, bytes / naiveTime * 1e-9, bytes / gemvTime * 1e-9,
+            bytes / transposedTime * 1e-9, naiveTime / gemvTime);
+    }
+
+    template<typename T>
+    void benchSizes(const char* typeName)
+    {
+        std::printf("%s (GB/s of A)\n%13s %10s %10s %10s %9s\n", typeName, "size", "getCell", "gemv", "gemv A^T", "speedup");
+        const size_t shapes[][2] = { { 64, 64 }, { 100, 100 }, { 256, 256 }, { 1000, 1000 }, { 1023, 1023 }, { 4096, 4096 }, { 10000, 300 }, { 300, 10000 } };
+        for (const auto& shape : shapes)
+            benchSize<T>(shape[0], shape[1]);
+    }
+}
+
+namespace bench
+{
+    void runGemv()
+    {
+        benchSizes<float>("float");
+        benchSizes<double>("double");
+    }
+}
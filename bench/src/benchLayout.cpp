@@ -0,0 +1,58 @@
+/**
+ * @file benchLayout.cpp
+ * @brief Row-major, column-major and tiled myMatrix: products in each layout, and a transposition against a change of layout.
+ * @author Guillaume
+ * @date 18/10/2026
+ */
+
+#include <cstdio>
+#include <memory>
+#include "bench.h"
+#include "mathLib.h"
+
+namespace
+{
+    template<size_t S, typename L>
+    double productGflops()
+    {
+        // Large fixed-size matrices do not fit on the stack
+        auto a = std::make_unique<myMatrix<float, S, S, L>>();
+        auto b = std::make_unique<myMatrix<float, S, S, L>>();
+        auto c = std::make_unique<myMatrix<float, S, S, L>>();
+        bench::fillRandom(a->data(), S * S, 1);
+        bench::fillRandom(b->data(), S * S, 2);
+
+        const double time = bench::measure([&] { Math::multiply(*a, *b, *c); });
+        return 2.0 * S * S * S / time * 1e-9;
+    }
+
+    template<size_t S>
+    void benchSize()
+    {
+        using namespace glg;
+        auto a = std::make_unique<myMatrix<float, S, S>>();
+        bench::fillRandom(a->data(), S * S, 4);
+        auto t = std::make_unique<myMatrix<float, S, S>>();
+        auto reinterpreted = std::make_unique<myMatrix<float, S, S, ColMajor>>();
+        const double transposeTime = bench::measure([&] { *t = Math::transpose(*a); });
+        const double layoutTime = bench::measure([&] { *reinterpreted = Math::transposeLayout(*a); });
+
+        std::printf("%4zu %10.2f %10.2f %10.2f %10.2f %10.2f\n", S,
+            productGflops<S, RowMajor>(), productGflops<S, ColMajor>(), productGflops<S, Tiled<8>>(),
+            2.0 * S * S * sizeof(float) / transposeTime * 1e-9, 2.0 * S * S * sizeof(float) / layoutTime * 1e-9);
+    }
+}
+
+namespace bench
+{
+    void runLayout()
+    {
+        // "as col" reads the transpose of a row-major matrix as the column-major copy of its storage
+        std::printf("%4s %10s %10s %10s %10s %10s\n", "", "A*B row", "A*B col", "A*B tiled", "transpose", "as col");
+        std::printf("%4s %10s %10s %10s %10s %10s\n", "size", "(GFLOP/s)", "(GFLOP/s)", "(GFLOP/s)", "(GB/s)", "(GB/s)");
+        benchSize<16>();
+        benchSize<64>();
+        benchSize<256>();
+        benchSize<1024>();
+    }
+}
@@ -0,0 +1,66 @@
+/**
+ * @file benchMemory.cpp
+ * @brief Bandwidth of glg::copy and glg::fill against element loops, from L1-resident buffers to buffers far beyond the last level cache.
+ * @author Guillaume
+ * @date 18/10/2026
+ */
+
+#include <cstdio>
+#include <memory>
+#include "bench.h"
+#include "helper.h"
+
+namespace
+{
+    /**
+     * @brief Element loops as glg::copy and glg::fill were written before they dispatched to memmove and memset.
+     * The compiler is still free to vectorise them, or to recognise them as library calls.
+     */
+    template<typename T>
+    void loopCopy(const T* first, const T* last, T* output)
+    {
+        for (; first != last; ++first, ++output)
+            *output = *first;
+    }
+
+    template<typename T>
+    void loopFill(T* first, T* last, const T& value)
+    {
+        for (; first != last; ++first)
+            *first = value;
+    }
+
+    template<typename T>
+    void benchMemory(const char* typeName, T value)
+    {
+        std::printf("%s\n%12s %12s %12s %12s %12s\n", typeName, "bytes", "loop copy", "glg::copy", "loop fill", "glg::fill");
+
+        for (size_t bytes = size_t(16) << 10; bytes <= size_t(256) << 20; bytes *= 8)
+        {
+            const size_t count = bytes / sizeof(T);
+            auto source = std::make_unique<T[]>(count);
+            auto destination = std::make_unique<T[]>(count);
+            bench::fillRandom(source.get(), count);
+
+            // Both buffers move through the memory system for a copy, only the destination for a fill
+            const double copied = 2.0 * double(bytes) * 1e-9;
+            const double filled = double(bytes) * 1e-9;
+            const double loopCopyTime = bench::measure([&] { loopCopy(source.get(), source.get() + count, destination.get()); });
+            const double copyTime = bench::measure([&] { glg::copy(source.get(), source.get() + count, destination.get()); });
+            const double loopFillTime = bench::measure([&] { loopFill(destination.get(), destination.get() + count, value); });
+            const double fillTime = bench::measure([&] { glg::fill(destination.get(), destination.get() + count, value); });
+
+            std::printf("%12zu %10.1f/s %10.1f/s %10.1f/s %10.1f/s\n", bytes, copied / loopCopyTime, copied / copyTime, filled / loopFillTime, filled / fillTime);
+        }
+    }
+}
+
+namespace bench
+{
+    void runMemory()
+    {
+        std::printf("bandwidth in GB/s\n");
+        benchMemory<float>("float (fill 1.5f)", 1.5f);
+        benchMemory<double>("double (fill 0.0)", 0.0);
+    }
+}
@@ -0,0 +1,106 @@
+/**
+ * @file benchPacked.cpp
+ * @brief Packed triangular, symmetric and band (8 + 8 diagonals) matrices against the dense kernels:
+ * matrix-vector product against Math::gemv, and solve against the dense LU and Cholesky.
+ * @author Guillaume
+ * @date 18/10/2026
+ */
+
+#include <cstdio>
+#include <vector>
+#include "bench.h"
+#include "myDecomposition.h"
+#include "myGemv.h"
+#include "myPackedMatrix.h"
+
+namespace
+{
+    constexpr size_t bandwidth = 8;
+
+    template<typename T>
+    void printRow(const char* kind, size_t n, double denseBytes, double packedBytes, double denseTime, double packedTime)
+    {
+        std::printf("%-10s %6zu %10.1f %10.3f %10.3f %8.1fx\n", kind, n, denseBytes / packedBytes, denseTime * 1e3, packedTime * 1e3,
+            denseTime / packedTime);
+    }
+
+    template<typename T>
+    void benchProducts(size_t n)
+    {
+        myDynMatrix<T> dense(n, n);
+        bench::fillRandom(dense.data(), dense.Size(), 1);
+        for (size_t i = 0; i < n; ++i)
+            dense(i, i) += T(n);
+        std::vector<T> x(n);
+        std::vector<T> y(n);
+        bench::fillRandom(x.data(), n, 2);
+
+        const myTriangularMatrix<T> triangular(dense);
+        const mySymmetricMatrix<T> symmetric(dense);
+        const myBandMatrix<T> band(dense, bandwidth, bandwidth);
+
+        const double denseBytes = double(n) * n * sizeof(T);
+        const double denseTime = bench::measure([&] { Math::gemv<T>(n, n, T(1), dense.data(), n, 1, x.data(), 1, T(0), y.data(), 1); });
+        printRow<T>("triangular", n, denseBytes, triangular.packedSize() * sizeof(T), denseTime,
+            bench::measure([&] { Math::multiply(triangular, x.data(), y.data()); }));
+        printRow<T>("symmetric", n, denseBytes, symmetric.packedSize() * sizeof(T), denseTime,
+            bench::measure([&] { Math::multiply(symmetric, x.data(), y.data()); }));
+        printRow<T>("band", n, denseBytes, band.packedSize() * sizeof(T), denseTime,
+            bench::measure([&] { Math::multiply(band, x.data(), y.data()); }));
+    }
+
+    template<typename T>
+    void benchSolves(size_t n)
+    {
+        myDynMatrix<T> dense(n, n);
+        bench::fillRandom(dense.data(), dense.Size(), 1);
+        for (size_t i = 0; i < n; ++i)
+            dense(i, i) += T(n);
+        myDynMatrix<T> rhs(n, 1);
+        bench::fillRandom(rhs.data(), n, 2);
+
+        const double denseBytes = double(n) * n * sizeof(T);
+
+        // Dense triangular solve: the blocked substitution behind the dense factorizations
+        const myTriangularMatrix<T> triangular(dense);
+        myDynMatrix<T> work(rhs);
+        printRow<T>("triangular", n, denseBytes, triangular.packedSize() * sizeof(T),
+            bench::measure([&] { work = rhs; Math::detail::solveLower<T>(dense.view(), work.view(), false); }),
+            bench::measure([&] { work = rhs; Math::solveInPlace(triangular, work.view()); }));
+
+        // Symmetric positive definite: A^T A + n I
+        myDynMatrix<T> spd(n, n);
+        Math::gemm<T>(n, n, n, T(1), dense.data(), 1, n, dense.data(), n, 1, T(0), spd.data(), n, 1);
+        const mySymmetricMatrix<T> symmetric(spd);
+        printRow<T>("symmetric", n, denseBytes, symmetric.packedSize() * sizeof(T),
+            bench::measure([&] { work = Math::Cholesky<T>(spd.view()).solve(rhs.view()); }),
+            bench::measure([&] { work = Math::solve(symmetric, rhs); }));
+
+        const myBandMatrix<T> band(dense, bandwidth, bandwidth);
+        const myDynMatrix<T> banded = band.toDense();
+        printRow<T>("band", n, denseBytes, band.packedSize() * sizeof(T),
+            bench::measure([&] { work = Math::LU<T>(banded.view()).solve(rhs.view()); }),
+            bench::measure([&] { work = Math::solve(band, rhs); }));
+    }
+
+    template<typename T>
+    void benchSizes(const char* typeName)
+    {
+        std::printf("%s, y = A * x (ms)\n%-10s %6s %10s %10s %10s %9s\n", typeName, "matrix", "n", "memory", "dense", "packed", "speedup");
+        for (size_t n : { size_t(500), size_t(2000), size_t(6000) })
+            benchProducts<T>(n);
+
+        std::printf("%s, solve A x = b (ms)\n%-10s %6s %10s %10s %10s %9s\n", typeName, "matrix", "n", "memory", "dense", "packed", "speedup");
+        for (size_t n : { size_t(500), size_t(2000) })
+            benchSolves<T>(n);
+    }
+}
+
+namespace bench
+{
+    void runPacked()
+    {
+        benchSizes<float>("float");
+        benchSizes<double>("double");
+    }
+}
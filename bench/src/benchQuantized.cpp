@@ -0,0 +1,79 @@
+/**
+ * @file benchQuantized.cpp
+ * @brief int8 quantized layers against float ones: y = W * x against Math::gemv, and a batch of 64 samples
+ * (C = A * W^T) against Math::gemm.
+ * @author Guillaume
+ * @date 18/10/2026
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include "bench.h"
+#include "myGemm.h"
+#include "myGemv.h"
+#include "myQuantized.h"
+
+namespace
+{
+    constexpr size_t batch = 64;
+
+    template<size_t outputs, size_t inputs>
+    void benchLayer()
+    {
+        auto weights = std::make_unique<myMatrix<float, outputs, inputs>>();
+        auto activations = std::make_unique<myMatrix<float, batch, inputs>>();
+        bench::fillRandom(weights->data(), outputs * inputs, 1);
+        bench::fillRandom(activations->data(), batch * inputs, 2);
+        myVectorND<float, inputs> x;
+        bench::fillRandom(x.data(), inputs, 3);
+
+        const auto quantizedWeights = std::make_unique<myQuantizedMatrix<outputs, inputs>>(*weights);
+        const auto quantizedActivations = std::make_unique<myQuantizedMatrix<batch, inputs>>(*activations);
+
+        // Matrix-vector product, the weights dominate the traffic
+        myVectorND<float, outputs> y;
+        myVectorND<float, outputs> quantizedY;
+        const double gemvTime = bench::measure([&]
+        {
+            Math::gemv<float>(outputs, inputs, 1.f, weights->data(), inputs, 1, x.data(), 1, 0.f, y.data(), 1);
+        });
+        const double quantizedGemvTime = bench::measure([&] { Math::multiply(*quantizedWeights, x, quantizedY); });
+
+        float error = 0.f;
+        float magnitude = 0.f;
+        for (size_t i = 0; i < outputs; ++i)
+        {
+            error = std::max(error, std::abs(y[i] - quantizedY[i]));
+            magnitude = std::max(magnitude, std::abs(y[i]));
+        }
+
+        // Batch of samples
+        auto c = std::make_unique<myMatrix<float, batch, outputs>>();
+        const double gemmTime = bench::measure([&]
+        {
+            Math::gemm<float>(batch, outputs, inputs, 1.f, activations->data(), inputs, 1, weights->data(), 1, inputs, 0.f, c->data(), outputs, 1);
+        });
+        const double quantizedGemmTime = bench::measure([&] { Math::multiplyTransposed(*quantizedActivations, *quantizedWeights, *c); });
+
+        const double weightBytes = double(outputs) * inputs;
+        const double flops = 2.0 * batch * outputs * inputs;
+        std::printf("%5zu x %-5zu %9.2f %9.2f %7.1fx %9.2f %9.2f %7.1fx %9.4f\n", outputs, inputs,
+            4.0 * weightBytes / gemvTime * 1e-9, weightBytes / quantizedGemvTime * 1e-9, gemvTime / quantizedGemvTime,
+            flops / gemmTime * 1e-9, flops / quantizedGemmTime * 1e-9, gemmTime / quantizedGemmTime, error / magnitude);
+    }
+}
+
+namespace bench
+{
+    void runQuantized()
+    {
+        std::printf("y = W * x (GB/s of W), C = A * W^T with %zu samples (GOP/s), relative error of y\n", batch);
+        std::printf("%13s %9s %9s %8s %9s %9s %8s %9s\n", "layer", "float", "int8", "speedup", "float", "int8", "speedup", "error");
+        benchLayer<256, 256>();
+        benchLayer<1000, 1000>();
+        benchLayer<1024, 4096>();
+        benchLayer<4096, 4096>();
+    }
+}
@@ -0,0 +1,75 @@
+/**
+ * @file benchScan.cpp
+ * @brief Bandwidth of glg::inclusive_scan and glg::exclusive_scan on uint32 buffers, against std::inclusive_scan and a parallel
+ * copy of the same buffer, the bound a scan can reach. The inclusive scan is also timed through myVector iterators,
+ * which should run as fast as the raw pointers.
+ * @author Guillaume
+ * @date 18/10/2026
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <numeric>
+#include "bench.h"
+#include "myExecution.h"
+#include "myScan.h"
+#include "myThreadPool.h"
+#include "myVector.h"
+
+namespace
+{
+    void benchBandwidth(size_t count)
+    {
+        auto input = std::make_unique<std::uint32_t[]>(count);
+        auto output = std::make_unique<std::uint32_t[]>(count);
+        bench::fillRandom(input.get(), count);
+        const std::uint32_t* first = input.get();
+        const std::uint32_t* last = input.get() + count;
+
+        myVector<std::uint32_t, 1> vectorInput;
+        myVector<std::uint32_t, 1> vectorOutput;
+        vectorInput.resize(count);
+        vectorOutput.resize(count);
+        glg::copy(first, last, vectorInput.data());
+
+        // A scan reads the input and writes the output once
+        const double gigabytes = 2.0 * double(count * sizeof(std::uint32_t)) * 1e-9;
+        const double stdTime = bench::measure([&] { std::inclusive_scan(first, last, output.get()); });
+        const double seqTime = bench::measure([&] { glg::inclusive_scan(glg::execution::seq, first, last, output.get()); });
+        const double seqVectorTime = bench::measure([&]
+        {
+            glg::inclusive_scan(glg::execution::seq, vectorInput.begin(), vectorInput.end(), vectorOutput.begin());
+        });
+        std::printf("%11zu %8s %10s %10.1f %10.1f %10s %10s %10.1f\n", count, "seq", "", gigabytes / stdTime, gigabytes / seqTime, "", "",
+            gigabytes / seqVectorTime);
+
+        for (size_t threads : bench::threadCounts())
+        {
+            glg::ThreadPool pool(threads);
+            const auto par = glg::execution::par.on(pool);
+
+            const double copyTime = bench::measure([&] { glg::copy(par, first, last, output.get()); });
+            const double inclusiveTime = bench::measure([&] { glg::inclusive_scan(par, first, last, output.get()); });
+            const double exclusiveTime = bench::measure([&] { glg::exclusive_scan(par, first, last, output.get(), std::uint32_t(0)); });
+            const double vectorTime = bench::measure([&]
+            {
+                glg::inclusive_scan(par, vectorInput.begin(), vectorInput.end(), vectorOutput.begin());
+            });
+
+            std::printf("%11zu %8zu %10.1f %10s %10s %10.1f %10.1f %10.1f\n", count, threads, gigabytes / copyTime, "", "", gigabytes / inclusiveTime,
+                gigabytes / exclusiveTime, gigabytes / vectorTime);
+        }
+    }
+}
+
+namespace bench
+{
+    void runScan()
+    {
+        std::printf("uint32 buffers (GB/s, input read and output written once)\n");
+        std::printf("%11s %8s %10s %10s %10s %10s %10s %10s\n", "size", "threads", "copy", "std", "glg seq", "inclusive", "exclusive", "myVector");
+        for (size_t count : { size_t(1) << 16, size_t(1) << 20, size_t(1) << 23, size_t(1) << 26 })
+            benchBandwidth(count);
+    }
+}
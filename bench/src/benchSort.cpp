@@ -0,0 +1,309 @@
+/**
+ * @file benchSort.cpp
+ * @brief glg::sort against std::sort across sizes and input distributions (random, sorted, reversed, many duplicates),
+ * the merge sorts against std::stable_sort on random and partially sorted input, the radix sort against the comparison
+ * sorts by key type, the top-k selections against a full sort, and the sorting networks on many small arrays.
+ * @author Guillaume
+ * @date 18/10/2026
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "bench.h"
+#include "helper.h"
+
+namespace
+{
+    enum class Distribution
+    {
+        Random,
+        Sorted,
+        Reversed,
+        Duplicates,
+        NearlySorted,
+        Runs
+    };
+
+    const char* nameOf(Distribution distribution)
+    {
+        switch (distribution)
+        {
+        case Distribution::Random:
+            return "random";
+        case Distribution::Sorted:
+            return "sorted";
+        case Distribution::Reversed:
+            return "reversed";
+        case Distribution::Duplicates:
+            return "duplicates";
+        case Distribution::NearlySorted:
+            return "nearly";
+        default:
+            return "runs";
+        }
+    }
+
+    template<typename T>
+    std::vector<T> makeInput(size_t count, Distribution distribution)
+    {
+        std::vector<T> values(count);
+        std::mt19937_64 generator(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            switch (distribution)
+            {
+            case Distribution::Random:
+                values[i] = T(generator() % (1u << 30));
+                break;
+            case Distribution::Sorted:
+                values[i] = T(i);
+                break;
+            case Distribution::Reversed:
+                values[i] = T(count - i);
+                break;
+            case Distribution::Duplicates:
+                values[i] = T(generator() % 16);
+                break;
+            case Distribution::NearlySorted:
+                // One element in a hundred out of place
+                values[i] = generator() % 100 == 0 ? T(generator() % count) : T(i);
+                break;
+            case Distribution::Runs:
+                // Alternating ascending and descending runs of 1000 elements
+                values[i] = (i / 1000) % 2 ? T(count - i) : T(i);
+                break;
+            }
+        }
+        return values;
+    }
+
+    template<typename T>
+    void benchSize(size_t count, Distribution distribution)
+    {
+        const std::vector<T> input = makeInput<T>(count, distribution);
+        std::vector<T> work(count);
+
+        // Both sorts pay the same copy of the input
+        const double stdTime = bench::measure([&]
+        {
+            work = input;
+            std::sort(work.begin(), work.end());
+        });
+        const double glgTime = bench::measure([&]
+        {
+            work = input;
+            glg::sort(work);
+        });
+
+        std::printf("%-10s %9zu %10.2f %10.2f %8.2fx\n", nameOf(distribution), count, stdTime / count * 1e9, glgTime / count * 1e9,
+            stdTime / glgTime);
+    }
+
+    template<typename T>
+    void benchType(const char* typeName)
+    {
+        std::printf("%s (ns per element)\n%-10s %9s %10s %10s %9s\n", typeName, "input", "size", "std::sort", "glg::sort", "speedup");
+        for (Distribution distribution : { Distribution::Random, Distribution::Sorted, Distribution::Reversed, Distribution::Duplicates })
+        {
+            for (size_t count : { size_t(100), size_t(1000), size_t(10000), size_t(100000), size_t(1000000) })
+                benchSize<T>(count, distribution);
+        }
+    }
+
+    template<typename T>
+    void benchStable(size_t count, Distribution distribution)
+    {
+        const std::vector<T> input = makeInput<T>(count, distribution);
+        std::vector<T> work(count);
+        std::vector<T> buffer(count);
+
+        const double stdTime = bench::measure([&]
+        {
+            work = input;
+            std::stable_sort(work.begin(), work.end());
+        });
+        const double topDownTime = bench::measure([&]
+        {
+            work = input;
+            glg::FusionSort(work.data(), work.data() + count, buffer.data());
+        });
+        const double bottomUpTime = bench::measure([&]
+        {
+            work = input;
+            glg::BottomUpFusionSort(work.data(), work.data() + count, buffer.data());
+        });
+        const double timTime = bench::measure([&]
+        {
+            work = input;
+            glg::TimSort(work.data(), work.data() + count, buffer.data());
+        });
+
+        std::printf("%-10s %9zu %10.2f %10.2f %10.2f %10.2f\n", nameOf(distribution), count, stdTime / count * 1e9, topDownTime / count * 1e9,
+            bottomUpTime / count * 1e9, timTime / count * 1e9);
+    }
+
+    template<typename T>
+    void benchRadix(const char* typeName, size_t count)
+    {
+        std::vector<T> input(count);
+        std::mt19937_64 generator(count);
+        for (T& value : input)
+        {
+            if constexpr (std::is_floating_point_v<T>)
+                value = T(double(std::int64_t(generator())) * 1e-12);
+            else
+                value = T(generator());
+        }
+        std::vector<T> work(count);
+
+        const double stdTime = bench::measure([&]
+        {
+            work = input;
+            std::sort(work.begin(), work.end());
+        });
+        const double introTime = bench::measure([&]
+        {
+            work = input;
+            glg::introsort(work.begin(), work.end());
+        });
+        const double radixTime = bench::measure([&]
+        {
+            work = input;
+            glg::radix_sort(work.begin(), work.end());
+        });
+
+        std::printf("%-10s %9zu %10.2f %10.2f %10.2f %8.2fx\n", typeName, count, stdTime / count * 1e9, introTime / count * 1e9,
+            radixTime / count * 1e9, stdTime / radixTime);
+    }
+}
+
+namespace
+{
+    /**
+     * @brief The k largest of count records by score: full sort then take k, std::partial_sort, glg::partial_sort and glg::nth_element.
+     */
+    void benchTopK(size_t count, size_t k)
+    {
+        struct Record
+        {
+            std::uint64_t id;
+            float score;
+        };
+
+        std::vector<Record> input(count);
+        std::mt19937_64 generator(count);
+        for (size_t i = 0; i < count; ++i)
+            input[i] = { i, float(generator() % 1000000) };
+        std::vector<Record> work(count);
+        const auto byScore = [](const Record& a, const Record& b) { return a.score > b.score; };
+
+        const double sortTime = bench::measure([&]
+        {
+            work = input;
+            glg::sort(work, std::greater<>(), &Record::score);
+        });
+        const double stdTime = bench::measure([&]
+        {
+            work = input;
+            std::partial_sort(work.begin(), work.begin() + k, work.end(), byScore);
+        });
+        const double partialTime = bench::measure([&]
+        {
+            work = input;
+            glg::partial_sort(work.begin(), work.begin() + k, work.end(), std::greater<>(), &Record::score);
+        });
+        const double nthTime = bench::measure([&]
+        {
+            work = input;
+            glg::nth_element(work.begin(), work.begin() + k, work.end(), std::greater<>(), &Record::score);
+        });
+
+        std::printf("%9zu %7zu %10.3f %10.3f %10.3f %10.3f %8.1fx\n", count, k, sortTime * 1e3, stdTime * 1e3, partialTime * 1e3,
+            nthTime * 1e3, sortTime / partialTime);
+    }
+}
+
+namespace
+{
+    /**
+     * @brief Sorts of many std::array<T, N>: std::sort against glg::sort, which picks a sorting network at these sizes.
+     */
+    template<typename T, size_t N>
+    void benchSmall(const char* typeName)
+    {
+        constexpr size_t arrays = 1 << 14;
+        std::vector<std::array<T, N>> input(arrays);
+        std::mt19937_64 generator(N);
+        for (auto& values : input)
+        {
+            for (T& value : values)
+                value = T(generator() % 1000000);
+        }
+        std::vector<std::array<T, N>> work(arrays);
+
+        const double stdTime = bench::measure([&]
+        {
+            work = input;
+            for (auto& values : work)
+                std::sort(values.begin(), values.end());
+        });
+        const double glgTime = bench::measure([&]
+        {
+            work = input;
+            for (auto& values : work)
+                glg::sort(values);
+        });
+
+        std::printf("%-10s %5zu %10.1f %10.1f %8.2fx\n", typeName, N, stdTime / arrays * 1e9, glgTime / arrays * 1e9, stdTime / glgTime);
+    }
+}
+
+namespace bench
+{
+    void runSort()
+    {
+        benchType<int>("int");
+        benchType<double>("double");
+
+        std::printf("stable sorts of int, buffer supplied (ns per element)\n%-10s %9s %10s %10s %10s %10s\n", "input", "size", "std::stable",
+            "top-down", "bottom-up", "TimSort");
+        for (Distribution distribution : { Distribution::Random, Distribution::Sorted, Distribution::NearlySorted, Distribution::Runs })
+        {
+            for (size_t count : { size_t(1000), size_t(100000), size_t(1000000) })
+                benchStable<int>(count, distribution);
+        }
+
+        std::printf("radix sort of random keys (ns per element)\n%-10s %9s %10s %10s %10s %9s\n", "key", "size", "std::sort", "introsort",
+            "radix", "speedup");
+        for (size_t count : { size_t(1000), size_t(10000), size_t(1000000) })
+        {
+            benchRadix<std::int16_t>("int16", count);
+            benchRadix<int>("int", count);
+            benchRadix<float>("float", count);
+            benchRadix<std::uint64_t>("uint64", count);
+            benchRadix<double>("double", count);
+        }
+
+        std::printf("top k records by score, copy included (ms)\n%9s %7s %10s %10s %10s %10s %9s\n", "size", "k", "glg::sort",
+            "std::part", "glg::part", "glg::nth", "speedup");
+        for (size_t count : { size_t(100000), size_t(1000000) })
+        {
+            for (size_t k : { size_t(10), size_t(1000), size_t(10000), size_t(100000) })
+                benchTopK(count, k);
+        }
+
+        std::printf("small arrays (ns per array)\n%-10s %5s %10s %10s %9s\n", "type", "size", "std::sort", "glg::sort", "speedup");
+        benchSmall<int, 8>("int");
+        benchSmall<int, 16>("int");
+        benchSmall<int, 32>("int");
+        benchSmall<int, 64>("int");
+        benchSmall<float, 24>("float");
+        benchSmall<double, 8>("double");
+        benchSmall<double, 16>("double");
+        benchSmall<double, 32>("double");
+    }
+}
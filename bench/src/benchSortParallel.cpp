@@ -0,0 +1,69 @@
+/**
+ * @file benchSortParallel.cpp
+ * @brief Strong scaling of glg::parallel_sort and glg::parallel_stable_sort on random 32-bit keys, from one thread to every
+ * hardware thread, against std::sort.
+ * @author Guillaume
+ * @date 18/10/2026
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "bench.h"
+#include "myParallelSort.h"
+#include "myThreadPool.h"
+
+namespace
+{
+    void benchScaling(size_t count)
+    {
+        std::vector<std::uint32_t> input(count);
+        std::mt19937 generator(static_cast<unsigned>(count));
+        for (std::uint32_t& key : input)
+            key = generator();
+        std::vector<std::uint32_t> work(count);
+
+        // The copy of the input is timed with every sort
+        const double stdTime = bench::measure([&]
+        {
+            work = input;
+            std::sort(work.begin(), work.end());
+        });
+
+        double serialTime = 0.0;
+        double serialStableTime = 0.0;
+        for (size_t threads : bench::threadCounts())
+        {
+            glg::ThreadPool pool(threads);
+            const double time = bench::measure([&]
+            {
+                work = input;
+                glg::parallel_sort(pool, work.begin(), work.end());
+            });
+            const double stableTime = bench::measure([&]
+            {
+                work = input;
+                glg::parallel_stable_sort(pool, work.begin(), work.end());
+            });
+
+            serialTime = threads == 1 ? time : serialTime;
+            serialStableTime = threads == 1 ? stableTime : serialStableTime;
+            std::printf("%11zu %8zu %10.1f %10.1f %8.2fx %8.2fx %10.1f %8.2fx\n", count, threads, stdTime * 1e3, time * 1e3, stdTime / time,
+                serialTime / time, stableTime * 1e3, serialStableTime / stableTime);
+        }
+    }
+}
+
+namespace bench
+{
+    void runSortParallel()
+    {
+        std::printf("uint32 keys (ms), speedups against std::sort and against one thread\n");
+        std::printf("%11s %8s %10s %10s %9s %9s %10s %9s\n", "size", "threads", "std::sort", "parallel", "vs std", "scaling", "stable",
+            "scaling");
+        for (size_t count : { size_t(1) << 20, size_t(1) << 23, size_t(100000000) })
+            benchScaling(count);
+    }
+}
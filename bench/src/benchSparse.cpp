@@ -0,0 +1,126 @@
+/**
+ * @file benchSparse.cpp
+ * @brief Sparse products (SpMV, SpMM) on synthetic power-law matrices with 10^7 non-zeros.
+ * @author Guillaume
+ * @date 18/10/2026
+ *
+ * Row lengths follow a Pareto law, like the degrees of a web or social graph:
+ * most rows hold a handful of elements and a few hold tens of thousands. The
+ * columns are drawn with the same skew, so some entries of x are hot.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "bench.h"
+#include "mySparseMatrix.h"
+
+namespace
+{
+    template<typename T>
+    mySparseMatrix<T> powerLawMatrix(size_t rows, size_t cols, size_t targetNonZeros, double exponent, unsigned seed)
+    {
+        std::mt19937_64 generator(seed);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+        // Pareto row lengths, rescaled so that their sum is close to targetNonZeros
+        std::vector<double> weights(rows);
+        double total = 0.0;
+        for (double& weight : weights)
+        {
+            weight = std::pow(1.0 - uniform(generator), -1.0 / (exponent - 1.0));
+            total += weight;
+        }
+
+        std::vector<size_t> rowPointers(rows + 1, 0);
+        std::vector<std::uint32_t> colIndices;
+        std::vector<T> values;
+        colIndices.reserve(targetNonZeros + targetNonZeros / 8);
+        values.reserve(targetNonZeros + targetNonZeros / 8);
+
+        std::vector<std::uint32_t> row;
+        for (size_t r = 0; r < rows; ++r)
+        {
+            const size_t length = std::min(cols, std::max<size_t>(1, size_t(weights[r] / total * targetNonZeros + 0.5)));
+            row.clear();
+            for (size_t k = 0; k < length; ++k)
+                row.push_back(std::uint32_t(std::pow(uniform(generator), 2.0) * cols));
+
+            std::sort(row.begin(), row.end());
+            row.erase(std::unique(row.begin(), row.end()), row.end());
+            for (std::uint32_t col : row)
+            {
+                colIndices.push_back(col);
+                values.push_back(T(uniform(generator) * 2.0 - 1.0));
+            }
+            rowPointers[r + 1] = values.size();
+        }
+
+        return mySparseMatrix<T>(rows, cols, std::move(rowPointers), std::move(colIndices), std::move(values));
+    }
+
+    template<typename T>
+    void naiveSpmv(const mySparseMatrix<T>& matrix, const T* x, T* y)
+    {
+        const auto rowPointers = matrix.rowPointers();
+        const auto colIndices = matrix.colIndices();
+        const auto values = matrix.values();
+        for (size_t r = 0; r < matrix.rows(); ++r)
+        {
+            T sum = T(0);
+            for (size_t k = rowPointers[r]; k < rowPointers[r + 1]; ++k)
+                sum += values[k] * x[colIndices[k]];
+            y[r] = sum;
+        }
+    }
+
+    template<typename T>
+    void benchType(const char* typeName)
+    {
+        const size_t rows = 1000000;
+        const size_t cols = 1000000;
+        const mySparseMatrix<T> matrix = powerLawMatrix<T>(rows, cols, 10000000, 2.2, 7);
+        const size_t longest = [&]
+        {
+            size_t result = 0;
+            for (size_t r = 0; r < rows; ++r)
+                result = std::max(result, matrix.rowPointers()[r + 1] - matrix.rowPointers()[r]);
+            return result;
+        }();
+        std::printf("%s: %zu x %zu, %zu non-zeros, longest row %zu\n", typeName, rows, cols, matrix.nonZeros(), longest);
+
+        std::vector<T> x(cols);
+        std::vector<T> y(rows);
+        bench::fillRandom(x.data(), x.size(), 3);
+
+        // Two flops per non-zero, the bytes count the matrix stream only
+        const double flops = 2.0 * matrix.nonZeros();
+        const double bytes = matrix.nonZeros() * (sizeof(T) + sizeof(std::uint32_t)) + (rows + 1) * sizeof(size_t);
+        const double naiveTime = bench::measure([&] { naiveSpmv(matrix, x.data(), y.data()); }, 0.5);
+        const double kernelTime = bench::measure([&] { Math::multiply(matrix, x.data(), y.data()); }, 0.5);
+
+        std::printf("%-14s %10s %10s %10s\n", "SpMV", "GFLOP/s", "GB/s", "speedup");
+        std::printf("%-14s %10.2f %10.2f %10s\n", "naive", flops / naiveTime * 1e-9, bytes / naiveTime * 1e-9, "-");
+        std::printf("%-14s %10.2f %10.2f %9.1fx\n", "Math::multiply", flops / kernelTime * 1e-9, bytes / kernelTime * 1e-9, naiveTime / kernelTime);
+
+        const size_t denseCols = 8;
+        myDynMatrix<T> dense(cols, denseCols);
+        myDynMatrix<T> result(rows, denseCols);
+        bench::fillRandom(dense.data(), dense.Size(), 5);
+
+        const double spmmTime = bench::measure([&] { Math::multiply(matrix, dense.view(), result.view()); }, 0.5);
+        std::printf("%-14s %10.2f   (x %zu dense columns)\n\n", "SpMM", flops * denseCols / spmmTime * 1e-9, denseCols);
+    }
+}
+
+namespace bench
+{
+    void runSparse()
+    {
+        std::printf("%zu worker thread(s)\n", glg::ThreadPool::global().size());
+        benchType<float>("float");
+        benchType<double>("double");
+    }
+}
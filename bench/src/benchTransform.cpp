@@ -0,0 +1,93 @@
+/**
+ * @file benchTransform.cpp
+ * @brief 4x4 float transforms: product, inverse and determinant latency, and batched point transforms against a plain loop.
+ * @author Guillaume
+ * @date 18/10/2026
+ */
+
+#include <cstdio>
+#include <vector>
+#include "bench.h"
+#include "mathLib.h"
+
+namespace
+{
+    void naiveTransform(const myMatrix<float, 4, 4>& matrix, const std::vector<myVectorND<float, 3>>& src, std::vector<myVectorND<float, 3>>& dst)
+    {
+        const float* m = matrix.data();
+        for (size_t i = 0; i < src.size(); ++i)
+        {
+            for (size_t r = 0; r < 3; ++r)
+                dst[i][r] = m[4 * r] * src[i][0] + m[4 * r + 1] * src[i][1] + m[4 * r + 2] * src[i][2] + m[4 * r + 3];
+        }
+    }
+
+    void benchMatrixOps()
+    {
+        constexpr size_t count = 4096;
+        std::vector<myMatrix<float, 4, 4>> matrices(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            bench::fillRandom(matrices[i].data(), 16, unsigned(i));
+            for (size_t d = 0; d < 4; ++d)
+                matrices[i].data()[5 * d] += 4.0f;
+        }
+
+        myMatrix<float, 4, 4> sink;
+        float detSink = 0.0f;
+        const double productTime = bench::measure([&]
+        {
+            for (size_t i = 0; i + 1 < count; ++i)
+                sink = matrices[i] * matrices[i + 1];
+        });
+        const double inverseTime = bench::measure([&]
+        {
+            for (size_t i = 0; i < count; ++i)
+                sink = Math::inverse(matrices[i]);
+        });
+        const double luInverseTime = bench::measure([&]
+        {
+            for (size_t i = 0; i < count; ++i)
+                sink = Math::LU<float>(matrices[i]).inverse().toMatrix<4, 4>();
+        });
+        const double determinantTime = bench::measure([&]
+        {
+            for (size_t i = 0; i < count; ++i)
+                detSink += Math::determinant(matrices[i]);
+        });
+
+        std::printf("%-22s %8.1f ns\n", "product", productTime / (count - 1) * 1e9);
+        std::printf("%-22s %8.1f ns\n", "inverse", inverseTime / count * 1e9);
+        std::printf("%-22s %8.1f ns\n", "inverse through LU", luInverseTime / count * 1e9);
+        std::printf("%-22s %8.1f ns\n", "determinant", determinantTime / count * 1e9);
+        std::printf("(%g %g)\n\n", sink.data()[0], detSink);
+    }
+
+    void benchPoints(size_t count)
+    {
+        std::vector<myVectorND<float, 3>> src(count);
+        std::vector<myVectorND<float, 3>> dst(count);
+        bench::fillRandom(src[0].data(), 3 * count, 9);
+        const myMatrix<float, 4, 4> matrix{ 0.36f, 0.48f, -0.8f, 1.0f, -0.8f, 0.6f, 0.0f, 2.0f, 0.48f, 0.64f, 0.6f, 3.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+
+        // Every point is read once and written once
+        const double bytes = 2.0 * count * sizeof(myVectorND<float, 3>);
+        const double naiveTime = bench::measure([&] { naiveTransform(matrix, src, dst); });
+        const double batchTime = bench::measure([&] { Math::transformPoints(matrix, src, dst); });
+
+        std::printf("%10zu %10.2f %10.2f %8.1fx %10.0f\n", count, bytes / naiveTime * 1e-9, bytes / batchTime * 1e-9,
+            naiveTime / batchTime, count / batchTime * 1e-6);
+    }
+}
+
+namespace bench
+{
+    void runTransform()
+    {
+        benchMatrixOps();
+
+        std::printf("transformPoints (GB/s)\n%10s %10s %10s %9s %10s\n", "points", "naive", "batched", "speedup", "Mpoints/s");
+        for (size_t count : { size_t(1000), size_t(100000), size_t(1000000), size_t(10000000) })
+            benchPoints(count);
+    }
+}
@@ -0,0 +1,67 @@
+/**
+ * @file benchTranspose.cpp
+ * @brief Bandwidth of the blocked transpose against a naive double loop, on sizes that are not powers of two.
+ * @author Guillaume
+ * @date 18/10/2026
+ */
+
+#include <cstdio>
+#include "bench.h"
+#include "myDynMatrix.h"
+#include "myTranspose.h"
+
+namespace
+{
+    template<typename T>
+    void naiveTranspose(const T* src, T* dst, size_t rows, size_t cols)
+    {
+        for (size_t i = 0; i < rows; ++i)
+        {
+            for (size_t j = 0; j < cols; ++j)
+                dst[j * rows + i] = src[i * cols + j];
+        }
+    }
+
+    template<typename T>
+    void benchSize(size_t rows, size_t cols)
+    {
+        myDynMatrix<T> src(rows, cols);
+        myDynMatrix<T> dst(cols, rows);
+        bench::fillRandom(src.data(), src.Size(), 1);
+
+        // Every element is read once and written once
+        const double bytes = 2.0 * rows * cols * sizeof(T);
+        const double naiveTime = bench::measure([&] { naiveTranspose(src.data(), dst.data(), rows, cols); });
+        const double blockedTime = bench::measure([&] { Math::transpose(src.data(), cols, dst.data(), rows, rows, cols); });
+
+        std::printf("%5zu x %-5zu %10.2f %10.2f %8.1fx", rows, cols, bytes / naiveTime * 1e-9, bytes / blockedTime * 1e-9, naiveTime / blockedTime);
+        if (rows == cols)
+        {
+            const double inPlaceTime = bench::measure([&] { Math::transposeInPlace(src.data(), cols, rows); });
+            std::printf(" %10.2f\n", bytes / inPlaceTime * 1e-9);
+        }
+        else
+        {
+            std::printf(" %10s\n", "-");
+        }
+    }
+
+    template<typename T>
+    void benchSizes(const char* typeName)
+    {
+        std::printf("%s (GB/s)\n%13s %10s %10s %9s %10s\n", typeName, "size", "naive", "blocked", "speedup", "in-place");
+        const size_t shapes[][2] = { { 100, 100 }, { 333, 333 }, { 1000, 1000 }, { 1023, 1023 }, { 1025, 1025 },
+                                     { 3001, 3001 }, { 4097, 4097 }, { 1000, 3000 }, { 5003, 701 } };
+        for (const auto& shape : shapes)
+            benchSize<T>(shape[0], shape[1]);
+    }
+}
+
+namespace bench
+{
+    void runTranspose()
+    {
+        benchSizes<float>("float");
+        benchSizes<double>("double");
+    }
+}
@@ -0,0 +1,69 @@
+/**
+ * @file main.cpp
+ * @brief Entry point of the mylib benchmarks: runs every benchmark, or only the ones named on the command line.
+ * @author Guillaume
+ * @date 18/10/2026
+ */
+
+#include <cstring>
+#include <iostream>
+#include "bench.h"
+
+namespace
+{
+    struct Benchmark
+    {
+        const char* name;
+        void (*run)();
+    };
+
+    const Benchmark benchmarks[] =
+    {
+        { "gemm", bench::runGemm },
+        { "gemm-parallel", bench::runGemmParallel },
+        { "transpose", bench::runTranspose },
+        { "sparse", bench::runSparse },
+        { "transform", bench::runTransform },
+        { "gemv", bench::runGemv },
+        { "batched", bench::runBatched },
+        { "layout", bench::runLayout },
+        { "packed", bench::runPacked },
+        { "quantized", bench::runQuantized },
+        { "chain", bench::runChain },
+        { "sort", bench::runSort },
+        { "sort-parallel", bench::runSortParallel },
+        { "memory", bench::runMemory },
+        { "execution", bench::runExecution },
+        { "scan", bench::runScan },
+    };
+}
+
+int main(int argc, char** argv)
+{
+    bool found = argc == 1;
+    for (const Benchmark& benchmark : benchmarks)
+    {
+        bool selected = argc == 1;
+        for (int i = 1; i < argc; ++i)
+            selected = selected || std::strcmp(argv[i], benchmark.name) == 0;
+
+        if (!selected)
+            continue;
+
+        std::cout << "=== " << benchmark.name << " ===" << std::endl;
+        benchmark.run();
+        std::cout << std::endl;
+        found = true;
+    }
+
+    if (!found)
+    {
+        std::cout << "Available benchmarks:";
+        for (const Benchmark& benchmark : benchmarks)
+            std::cout << " " << benchmark.name;
+        std::cout << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
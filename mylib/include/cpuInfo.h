@@ -0,0 +1,30 @@
+/**
+ * @file cpuInfo.h
+ * @brief Queries of the cache hierarchy, used to size the blocking of the mylib kernels.
+ * @author Guillaume
+ * @date 18/10/2026
+ */
+
+#pragma once
+#include <cstddef>
+
+namespace glg
+{
+    /**
+     * @struct CacheInfo
+     * @brief Size in bytes of the data caches seen by one core.
+     */
+    struct CacheInfo
+    {
+        size_t l1 = 32 * 1024;         ///< Level 1 data cache
+        size_t l2 = 256 * 1024;        ///< Level 2 cache
+        size_t l3 = 8 * 1024 * 1024;   ///< Level 3 cache (shared between cores)
+    };
+
+    /**
+     * @brief Returns the cache sizes of the machine, queried once.
+     * Sizes that cannot be queried keep the CacheInfo defaults.
+     * @return The cache sizes.
+     */
+    const CacheInfo& cacheInfo();
+};
@@ -6,10 +6,240 @@
  */
 
 #pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
 #include <vector>
+#include "cpuInfo.h"
+#include "myRadixSort.h"
+#include "mySortingNetwork.h"
+#include "simdConfig.h"
+
+template<typename T, size_t N>
+struct myArray;
 
 namespace glg
 {
+    namespace detail
+    {
+        /**
+         * @brief Whether It is a contiguous iterator, tested only for pointers and for the iterators declaring a
+         * contiguous iterator_concept. Testing std::contiguous_iterator on any other type instantiates its
+         * default constructor, a hard error for adaptors such as std::reverse_iterator over an iterator that has none.
+         */
+        template<typename It>
+        concept ContiguousIterator = std::is_pointer_v<It>
+            || (requires { typename It::iterator_concept; }
+                && std::is_base_of_v<std::contiguous_iterator_tag, typename It::iterator_concept>
+                && std::contiguous_iterator<It>);
+
+        /**
+         * @brief Whether assigning a range of Input to Output is a plain byte copy: both iterators are
+         * contiguous over the same trivially assignable type. Such copies go through memmove instead of
+         * an element loop.
+         * @tparam Input Source iterator type.
+         * @tparam Output Destination iterator type.
+         * @tparam Move Whether the elements are move-assigned rather than copy-assigned.
+         */
+        template<typename Input, typename Output, bool Move>
+        concept BitwiseAssignable = ContiguousIterator<Input> && ContiguousIterator<Output>
+            && std::is_same_v<std::iter_value_t<Input>, std::iter_value_t<Output>>
+            && !std::is_const_v<std::remove_reference_t<std::iter_reference_t<Output>>>
+            && std::is_trivially_copyable_v<std::iter_value_t<Output>>
+            && (Move ? std::is_trivially_move_assignable_v<std::iter_value_t<Output>>
+                     : std::is_trivially_copy_assignable_v<std::iter_value_t<Output>>);
+
+        /**
+         * @brief Whether filling a range of Output with a value of type T can be written as raw bytes.
+         * The value has to be the element type itself, or an arithmetic value converted to an
+         * arithmetic element, so that the bytes of the converted value are what the loop would store.
+         */
+        template<typename Output, typename T>
+        concept BitwiseFillable = ContiguousIterator<Output>
+            && !std::is_const_v<std::remove_reference_t<std::iter_reference_t<Output>>>
+            && std::is_trivially_copyable_v<std::iter_value_t<Output>>
+            && std::is_trivially_copy_assignable_v<std::iter_value_t<Output>>
+            && (std::is_same_v<std::remove_cv_t<T>, std::iter_value_t<Output>>
+                || (std::is_arithmetic_v<T> && std::is_arithmetic_v<std::iter_value_t<Output>>));
+
+        /**
+         * @brief Whether It is an iterator at all, as told by its iterator_traits. Tells the two-range
+         * overloads of transform_reduce from the one-range ones.
+         */
+        template<typename It>
+        concept LegacyIterator = requires { typename std::iterator_traits<It>::iterator_category; };
+
+#if GLG_HAS_AVX2
+        inline constexpr size_t streamWidth = 32;   ///< Bytes written by one non-temporal store
+#else
+        inline constexpr size_t streamWidth = 16;   ///< Bytes written by one non-temporal store
+#endif
+
+        /**
+         * @brief Whether a value of T tiles a streamed vector, which streamFill relies on.
+         */
+        template<typename T>
+        concept Streamable = streamWidth % sizeof(T) == 0 && alignof(T) == sizeof(T);
+
+        /**
+         * @brief Byte count from which copies and fills bypass the caches with non-temporal stores.
+         * Below the size of the last level cache the destination is likely to be read again soon, and
+         * a regular store keeps it hot; above it the store would only evict useful data.
+         */
+        inline size_t streamingThreshold()
+        {
+            static const size_t threshold = cacheInfo().l3;
+            return threshold;
+        }
+
+        /**
+         * @brief Copies bytes between two non-overlapping buffers with non-temporal stores.
+         * The head is copied normally up to the first aligned destination address, then whole vectors
+         * are streamed, then the tail is copied normally.
+         * @param destination Destination buffer.
+         * @param source Source buffer, which must not overlap the destination.
+         * @param bytes Number of bytes to copy.
+         */
+        inline void streamCopy(void* destination, const void* source, size_t bytes)
+        {
+#if GLG_HAS_AVX2 || GLG_HAS_SSE2
+            constexpr size_t width = streamWidth;
+            unsigned char* out = static_cast<unsigned char*>(destination);
+            const unsigned char* in = static_cast<const unsigned char*>(source);
+
+            const size_t head = std::min(bytes, (width - (reinterpret_cast<std::uintptr_t>(out) & (width - 1))) & (width - 1));
+            std::memcpy(out, in, head);
+            out += head;
+            in += head;
+            bytes -= head;
+
+            for (; bytes >= 4 * width; bytes -= 4 * width, out += 4 * width, in += 4 * width)
+            {
+#if GLG_HAS_AVX2
+                const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+                const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + width));
+                const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 2 * width));
+                const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 3 * width));
+                _mm256_stream_si256(reinterpret_cast<__m256i*>(out), a);
+                _mm256_stream_si256(reinterpret_cast<__m256i*>(out + width), b);
+                _mm256_stream_si256(reinterpret_cast<__m256i*>(out + 2 * width), c);
+                _mm256_stream_si256(reinterpret_cast<__m256i*>(out + 3 * width), d);
+#else
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + width));
+                const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2 * width));
+                const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 3 * width));
+                _mm_stream_si128(reinterpret_cast<__m128i*>(out), a);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(out + width), b);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(out + 2 * width), c);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(out + 3 * width), d);
+#endif
+            }
+
+            // Streaming stores are weakly ordered, make them visible before the following stores
+            _mm_sfence();
+            std::memcpy(out, in, bytes);
+#else
+            std::memcpy(destination, source, bytes);
+#endif
+        }
+
+        /**
+         * @brief Fills count elements with a value through vector stores, non-temporal ones if asked.
+         * The value is broadcast into a vector-wide pattern, so its size must divide the vector width
+         * and the destination must be aligned on it, which keeps the pattern in phase after the head.
+         * @tparam streaming Whether the stores bypass the caches.
+         * @tparam T Trivially copyable element type.
+         * @param destination First element to fill.
+         * @param count Number of elements to fill.
+         * @param value The value to store.
+         */
+        template<bool streaming, typename T>
+        void patternFill(T* destination, size_t count, const T& value)
+        {
+            static_assert(Streamable<T>, "the value must tile the vector");
+#if GLG_HAS_AVX2 || GLG_HAS_SSE2
+#if GLG_HAS_AVX2
+            using Vector = __m256i;
+#else
+            using Vector = __m128i;
+#endif
+            constexpr size_t width = streamWidth;
+            alignas(width) unsigned char pattern[width];
+            for (size_t offset = 0; offset < width; offset += sizeof(T))
+                std::memcpy(pattern + offset, &value, sizeof(T));
+            const Vector broadcast = *reinterpret_cast<const Vector*>(pattern);
+
+            const size_t misalignment = reinterpret_cast<std::uintptr_t>(destination) & (width - 1);
+            const size_t head = std::min(count, (width - misalignment) % width / sizeof(T));
+            for (size_t i = 0; i < head; ++i)
+                destination[i] = value;
+
+            Vector* out = reinterpret_cast<Vector*>(destination + head);
+            const size_t vectors = (count - head) * sizeof(T) / width;
+            const auto store = [&](Vector* address)
+            {
+#if GLG_HAS_AVX2
+                if constexpr (streaming)
+                    _mm256_stream_si256(address, broadcast);
+                else
+                    _mm256_store_si256(address, broadcast);
+#else
+                if constexpr (streaming)
+                    _mm_stream_si128(address, broadcast);
+                else
+                    _mm_store_si128(address, broadcast);
+#endif
+            };
+
+            size_t i = 0;
+            for (; i + 4 <= vectors; i += 4)
+            {
+                store(out + i);
+                store(out + i + 1);
+                store(out + i + 2);
+                store(out + i + 3);
+            }
+            for (; i < vectors; ++i)
+                store(out + i);
+
+            // Streaming stores are weakly ordered, make them visible before the following stores
+            if constexpr (streaming)
+                _mm_sfence();
+
+            T* tail = reinterpret_cast<T*>(out + vectors);
+            for (T* last = destination + count; tail != last; ++tail)
+                *tail = value;
+#else
+            for (size_t i = 0; i < count; ++i)
+                destination[i] = value;
+#endif
+        }
+
+        /**
+         * @brief Copies count trivially copyable elements, streaming them when the copy is large and
+         * the buffers are disjoint, with memmove otherwise.
+         */
+        template<typename T>
+        void bitwiseCopy(T* destination, const T* source, size_t count)
+        {
+            const size_t bytes = count * sizeof(T);
+            if (bytes == 0)
+                return;
+
+            const bool disjoint = std::less<>()(destination + count, source) || !std::less<>()(destination, source + count);
+            if (bytes >= streamingThreshold() && disjoint)
+                streamCopy(destination, source, bytes);
+            else
+                std::memmove(destination, source, bytes);
+        }
+    };
+
 
     /**
      * @brief Copy elements from one range to another.
@@ -24,10 +254,19 @@ namespace glg
 	template<class InputIt, class OutputIt>
 	OutputIt copy(InputIt firstElem, InputIt lastElem, OutputIt output)
 	{
-		for (; firstElem != lastElem; (void)++firstElem, (void)++output)
-			*output = *firstElem;
+		if constexpr (detail::BitwiseAssignable<InputIt, OutputIt, false>)
+		{
+			const auto count = lastElem - firstElem;
+			detail::bitwiseCopy(std::to_address(output), std::to_address(firstElem), size_t(count));
+			return output + count;
+		}
+		else
+		{
+			for (; firstElem != lastElem; (void)++firstElem, (void)++output)
+				*output = *firstElem;
 
-		return output;
+			return output;
+		}
 	}
 
     /**
@@ -51,6 +290,118 @@ namespace glg
 		return startOfElem;
 	}
 
+    /**
+     * @brief Transform pairs of elements from two ranges using a specified operation.
+     *
+     * @tparam Input1 First input iterator type.
+     * @tparam Input2 Second input iterator type.
+     * @tparam Output Output iterator type.
+     * @tparam Op Binary operation type.
+     * @param firstElem Iterator to the first element in the first input range.
+     * @param lastElem Iterator to the last element in the first input range.
+     * @param secondElem Iterator to the first element in the second input range.
+     * @param startOfElem Iterator to the first element in the output range.
+     * @param operation Binary operation applied to each pair of elements.
+     * @return Output Iterator to the element past the last element transformed.
+     */
+	template<typename Input1, typename Input2, typename Output, typename Op>
+	Output transform(Input1 firstElem, Input1 lastElem, Input2 secondElem, Output startOfElem, Op operation)
+	{
+		for (; firstElem != lastElem; ++startOfElem, ++firstElem, ++secondElem)
+			*startOfElem = operation(*firstElem, *secondElem);
+
+		return startOfElem;
+	}
+
+    /**
+     * @brief Apply a function to every element of a range.
+     *
+     * @tparam Input Input iterator type.
+     * @tparam Func Unary function type.
+     * @param first Iterator to the first element in the range.
+     * @param last Iterator to the last element in the range.
+     * @param func Function called with each element, in order.
+     * @return Func The function, after its last call.
+     */
+	template<typename Input, typename Func>
+	Func for_each(Input first, Input last, Func func)
+	{
+		for (; first != last; ++first)
+			func(*first);
+
+		return func;
+	}
+
+    /**
+     * @brief Combine the elements of a range with a binary operation, from left to right.
+     *
+     * @tparam Input Input iterator type.
+     * @tparam T Type of the result.
+     * @tparam Op Binary operation type.
+     * @param first Iterator to the first element in the range.
+     * @param last Iterator to the last element in the range.
+     * @param init Initial value, combined first.
+     * @param operation Binary operation, addition by default.
+     * @return T The combination of init and every element.
+     */
+	template<typename Input, typename T, typename Op = std::plus<>>
+	T reduce(Input first, Input last, T init, Op operation = {})
+	{
+		for (; first != last; ++first)
+			init = operation(std::move(init), *first);
+
+		return init;
+	}
+
+    /**
+     * @brief Transform the elements of a range, then combine the results from left to right.
+     *
+     * @tparam Input Input iterator type.
+     * @tparam T Type of the result.
+     * @tparam ReduceOp Binary operation combining the results.
+     * @tparam TransformOp Unary operation applied to each element.
+     * @param first Iterator to the first element in the range.
+     * @param last Iterator to the last element in the range.
+     * @param init Initial value, combined first.
+     * @param reduceOp Binary operation combining the results.
+     * @param transformOp Unary operation applied to each element.
+     * @return T The combination of init and every transformed element.
+     */
+	template<typename Input, typename T, typename ReduceOp, typename TransformOp>
+	T transform_reduce(Input first, Input last, T init, ReduceOp reduceOp, TransformOp transformOp)
+	{
+		for (; first != last; ++first)
+			init = reduceOp(std::move(init), transformOp(*first));
+
+		return init;
+	}
+
+    /**
+     * @brief Combine pairs of elements from two ranges, then combine the results from left to right.
+     * With the default operations this is the inner product of the two ranges.
+     *
+     * @tparam Input1 First input iterator type.
+     * @tparam Input2 Second input iterator type.
+     * @tparam T Type of the result.
+     * @tparam ReduceOp Binary operation combining the results.
+     * @tparam TransformOp Binary operation applied to each pair of elements.
+     * @param first1 Iterator to the first element in the first range.
+     * @param last1 Iterator to the last element in the first range.
+     * @param first2 Iterator to the first element in the second range.
+     * @param init Initial value, combined first.
+     * @param reduceOp Binary operation combining the results, addition by default.
+     * @param transformOp Binary operation applied to each pair, multiplication by default.
+     * @return T The combination of init and every transformed pair.
+     */
+	template<typename Input1, detail::LegacyIterator Input2, typename T, typename ReduceOp = std::plus<>, typename TransformOp = std::multiplies<>>
+	T transform_reduce(Input1 first1, Input1 last1, Input2 first2, T init, ReduceOp reduceOp = {}, TransformOp transformOp = {})
+	{
+		for (; first1 != last1; ++first1, ++first2)
+			init = reduceOp(std::move(init), transformOp(*first1, *first2));
+
+		return init;
+	}
+
     /**
      * @brief Move elements from one range to another.
      *
@@ -64,10 +415,19 @@ namespace glg
 	template<class Input, class Output>
 	Output move(Input firstElem, Input lastElem, Output new_first)
 	{
-		for (; firstElem != lastElem; ++new_first, ++firstElem)
-			*new_first = std::move(*firstElem);
+		if constexpr (detail::BitwiseAssignable<Input, Output, true>)
+		{
+			const auto count = lastElem - firstElem;
+			detail::bitwiseCopy(std::to_address(new_first), std::to_address(firstElem), size_t(count));
+			return new_first + count;
+		}
+		else
+		{
+			for (; firstElem != lastElem; ++new_first, ++firstElem)
+				*new_first = std::move(*firstElem);
 
-		return new_first;
+			return new_first;
+		}
 	}
 
     /**
@@ -83,10 +443,21 @@ namespace glg
 	template<class firstIt, class secondIt>
 	secondIt move_backward(firstIt firstElem, firstIt lastElem, secondIt new_last)
 	{
-		while (firstElem != lastElem)
-			*(--new_last) = std::move(*(--lastElem));
+		if constexpr (detail::BitwiseAssignable<firstIt, secondIt, true>)
+		{
+			// The ranges overlap in the usual use, shifting elements right, so no streaming here
+			const auto count = lastElem - firstElem;
+			if (count > 0)
+				std::memmove(std::to_address(new_last) - count, std::to_address(firstElem), size_t(count) * sizeof(std::iter_value_t<secondIt>));
+			return new_last - count;
+		}
+		else
+		{
+			while (firstElem != lastElem)
+				*(--new_last) = std::move(*(--lastElem));
 
-		return new_last;
+			return new_last;
+		}
 	}
 
     /**
@@ -101,37 +472,124 @@ namespace glg
 	template<typename ForwardIt, typename T>
 	void fill(ForwardIt first, ForwardIt last, const T& value)
 	{
-		for (; first != last; ++first)
-			*first = value;
+		if constexpr (detail::BitwiseFillable<ForwardIt, T>)
+		{
+			using Element = std::iter_value_t<ForwardIt>;
+			const Element element = static_cast<Element>(value);
+			Element* destination = std::to_address(first);
+			const size_t count = size_t(last - first);
+
+			// memset covers byte-sized elements and the very common zero fill (but not -0.0). Elements with default
+			// member initializers are still trivially copyable, so their bytes may be written through void*
+			unsigned char bytes[sizeof(Element)];
+			std::memcpy(bytes, &element, sizeof(Element));
+			const bool uniform = std::all_of(bytes, bytes + sizeof(Element), [&](unsigned char byte) { return byte == bytes[0]; });
+			if constexpr (detail::Streamable<Element>)
+			{
+				if (count * sizeof(Element) >= detail::streamingThreshold())
+					detail::patternFill<true>(destination, count, element);
+				else if (uniform)
+					std::memset(static_cast<void*>(destination), bytes[0], count * sizeof(Element));
+				else
+					detail::patternFill<false>(destination, count, element);
+			}
+			else if (uniform)
+				std::memset(static_cast<void*>(destination), bytes[0], count * sizeof(Element));
+			else
+				for (size_t i = 0; i < count; ++i)
+					destination[i] = element;
+		}
+		else
+		{
+			for (; first != last; ++first)
+				*first = value;
+		}
 	}
 
     /**
-     * @brief Swap the contents of two containers.
+     * @brief Swap the contents of two objects.
      *
-     * @tparam Container Container type.
-     * @param first The first container.
-     * @param second The second container.
+     * Containers with a member swap (myVector, myList, myDynMatrix...) exchange their storage in constant
+     * time. Every other type is swapped through three moves, which never copies an element.
+     *
+     * @tparam Container Object type.
+     * @param first The first object.
+     * @param second The second object.
      */
 	template<typename Container>
 	void swap(Container& first, Container& second)
+		noexcept(requires { { first.swap(second) } noexcept; }
+			|| (std::is_nothrow_move_constructible_v<Container> && std::is_nothrow_move_assignable_v<Container>))
 	{
-		auto temp = first;
-		first = second;
-		second = temp;
+		if constexpr (requires { first.swap(second); })
+			first.swap(second);
+		else
+		{
+			Container temp = std::move(first);
+			first = std::move(second);
+			second = std::move(temp);
+		}
 	}
 
+    namespace detail
+    {
+        /**
+         * @brief Whether comp orders the elements of Iterator once projected by proj.
+         * A comparator takes the place of a buffer in the sort overloads, so it must not be mistaken for one.
+         */
+        template<typename Compare, typename Iterator, typename Projection>
+        concept SortComparator = std::predicate<Compare&,
+            std::invoke_result_t<Projection&, std::iter_reference_t<Iterator>>,
+            std::invoke_result_t<Projection&, std::iter_reference_t<Iterator>>>;
+
+        /**
+         * @brief Comparator applying comp to the projections of its arguments, as in comp(proj(a), proj(b)).
+         */
+        template<typename Compare, typename Projection>
+        struct ProjectedCompare
+        {
+            Compare comp;
+            Projection proj;
+
+            template<typename A, typename B>
+            bool operator()(A&& a, B&& b) const
+            {
+                return std::invoke(comp, std::invoke(proj, std::forward<A>(a)), std::invoke(proj, std::forward<B>(b)));
+            }
+        };
+
+        /**
+         * @brief Folds a projection into the comparator. The identity projection returns comp itself,
+         * so that the sorts still recognise std::less and std::greater on arithmetic types.
+         */
+        template<typename Compare, typename Projection>
+        auto projectedComparator(Compare comp, Projection proj)
+        {
+            if constexpr (std::is_same_v<Projection, std::identity>)
+                return comp;
+            else
+                return ProjectedCompare<Compare, Projection>{ comp, proj };
+        }
+    }
+
     /**
      * @brief Sort a range using insertion sort.
      *
      * @tparam Iterator Iterator type.
+     * @tparam Compare Strict weak ordering of the projected elements.
+     * @tparam Projection Applied to each element before comparing.
      * @param first Iterator to the first element in the range.
      * @param last Iterator to the last element in the range.
+     * @param comp The ordering, ascending by default.
+     * @param proj The projection, the element itself by default.
      */
-    template<typename Iterator>
-    void InsertionSort(Iterator first, Iterator last)
+    template<typename Iterator, typename Compare = std::less<>, typename Projection = std::identity>
+    void InsertionSort(Iterator first, Iterator last, Compare comp = {}, Projection proj = {})
     {
         if (first == last) return;
 
+        const auto less = detail::projectedComparator(comp, proj);
+
         for (auto it = first; it != last; ++it)
         {
             auto key = *it;
@@ -142,7 +600,7 @@ namespace glg
                 auto prev = j;
                 --prev;
 
-                if (*prev <= key)
+                if (!less(key, *prev))
                     break;
 
                 *j = *prev;
@@ -156,14 +614,20 @@ namespace glg
      * @brief Sort a range using bubble sort.
      *
      * @tparam Iterator Iterator type.
+     * @tparam Compare Strict weak ordering of the projected elements.
+     * @tparam Projection Applied to each element before comparing.
      * @param first Iterator to the first element in the range.
      * @param last Iterator to the last element in the range.
+     * @param comp The ordering, ascending by default.
+     * @param proj The projection, the element itself by default.
      */
-    template<typename Iterator>
-    void BubbleSort(Iterator first, Iterator last)
+    template<typename Iterator, typename Compare = std::less<>, typename Projection = std::identity>
+    void BubbleSort(Iterator first, Iterator last, Compare comp = {}, Projection proj = {})
     {
         if (first == last) return;
 
+        const auto less = detail::projectedComparator(comp, proj);
+
         bool swapped;
         do {
             swapped = false;
@@ -173,7 +637,7 @@ namespace glg
 
             while (next != last)
             {
-                if (*current > *next)
+                if (less(*next, *current))
                 {
                     glg::swap(*current, *next);
                     swapped = true;
@@ -189,6 +653,894 @@ namespace glg
         } while (swapped);
     }
 
+    namespace detail
+    {
+        /** Ranges shorter than this are left to insertion sort. */
+        constexpr std::ptrdiff_t insertionSortThreshold = 12;
+
+        /** Ranges longer than this take the median of three medians (Tukey's ninther) as pivot. */
+        constexpr std::ptrdiff_t nintherThreshold = 128;
+
+        /** Number of elements classified at once by the branchless partition. */
+        constexpr std::ptrdiff_t partitionBlock = 64;
+
+        /**
+         * @brief Whether comparing two elements is cheap and predictable enough for the branchless partition.
+         * It is for arithmetic types compared with std::less or std::greater, where a mispredicted branch costs more than the comparison.
+         */
+        template<typename T, typename Compare>
+        inline constexpr bool branchlessPartition = std::is_arithmetic_v<T>
+            && (std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<T>>
+                || std::is_same_v<Compare, std::greater<>> || std::is_same_v<Compare, std::greater<T>>);
+
+        /**
+         * @brief Insertion sort moving the elements, each one shifted right until it meets a smaller one.
+         */
+        template<typename Iterator, typename Compare>
+        void insertionSort(Iterator first, Iterator last, Compare comp)
+        {
+            if (first == last)
+                return;
+
+            for (Iterator it = first + 1; it != last; ++it)
+            {
+                if (!comp(*it, *(it - 1)))
+                    continue;
+
+                auto key = std::move(*it);
+                Iterator hole = it;
+                do
+                {
+                    *hole = std::move(*(hole - 1));
+                    --hole;
+                } while (hole != first && comp(key, *(hole - 1)));
+                *hole = std::move(key);
+            }
+        }
+
+        /**
+         * @brief Insertion sort without the check for the start of the range: an element no greater than every element must precede first.
+         */
+        template<typename Iterator, typename Compare>
+        void unguardedInsertionSort(Iterator first, Iterator last, Compare comp)
+        {
+            if (first == last)
+                return;
+
+            for (Iterator it = first + 1; it != last; ++it)
+            {
+                if (!comp(*it, *(it - 1)))
+                    continue;
+
+                auto key = std::move(*it);
+                Iterator hole = it;
+                do
+                {
+                    *hole = std::move(*(hole - 1));
+                    --hole;
+                } while (comp(key, *(hole - 1)));
+                *hole = std::move(key);
+            }
+        }
+
+        /**
+         * @brief Restores the heap property below root in a max-heap of count elements.
+         */
+        template<typename Iterator, typename Compare>
+        void siftDown(Iterator first, std::ptrdiff_t root, std::ptrdiff_t count, Compare comp)
+        {
+            auto value = std::move(first[root]);
+            std::ptrdiff_t hole = root;
+            while (2 * hole + 1 < count)
+            {
+                std::ptrdiff_t child = 2 * hole + 1;
+                if (child + 1 < count && comp(first[child], first[child + 1]))
+                    ++child;
+                if (!comp(value, first[child]))
+                    break;
+
+                first[hole] = std::move(first[child]);
+                hole = child;
+            }
+            first[hole] = std::move(value);
+        }
+
+        /**
+         * @brief Heapsort, the O(n log n) fallback of the introsort when the partitions keep going wrong.
+         */
+        template<typename Iterator, typename Compare>
+        void heapSort(Iterator first, Iterator last, Compare comp)
+        {
+            const std::ptrdiff_t count = last - first;
+            for (std::ptrdiff_t root = count / 2; root-- > 0;)
+                siftDown(first, root, count, comp);
+
+            for (std::ptrdiff_t end = count - 1; end > 0; --end)
+            {
+                glg::swap(first[0], first[end]);
+                siftDown(first, 0, end, comp);
+            }
+        }
+
+        /**
+         * @brief Orders *a <= *b <= *c.
+         */
+        template<typename Iterator, typename Compare>
+        void sort3(Iterator a, Iterator b, Iterator c, Compare comp)
+        {
+            if (comp(*b, *a))
+                glg::swap(*a, *b);
+            if (comp(*c, *b))
+                glg::swap(*b, *c);
+            if (comp(*b, *a))
+                glg::swap(*a, *b);
+        }
+
+        /**
+         * @brief Moves the pivot to *first: median of three, or ninther for long ranges.
+         * An element no less than the pivot is left at the end of the range, which bounds the partition scans.
+         */
+        template<typename Iterator, typename Compare>
+        void choosePivot(Iterator first, Iterator last, Compare comp)
+        {
+            const std::ptrdiff_t size = last - first;
+            const std::ptrdiff_t half = size / 2;
+            if (size > nintherThreshold)
+            {
+                sort3(first, first + half, last - 1, comp);
+                sort3(first + 1, first + (half - 1), last - 2, comp);
+                sort3(first + 2, first + (half + 1), last - 3, comp);
+                sort3(first + (half - 1), first + half, first + (half + 1), comp);
+                glg::swap(*first, *(first + half));
+            }
+            else
+                sort3(first + half, first, last - 1, comp);
+        }
+
+        /**
+         * @brief Partitions [first, last) around the pivot *first, elements equal to the pivot going right.
+         * @return The final position of the pivot, and whether the range was already partitioned.
+         */
+        template<typename Iterator, typename Compare>
+        std::pair<Iterator, bool> partitionRight(Iterator begin, Iterator end, Compare comp)
+        {
+            auto pivot = std::move(*begin);
+            Iterator first = begin;
+            Iterator last = end;
+
+            // The first scan stops on the element left at the end by choosePivot
+            while (comp(*++first, pivot));
+            if (first - 1 == begin)
+            {
+                while (first < last && !comp(*--last, pivot));
+            }
+            else
+            {
+                while (!comp(*--last, pivot));
+            }
+
+            const bool alreadyPartitioned = first >= last;
+            while (first < last)
+            {
+                glg::swap(*first, *last);
+                while (comp(*++first, pivot));
+                while (!comp(*--last, pivot));
+            }
+
+            Iterator pivotPosition = first - 1;
+            *begin = std::move(*pivotPosition);
+            *pivotPosition = std::move(pivot);
+            return { pivotPosition, alreadyPartitioned };
+        }
+
+        /**
+         * @brief Swaps count pairs of misplaced elements found by the branchless partition.
+         * A cyclic permutation needs fewer moves than the swaps, except when both sides hold as many elements:
+         * the swaps keep a descending input linear.
+         */
+        template<typename Iterator>
+        void swapOffsets(Iterator first, Iterator last, const unsigned char* offsetsLeft, const unsigned char* offsetsRight,
+            std::ptrdiff_t count, bool useSwaps)
+        {
+            if (useSwaps)
+            {
+                for (std::ptrdiff_t i = 0; i < count; ++i)
+                    glg::swap(*(first + offsetsLeft[i]), *(last - offsetsRight[i]));
+            }
+            else if (count > 0)
+            {
+                Iterator left = first + offsetsLeft[0];
+                Iterator right = last - offsetsRight[0];
+                auto temp = std::move(*left);
+                *left = std::move(*right);
+                for (std::ptrdiff_t i = 1; i < count; ++i)
+                {
+                    left = first + offsetsLeft[i];
+                    *right = std::move(*left);
+                    right = last - offsetsRight[i];
+                    *left = std::move(*right);
+                }
+                *right = std::move(temp);
+            }
+        }
+
+        /**
+         * @brief partitionRight without a branch per comparison (block partitioning).
+         *
+         * Blocks of elements are first classified: the offset of every element
+         * on the wrong side is written unconditionally and the count only
+         * advances when the comparison says so. The misplaced elements of both
+         * sides are then swapped pairwise. The comparisons never decide a jump,
+         * so random inputs cost no branch misprediction.
+         */
+        template<typename Iterator, typename Compare>
+        std::pair<Iterator, bool> partitionRightBranchless(Iterator begin, Iterator end, Compare comp)
+        {
+            auto pivot = std::move(*begin);
+            Iterator first = begin;
+            Iterator last = end;
+
+            while (comp(*++first, pivot));
+            if (first - 1 == begin)
+            {
+                while (first < last && !comp(*--last, pivot));
+            }
+            else
+            {
+                while (!comp(*--last, pivot));
+            }
+
+            const bool alreadyPartitioned = first >= last;
+            if (!alreadyPartitioned)
+            {
+                glg::swap(*first, *last);
+                ++first;
+
+                alignas(64) unsigned char offsetsLeft[partitionBlock];
+                alignas(64) unsigned char offsetsRight[partitionBlock];
+                Iterator baseLeft = first;
+                Iterator baseRight = last;
+                std::ptrdiff_t countLeft = 0, countRight = 0, startLeft = 0, startRight = 0;
+
+                while (first < last)
+                {
+                    // Only a side with no misplaced element left is refilled
+                    const std::ptrdiff_t unknown = last - first;
+                    std::ptrdiff_t sizeLeft = countLeft == 0 ? (countRight == 0 ? unknown / 2 : unknown) : 0;
+                    std::ptrdiff_t sizeRight = countRight == 0 ? unknown - sizeLeft : 0;
+                    sizeLeft = sizeLeft < partitionBlock ? sizeLeft : partitionBlock;
+                    sizeRight = sizeRight < partitionBlock ? sizeRight : partitionBlock;
+
+                    std::ptrdiff_t i = 0;
+                    for (; i + 4 <= sizeLeft; i += 4)
+                    {
+                        offsetsLeft[countLeft] = static_cast<unsigned char>(i);
+                        countLeft += !comp(first[0], pivot);
+                        offsetsLeft[countLeft] = static_cast<unsigned char>(i + 1);
+                        countLeft += !comp(first[1], pivot);
+                        offsetsLeft[countLeft] = static_cast<unsigned char>(i + 2);
+                        countLeft += !comp(first[2], pivot);
+                        offsetsLeft[countLeft] = static_cast<unsigned char>(i + 3);
+                        countLeft += !comp(first[3], pivot);
+                        first += 4;
+                    }
+                    for (; i < sizeLeft; ++i)
+                    {
+                        offsetsLeft[countLeft] = static_cast<unsigned char>(i);
+                        countLeft += !comp(*first, pivot);
+                        ++first;
+                    }
+                    for (i = 0; i + 4 <= sizeRight; i += 4)
+                    {
+                        offsetsRight[countRight] = static_cast<unsigned char>(i + 1);
+                        countRight += comp(last[-1], pivot);
+                        offsetsRight[countRight] = static_cast<unsigned char>(i + 2);
+                        countRight += comp(last[-2], pivot);
+                        offsetsRight[countRight] = static_cast<unsigned char>(i + 3);
+                        countRight += comp(last[-3], pivot);
+                        offsetsRight[countRight] = static_cast<unsigned char>(i + 4);
+                        countRight += comp(last[-4], pivot);
+                        last -= 4;
+                    }
+                    for (; i < sizeRight;)
+                    {
+                        offsetsRight[countRight] = static_cast<unsigned char>(++i);
+                        countRight += comp(*--last, pivot);
+                    }
+
+                    const std::ptrdiff_t count = countLeft < countRight ? countLeft : countRight;
+                    swapOffsets(baseLeft, baseRight, offsetsLeft + startLeft, offsetsRight + startRight, count, countLeft == countRight);
+                    countLeft -= count;
+                    countRight -= count;
+                    startLeft += count;
+                    startRight += count;
+
+                    if (countLeft == 0)
+                    {
+                        startLeft = 0;
+                        baseLeft = first;
+                    }
+                    if (countRight == 0)
+                    {
+                        startRight = 0;
+                        baseRight = last;
+                    }
+                }
+
+                // One side may still hold misplaced elements: they go next to the boundary
+                if (countLeft != 0)
+                {
+                    while (countLeft-- > 0)
+                        glg::swap(*(baseLeft + offsetsLeft[startLeft + countLeft]), *--last);
+                    first = last;
+                }
+                if (countRight != 0)
+                {
+                    while (countRight-- > 0)
+                    {
+                        glg::swap(*(baseRight - offsetsRight[startRight + countRight]), *first);
+                        ++first;
+                    }
+                    last = first;
+                }
+            }
+
+            Iterator pivotPosition = first - 1;
+            *begin = std::move(*pivotPosition);
+            *pivotPosition = std::move(pivot);
+            return { pivotPosition, alreadyPartitioned };
+        }
+
+        /**
+         * @brief Partitions [first, last) around the pivot *first, elements equal to the pivot going left.
+         * Used when the pivot equals the element before the range: the whole left part then equals the pivot and is done.
+         * @return The final position of the pivot.
+         */
+        template<typename Iterator, typename Compare>
+        Iterator partitionLeft(Iterator begin, Iterator end, Compare comp)
+        {
+            auto pivot = std::move(*begin);
+            Iterator first = begin;
+            Iterator last = end;
+
+            while (comp(pivot, *--last));
+            if (last + 1 == end)
+            {
+                while (first < last && !comp(pivot, *++first));
+            }
+            else
+            {
+                while (!comp(pivot, *++first));
+            }
+
+            while (first < last)
+            {
+                glg::swap(*first, *last);
+                while (comp(pivot, *--last));
+                while (!comp(pivot, *++first));
+            }
+
+            *begin = std::move(*last);
+            *last = std::move(pivot);
+            return last;
+        }
+
+        /**
+         * @brief Introsort loop: recurses on the left part and iterates on the right one.
+         * @param depthLimit Partitions left before switching to heapsort.
+         * @param leftmost Whether the range starts the whole array, otherwise the element before it bounds the range from below.
+         */
+        template<typename Iterator, typename Compare>
+        void introsortLoop(Iterator begin, Iterator end, Compare comp, int depthLimit, bool leftmost)
+        {
+            using ValueType = typename std::iterator_traits<Iterator>::value_type;
+
+            while (true)
+            {
+                const std::ptrdiff_t size = end - begin;
+                if (size < insertionSortThreshold)
+                {
+                    if (leftmost)
+                        insertionSort(begin, end, comp);
+                    else
+                        unguardedInsertionSort(begin, end, comp);
+                    return;
+                }
+
+                choosePivot(begin, end, comp);
+
+                // Many duplicates: the pivot equals the bound of the range, everything equal to it is placed at once
+                if (!leftmost && !comp(*(begin - 1), *begin))
+                {
+                    begin = partitionLeft(begin, end, comp) + 1;
+                    continue;
+                }
+
+                if (depthLimit-- == 0)
+                {
+                    heapSort(begin, end, comp);
+                    return;
+                }
+
+                Iterator pivot;
+                if (branchlessPartition<ValueType, Compare> && size > 128)
+                    pivot = partitionRightBranchless(begin, end, comp).first;
+                else
+                    pivot = partitionRight(begin, end, comp).first;
+
+                introsortLoop(begin, pivot, comp, depthLimit, leftmost);
+                begin = pivot + 1;
+                leftmost = false;
+            }
+        }
+
+        /**
+         * @brief Introsort of [first, last) with a recursion limit of 2 log2(n).
+         */
+        template<typename Iterator, typename Compare>
+        void introsort(Iterator first, Iterator last, Compare comp)
+        {
+            int depthLimit = 0;
+            for (std::ptrdiff_t n = last - first; n > 1; n >>= 1)
+                depthLimit += 2;
+
+            introsortLoop(first, last, comp, depthLimit, true);
+        }
+
+        /**
+         * @brief Introselect: the introsort partitions, each time keeping only the side that holds nth.
+         * Past the same recursion limit the remaining range is heapsorted, so the worst case stays O(n log n).
+         */
+        template<typename Iterator, typename Compare>
+        void introselect(Iterator begin, Iterator nth, Iterator end, Compare comp)
+        {
+            using ValueType = typename std::iterator_traits<Iterator>::value_type;
+
+            int depthLimit = 0;
+            for (std::ptrdiff_t n = end - begin; n > 1; n >>= 1)
+                depthLimit += 2;
+
+            bool leftmost = true;
+            while (end - begin >= insertionSortThreshold)
+            {
+                choosePivot(begin, end, comp);
+
+                // The pivot equals the bound of the range: the elements equal to it are in place
+                if (!leftmost && !comp(*(begin - 1), *begin))
+                {
+                    begin = partitionLeft(begin, end, comp) + 1;
+                    if (nth < begin)
+                        return;
+                    continue;
+                }
+
+                if (depthLimit-- == 0)
+                {
+                    heapSort(begin, end, comp);
+                    return;
+                }
+
+                Iterator pivot;
+                if (branchlessPartition<ValueType, Compare> && end - begin > 128)
+                    pivot = partitionRightBranchless(begin, end, comp).first;
+                else
+                    pivot = partitionRight(begin, end, comp).first;
+
+                if (nth == pivot)
+                    return;
+                if (nth < pivot)
+                    end = pivot;
+                else
+                {
+                    begin = pivot + 1;
+                    leftmost = false;
+                }
+            }
+
+            if (leftmost)
+                insertionSort(begin, end, comp);
+            else
+                unguardedInsertionSort(begin, end, comp);
+        }
+
+        /** partial_sort keeps a heap of the selected elements up to this many, and selects them by introselect beyond. */
+        constexpr std::ptrdiff_t heapSelectThreshold = 1024;
+
+        /**
+         * @brief Partial sort by heap selection: [first, middle) is a max-heap of the smallest elements seen so far,
+         * sorted at the end. An element that does not enter the heap costs one comparison with its top.
+         */
+        template<typename Iterator, typename Compare>
+        void heapSelect(Iterator first, Iterator middle, Iterator last, Compare comp)
+        {
+            const std::ptrdiff_t count = middle - first;
+            for (std::ptrdiff_t root = count / 2; root-- > 0;)
+                siftDown(first, root, count, comp);
+
+            for (Iterator it = middle; it != last; ++it)
+            {
+                if (comp(*it, *first))
+                {
+                    glg::swap(*it, *first);
+                    siftDown(first, 0, count, comp);
+                }
+            }
+
+            for (std::ptrdiff_t end = count - 1; end > 0; --end)
+            {
+                glg::swap(first[0], first[end]);
+                siftDown(first, 0, end, comp);
+            }
+        }
+    }
+
+    namespace detail
+    {
+        /** Runs shorter than this are sorted by insertion before the merges start. */
+        constexpr std::ptrdiff_t mergeRunThreshold = 16;
+
+        /** Consecutive wins of one run after which a merge starts galloping. */
+        constexpr std::ptrdiff_t gallopThreshold = 7;
+
+        /**
+         * @brief Moves the stable merge of the sorted ranges [first1, last1) and [first2, last2) to out, which overlaps neither.
+         */
+        template<typename Input1, typename Input2, typename Output, typename Compare>
+        Output mergeMove(Input1 first1, Input1 last1, Input2 first2, Input2 last2, Output out, Compare comp)
+        {
+            for (; first1 != last1 && first2 != last2; ++out)
+            {
+                if (comp(*first2, *first1))
+                {
+                    *out = std::move(*first2);
+                    ++first2;
+                }
+                else
+                {
+                    *out = std::move(*first1);
+                    ++first1;
+                }
+            }
+            out = glg::move(first1, last1, out);
+            return glg::move(first2, last2, out);
+        }
+
+        /**
+         * @brief Merges [first, mid) and [mid, last) in place, the left run being moved to buffer first.
+         * Once the buffer is drained, what is left of the right run is already in place. Forward iterators suffice.
+         */
+        template<typename Iterator, typename Buffer, typename Compare>
+        void mergeWithBuffer(Iterator first, Iterator mid, Iterator last, Buffer buffer, Compare comp)
+        {
+            Buffer left = buffer;
+            const Buffer leftEnd = glg::move(first, mid, buffer);
+            Iterator right = mid;
+            for (; left != leftEnd; ++first)
+            {
+                if (right != last && comp(*right, *left))
+                {
+                    *first = std::move(*right);
+                    ++right;
+                }
+                else
+                {
+                    *first = std::move(*left);
+                    ++left;
+                }
+            }
+        }
+
+        /**
+         * @brief Top-down merge sort of count elements reached by forward iterators, merging through buffer.
+         */
+        template<typename Iterator, typename Buffer, typename Compare>
+        void fusionSortForward(Iterator first, std::ptrdiff_t count, Buffer buffer, Compare comp)
+        {
+            if (count <= 1)
+                return;
+
+            const std::ptrdiff_t half = count / 2;
+            const Iterator mid = std::next(first, half);
+            fusionSortForward(first, half, buffer, comp);
+            fusionSortForward(mid, count - half, buffer, comp);
+            mergeWithBuffer(first, mid, std::next(mid, count - half), buffer, comp);
+        }
+
+        /**
+         * @brief Sorts the count elements of dst, src holding the same elements and serving as scratch.
+         * The halves are sorted into src, then merged back into dst: the two arrays swap roles at each level, nothing is copied back.
+         */
+        template<typename Source, typename Destination, typename Compare>
+        void fusionSortInto(Source src, Destination dst, std::ptrdiff_t count, Compare comp)
+        {
+            if (count <= mergeRunThreshold)
+            {
+                insertionSort(dst, dst + count, comp);
+                return;
+            }
+
+            const std::ptrdiff_t half = count / 2;
+            fusionSortInto(dst, src, half, comp);
+            fusionSortInto(dst + half, src + half, count - half, comp);
+            mergeMove(src, src + half, src + half, src + count, dst, comp);
+        }
+
+        /**
+         * @brief Merges the consecutive runs of width elements of src into dst, for one pass of the bottom-up merge sort.
+         */
+        template<typename Source, typename Destination, typename Compare>
+        void mergePass(Source src, Destination dst, std::ptrdiff_t count, std::ptrdiff_t width, Compare comp)
+        {
+            for (std::ptrdiff_t low = 0; low < count; low += 2 * width)
+            {
+                const std::ptrdiff_t mid = std::min(low + width, count);
+                const std::ptrdiff_t high = std::min(low + 2 * width, count);
+                mergeMove(src + low, src + mid, src + mid, src + high, dst + low, comp);
+            }
+        }
+
+        /**
+         * @brief Length of the longest prefix of the sorted range [first, first + count) whose elements satisfy pred.
+         * Exponential search from the start, then binary search: O(log k) for a prefix of k elements.
+         */
+        template<typename Iterator, typename Predicate>
+        std::ptrdiff_t gallop(Iterator first, std::ptrdiff_t count, Predicate pred)
+        {
+            std::ptrdiff_t low = 0;
+            std::ptrdiff_t high = 1;
+            while (high <= count && pred(first[high - 1]))
+            {
+                low = high;
+                high = 2 * high + 1;
+            }
+            high = std::min(high, count);
+
+            while (low < high)
+            {
+                const std::ptrdiff_t mid = low + (high - low) / 2;
+                if (pred(first[mid]))
+                    low = mid + 1;
+                else
+                    high = mid;
+            }
+            return low;
+        }
+
+        /**
+         * @brief Merges the run moved to left with the run right, which directly follows out, element by element until
+         * one run wins gallopThreshold times in a row, then in blocks found by gallop().
+         *
+         * On equal elements the left run goes first. Called with reverse iterators and the reversed comparison, it merges
+         * from the end with the right run in the buffer.
+         *
+         * @param minGallop Adaptive galloping threshold, raised when galloping does not pay and lowered when it does.
+         */
+        template<typename Iterator, typename Buffer, typename Compare>
+        void gallopMerge(Iterator out, Buffer left, std::ptrdiff_t leftCount, Iterator right, std::ptrdiff_t rightCount,
+            std::ptrdiff_t& minGallop, Compare comp)
+        {
+            const Buffer leftEnd = left + leftCount;
+            const Iterator rightEnd = right + rightCount;
+            while (left != leftEnd && right != rightEnd)
+            {
+                std::ptrdiff_t leftWins = 0;
+                std::ptrdiff_t rightWins = 0;
+                do
+                {
+                    if (comp(*right, *left))
+                    {
+                        *out = std::move(*right);
+                        ++right;
+                        ++rightWins;
+                        leftWins = 0;
+                    }
+                    else
+                    {
+                        *out = std::move(*left);
+                        ++left;
+                        ++leftWins;
+                        rightWins = 0;
+                    }
+                    ++out;
+                } while (left != leftEnd && right != rightEnd && leftWins < minGallop && rightWins < minGallop);
+
+                // One run keeps winning: move whole blocks of it
+                while (left != leftEnd && right != rightEnd)
+                {
+                    const std::ptrdiff_t leftBlock = gallop(left, leftEnd - left, [&](const auto& value) { return !comp(*right, value); });
+                    out = glg::move(left, left + leftBlock, out);
+                    left += leftBlock;
+                    if (left == leftEnd)
+                        break;
+
+                    *out = std::move(*right);
+                    ++out;
+                    ++right;
+                    if (right == rightEnd)
+                        break;
+
+                    const std::ptrdiff_t rightBlock = gallop(right, rightEnd - right, [&](const auto& value) { return comp(value, *left); });
+                    out = glg::move(right, right + rightBlock, out);
+                    right += rightBlock;
+                    if (right == rightEnd)
+                        break;
+
+                    *out = std::move(*left);
+                    ++out;
+                    ++left;
+
+                    if (leftBlock < gallopThreshold && rightBlock < gallopThreshold)
+                    {
+                        minGallop += 2;
+                        break;
+                    }
+                    if (minGallop > 1)
+                        --minGallop;
+                }
+            }
+
+            // The rest of the right run is already in place
+            glg::move(left, leftEnd, out);
+        }
+
+        /**
+         * @brief Merges the adjacent sorted runs [first, first + count1) and [first + count1, first + count1 + count2),
+         * moving the shorter one to buffer.
+         */
+        template<typename Iterator, typename Buffer, typename Compare>
+        void mergeRuns(Iterator first, std::ptrdiff_t count1, std::ptrdiff_t count2, Buffer buffer, std::ptrdiff_t& minGallop, Compare comp)
+        {
+            const Iterator second = first + count1;
+
+            // Elements of the first run not greater than the head of the second, and elements of the second run
+            // not less than the tail of the first, are already in place
+            const std::ptrdiff_t head = gallop(first, count1, [&](const auto& value) { return !comp(*second, value); });
+            first += head;
+            count1 -= head;
+            if (count1 == 0)
+                return;
+            count2 = gallop(second, count2, [&](const auto& value) { return comp(value, first[count1 - 1]); });
+            if (count2 == 0)
+                return;
+
+            if (count1 <= count2)
+            {
+                glg::move(first, second, buffer);
+                gallopMerge(first, buffer, count1, second, count2, minGallop, comp);
+            }
+            else
+            {
+                glg::move(second, second + count2, buffer);
+                gallopMerge(std::reverse_iterator<Iterator>(second + count2), std::reverse_iterator<Buffer>(buffer + count2), count2,
+                    std::reverse_iterator<Iterator>(second), count1, minGallop, [&](const auto& a, const auto& b) { return comp(b, a); });
+            }
+        }
+
+        /**
+         * @brief Length of the run starting at first: non-descending, or strictly descending and then reversed.
+         */
+        template<typename Iterator, typename Compare>
+        std::ptrdiff_t countRun(Iterator first, Iterator last, Compare comp)
+        {
+            Iterator it = first + 1;
+            if (it == last)
+                return 1;
+
+            if (comp(*it, *first))
+            {
+                while (++it != last && comp(*it, *(it - 1)));
+                for (Iterator low = first, high = it - 1; low < high; ++low, --high)
+                    glg::swap(*low, *high);
+            }
+            else
+            {
+                while (++it != last && !comp(*it, *(it - 1)));
+            }
+            return it - first;
+        }
+
+        /**
+         * @brief Minimum run length of TimSort for count elements, between 16 and 32, so that count / minRun is a power
+         * of two or slightly less and the merges stay balanced.
+         */
+        inline std::ptrdiff_t minRunLength(std::ptrdiff_t count)
+        {
+            std::ptrdiff_t odd = 0;
+            while (count >= 2 * mergeRunThreshold)
+            {
+                odd |= count & 1;
+                count >>= 1;
+            }
+            return count + odd;
+        }
+
+        /**
+         * @brief TimSort: natural runs, extended to minRunLength() by insertion sort, kept on a stack whose lengths grow
+         * at least like the Fibonacci numbers and merged with gallopMerge().
+         */
+        template<typename Iterator, typename Buffer, typename Compare>
+        void timSort(Iterator first, Iterator last, Buffer buffer, Compare comp)
+        {
+            struct Run
+            {
+                std::ptrdiff_t start;
+                std::ptrdiff_t length;
+            };
+
+            const std::ptrdiff_t count = last - first;
+            if (count < 2)
+                return;
+
+            // The run lengths grow faster than the Fibonacci numbers, 96 runs cover any range that fits in memory
+            Run runs[96];
+            std::ptrdiff_t runCount = 0;
+            std::ptrdiff_t minGallop = gallopThreshold;
+
+            auto mergeAt = [&](std::ptrdiff_t i)
+            {
+                mergeRuns(first + runs[i].start, runs[i].length, runs[i + 1].length, buffer, minGallop, comp);
+                runs[i].length += runs[i + 1].length;
+                if (i + 2 < runCount)
+                    runs[i + 1] = runs[i + 2];
+                --runCount;
+            };
+
+            const std::ptrdiff_t minRun = minRunLength(count);
+            for (std::ptrdiff_t start = 0; start < count;)
+            {
+                std::ptrdiff_t length = countRun(first + start, last, comp);
+                if (length < minRun)
+                {
+                    length = std::min(minRun, count - start);
+                    insertionSort(first + start, first + (start + length), comp);
+                }
+                runs[runCount++] = { start, length };
+                start += length;
+
+                // Restore the invariants on the top of the stack (the second test fixes the original TimSort one)
+                while (runCount > 1)
+                {
+                    std::ptrdiff_t i = runCount - 2;
+                    if ((i > 0 && runs[i - 1].length <= runs[i].length + runs[i + 1].length)
+                        || (i > 1 && runs[i - 2].length <= runs[i - 1].length + runs[i].length))
+                    {
+                        if (runs[i - 1].length < runs[i + 1].length)
+                            --i;
+                    }
+                    else if (runs[i].length > runs[i + 1].length)
+                        break;
+                    mergeAt(i);
+                }
+            }
+
+            while (runCount > 1)
+            {
+                std::ptrdiff_t i = runCount - 2;
+                if (i > 0 && runs[i - 1].length < runs[i + 1].length)
+                    --i;
+                mergeAt(i);
+            }
+        }
+    }
+
+    /**
+     * @brief Merge two sorted ranges into one sorted range, through a caller-supplied buffer.
+     *
+     * The merge is stable and needs forward iterators only.
+     *
+     * @tparam Iterator Iterator type.
+     * @tparam Buffer Random-access iterator to at least distance(first, mid) elements.
+     * @param first Iterator to the first element in the first range.
+     * @param mid Iterator to the first element in the second range.
+     * @param last Iterator to the last element in the second range.
+     * @param buffer Scratch space, its contents are overwritten.
+     */
+    template<typename Iterator, typename Buffer>
+    void merge(Iterator first, Iterator mid, Iterator last, Buffer buffer)
+    {
+        detail::mergeWithBuffer(first, mid, last, buffer, std::less<>());
+    }
+
     /**
      * @brief Merge two sorted ranges into one sorted range.
      *
@@ -201,81 +1553,415 @@ namespace glg
     void merge(Iterator first, Iterator mid, Iterator last)
     {
         using ValueType = typename std::iterator_traits<Iterator>::value_type;
-        std::vector<ValueType> temp;
+        std::vector<ValueType> buffer(first, mid);
+        merge(first, mid, last, buffer.begin());
+    }
 
-        auto left = first;
-        auto right = mid;
+    /**
+     * @brief Sort a range using merge sort, through a caller-supplied buffer.
+     *
+     * Random-access ranges are copied to the buffer once, then each level of
+     * the top-down recursion merges from one array into the other. Other
+     * ranges, such as the linked lists, move the left run of each merge to
+     * the buffer. Either way the sort is stable and allocates nothing.
+     *
+     * @tparam Iterator Iterator type.
+     * @tparam Buffer Random-access iterator to at least distance(first, last) elements.
+     * @tparam Compare Strict weak ordering of the projected elements.
+     * @tparam Projection Applied to each element before comparing.
+     * @param first Iterator to the first element in the range.
+     * @param last Iterator to the last element in the range.
+     * @param buffer Scratch space, its contents are overwritten.
+     * @param comp The ordering, ascending by default.
+     * @param proj The projection, the element itself by default.
+     */
+    template<typename Iterator, std::random_access_iterator Buffer, typename Compare = std::less<>, typename Projection = std::identity>
+    void FusionSort(Iterator first, Iterator last, Buffer buffer, Compare comp = {}, Projection proj = {})
+    {
+        const std::ptrdiff_t count = std::distance(first, last);
+        if constexpr (std::random_access_iterator<Iterator>)
+        {
+            glg::copy(first, last, buffer);
+            detail::fusionSortInto(buffer, first, count, detail::projectedComparator(comp, proj));
+        }
+        else
+            detail::fusionSortForward(first, count, buffer, detail::projectedComparator(comp, proj));
+    }
 
-        while (left != mid && right != last)
+    /**
+     * @brief Sort a range using merge sort.
+     *
+     * The scratch buffer is allocated once for the whole sort.
+     *
+     * @tparam Iterator Iterator type.
+     * @tparam Compare Strict weak ordering of the projected elements.
+     * @tparam Projection Applied to each element before comparing.
+     * @param first Iterator to the first element in the range.
+     * @param last Iterator to the last element in the range.
+     * @param comp The ordering, ascending by default.
+     * @param proj The projection, the element itself by default.
+     */
+    template<typename Iterator, typename Compare = std::less<>, typename Projection = std::identity>
+        requires detail::SortComparator<Compare, Iterator, Projection>
+    void FusionSort(Iterator first, Iterator last, Compare comp = {}, Projection proj = {})
+    {
+        using ValueType = typename std::iterator_traits<Iterator>::value_type;
+        if constexpr (std::random_access_iterator<Iterator>)
         {
-            if (*left <= *right)
-            {
-                temp.push_back(*left);
-                ++left;
-            }
-            else
-            {
-                temp.push_back(*right);
-                ++right;
-            }
+            std::vector<ValueType> buffer(first, last);
+            detail::fusionSortInto(buffer.begin(), first, last - first, detail::projectedComparator(comp, proj));
+        }
+        else
+        {
+            const std::ptrdiff_t count = std::distance(first, last);
+            std::vector<ValueType> buffer(first, std::next(first, count / 2));
+            detail::fusionSortForward(first, count, buffer.begin(), detail::projectedComparator(comp, proj));
         }
+    }
+
+    /**
+     * @brief Sort a random-access range using a bottom-up merge sort, through a caller-supplied buffer.
+     *
+     * Runs of 16 elements are sorted by insertion, then each pass merges
+     * runs of doubling width from the range into the buffer or back, without
+     * recursion. The sort is stable.
+     *
+     * @tparam Iterator Random-access iterator type.
+     * @tparam Buffer Random-access iterator to at least distance(first, last) elements.
+     * @tparam Compare Strict weak ordering of the projected elements.
+     * @tparam Projection Applied to each element before comparing.
+     * @param first Iterator to the first element in the range.
+     * @param last Iterator to the last element in the range.
+     * @param buffer Scratch space, its contents are overwritten.
+     * @param comp The ordering, ascending by default.
+     * @param proj The projection, the element itself by default.
+     */
+    template<std::random_access_iterator Iterator, std::random_access_iterator Buffer, typename Compare = std::less<>, typename Projection = std::identity>
+    void BottomUpFusionSort(Iterator first, Iterator last, Buffer buffer, Compare comp = {}, Projection proj = {})
+    {
+        const auto less = detail::projectedComparator(comp, proj);
+        const std::ptrdiff_t count = last - first;
+        for (std::ptrdiff_t low = 0; low < count; low += detail::mergeRunThreshold)
+            detail::insertionSort(first + low, first + std::min(low + detail::mergeRunThreshold, count), less);
 
-        while (left != mid)
+        bool inBuffer = false;
+        for (std::ptrdiff_t width = detail::mergeRunThreshold; width < count; width *= 2)
         {
-            temp.push_back(*left);
-            ++left;
+            if (inBuffer)
+                detail::mergePass(buffer, first, count, width, less);
+            else
+                detail::mergePass(first, buffer, count, width, less);
+            inBuffer = !inBuffer;
         }
 
-        while (right != last)
+        if (inBuffer)
+            glg::move(buffer, buffer + count, first);
+    }
+
+    /**
+     * @brief Sort a random-access range using a bottom-up merge sort.
+     *
+     * @tparam Iterator Random-access iterator type.
+     * @tparam Compare Strict weak ordering of the projected elements.
+     * @tparam Projection Applied to each element before comparing.
+     * @param first Iterator to the first element in the range.
+     * @param last Iterator to the last element in the range.
+     * @param comp The ordering, ascending by default.
+     * @param proj The projection, the element itself by default.
+     */
+    template<std::random_access_iterator Iterator, typename Compare = std::less<>, typename Projection = std::identity>
+        requires detail::SortComparator<Compare, Iterator, Projection>
+    void BottomUpFusionSort(Iterator first, Iterator last, Compare comp = {}, Projection proj = {})
+    {
+        using ValueType = typename std::iterator_traits<Iterator>::value_type;
+        std::vector<ValueType> buffer(first, last);
+        BottomUpFusionSort(first, last, buffer.begin(), comp, proj);
+    }
+
+    /**
+     * @brief Sort a random-access range using TimSort, through a caller-supplied buffer.
+     *
+     * The range is cut into its natural runs (descending runs are reversed),
+     * short runs are extended by insertion sort, and the runs are merged
+     * while their lengths on the stack stay balanced. The merges skip the
+     * elements already in place and gallop, moving whole blocks found by
+     * exponential search, once one run keeps winning. A sorted or reversed
+     * range costs n - 1 comparisons, and partially sorted data approaches
+     * that. The sort is stable.
+     *
+     * @tparam Iterator Random-access iterator type.
+     * @tparam Buffer Random-access iterator to at least distance(first, last) / 2 elements.
+     * @tparam Compare Strict weak ordering of the projected elements.
+     * @tparam Projection Applied to each element before comparing.
+     * @param first Iterator to the first element in the range.
+     * @param last Iterator to the last element in the range.
+     * @param buffer Scratch space, its contents are overwritten.
+     * @param comp The ordering, ascending by default.
+     * @param proj The projection, the element itself by default.
+     */
+    template<std::random_access_iterator Iterator, std::random_access_iterator Buffer, typename Compare = std::less<>, typename Projection = std::identity>
+    void TimSort(Iterator first, Iterator last, Buffer buffer, Compare comp = {}, Projection proj = {})
+    {
+        detail::timSort(first, last, buffer, detail::projectedComparator(comp, proj));
+    }
+
+    /**
+     * @brief Sort a random-access range using TimSort.
+     *
+     * @tparam Iterator Random-access iterator type.
+     * @tparam Compare Strict weak ordering of the projected elements.
+     * @tparam Projection Applied to each element before comparing.
+     * @param first Iterator to the first element in the range.
+     * @param last Iterator to the last element in the range.
+     * @param comp The ordering, ascending by default.
+     * @param proj The projection, the element itself by default.
+     */
+    template<std::random_access_iterator Iterator, typename Compare = std::less<>, typename Projection = std::identity>
+        requires detail::SortComparator<Compare, Iterator, Projection>
+    void TimSort(Iterator first, Iterator last, Compare comp = {}, Projection proj = {})
+    {
+        using ValueType = typename std::iterator_traits<Iterator>::value_type;
+        std::vector<ValueType> buffer(first, first + (last - first) / 2);
+        TimSort(first, last, buffer.begin(), comp, proj);
+    }
+
+    /**
+     * @brief Sort a random-access range with an introsort.
+     *
+     * Quicksort with a median-of-three pivot (ninther beyond 128 elements),
+     * insertion sort up to 12 elements and heapsort once the recursion gets
+     * deeper than 2 log2(n), so the worst case stays O(n log n). Arithmetic
+     * types are partitioned without branches, and runs of elements equal to
+     * the pivot are placed in a single pass. The sort is not stable.
+     *
+     * @tparam Iterator Random-access iterator type.
+     * @tparam Compare Strict weak ordering of the projected elements.
+     * @tparam Projection Applied to each element before comparing.
+     * @param first Iterator to the first element in the range.
+     * @param last Iterator to the last element in the range.
+     * @param comp The ordering, ascending by default.
+     * @param proj The projection, the element itself by default.
+     */
+    template<std::random_access_iterator Iterator, typename Compare = std::less<>, typename Projection = std::identity>
+    void introsort(Iterator first, Iterator last, Compare comp = {}, Projection proj = {})
+    {
+        detail::introsort(first, last, detail::projectedComparator(comp, proj));
+    }
+
+    namespace detail
+    {
+        /** From this many integers or floating-point numbers on, glg::sort uses a radix sort. */
+        constexpr size_t radixSortThreshold = 2048;
+
+        /**
+         * @brief 1 if Compare is the ascending default ordering of Key, -1 if it is the descending one, 0 otherwise.
+         * The radix sorts only apply to these two orderings.
+         */
+        template<typename Compare, typename Key>
+        inline constexpr int defaultOrder = std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<Key>> ? 1
+            : std::is_same_v<Compare, std::greater<>> || std::is_same_v<Compare, std::greater<Key>> ? -1 : 0;
+
+        /** Type of the key the projection extracts from an element of Iterator. */
+        template<typename Iterator, typename Projection>
+        using ProjectedKey = std::remove_cvref_t<std::invoke_result_t<Projection&, std::iter_reference_t<Iterator>>>;
+
+        /**
+         * @brief Radix sort of [first, last) by the projected keys, ascending. Returns false, sorting nothing,
+         * when the keys or the ordering do not suit a radix sort or the range is too short for it to pay off.
+         */
+        template<typename Iterator, typename Compare, typename Projection>
+        bool tryRadixSort(Iterator first, Iterator last, Projection proj)
         {
-            temp.push_back(*right);
-            ++right;
+            if constexpr (ContiguousIterator<Iterator> && RadixKey<ProjectedKey<Iterator, Projection>>
+                && defaultOrder<Compare, ProjectedKey<Iterator, Projection>> != 0)
+            {
+                if (size_t(last - first) < radixSortThreshold)
+                    return false;
+
+                if constexpr (std::is_same_v<Projection, std::identity>)
+                    radix_sort(std::to_address(first), std::to_address(first) + (last - first));
+                else
+                    radix_sort(std::to_address(first), std::to_address(first) + (last - first), proj);
+                return true;
+            }
+            else
+                return false;
         }
 
-        auto it = first;
-        for (const auto& val : temp)
+        /**
+         * @brief Whether the AVX2 bitonic network can sort a range of Iterator by comp and proj:
+         * contiguous 32-bit keys, compared themselves in ascending or descending order.
+         */
+        template<typename Iterator, typename Compare, typename Projection>
+        inline constexpr bool simdNetworkApplies = GLG_HAS_AVX2 && ContiguousIterator<Iterator>
+            && std::is_same_v<Projection, std::identity> && SimdNetworkKey<std::iter_value_t<Iterator>>
+            && defaultOrder<Compare, std::iter_value_t<Iterator>> != 0;
+
+        /** Number of elements of the containers whose size is part of their type, 0 for the others. */
+        template<typename Container>
+        inline constexpr size_t fixedExtent = 0;
+
+        template<typename T, size_t N>
+        inline constexpr size_t fixedExtent<myArray<T, N>> = N;
+
+        template<typename T, size_t N>
+        inline constexpr size_t fixedExtent<std::array<T, N>> = N;
+
+        /**
+         * @brief Unstable sort of a random-access range: the bitonic network for up to 64 32-bit keys, the radix sort
+         * when tryRadixSort takes it, either reversed for a descending order, and introsort otherwise.
+         */
+        template<typename Iterator, typename Compare, typename Projection>
+        void sortRange(Iterator first, Iterator last, Compare comp, Projection proj)
         {
-            *it = val;
-            ++it;
+            if constexpr (simdNetworkApplies<Iterator, Compare, Projection>)
+            {
+                if (size_t(last - first) <= simdNetworkThreshold)
+                {
+                    simdNetworkSort(std::to_address(first), size_t(last - first));
+                    if constexpr (defaultOrder<Compare, std::iter_value_t<Iterator>> == -1)
+                        std::reverse(first, last);
+                    return;
+                }
+            }
+
+            if (tryRadixSort<Iterator, Compare>(first, last, proj))
+            {
+                if constexpr (defaultOrder<Compare, ProjectedKey<Iterator, Projection>> == -1)
+                    std::reverse(first, last);
+            }
+            else
+                detail::introsort(first, last, projectedComparator(comp, proj));
         }
     }
 
     /**
-     * @brief Sort a range using merge sort.
+     * @brief Sort a range, keeping equal elements in their original order.
+     *
+     * Contiguous ranges of at least 2048 integer keys, sorted in ascending
+     * order, go through the radix sort. Everything else
+     * is merge sorted (glg::FusionSort); glg::TimSort is the better choice
+     * for ranges that are already partly sorted.
      *
      * @tparam Iterator Iterator type.
+     * @tparam Compare Strict weak ordering of the projected elements.
+     * @tparam Projection Applied to each element before comparing.
      * @param first Iterator to the first element in the range.
      * @param last Iterator to the last element in the range.
+     * @param comp The ordering, ascending by default.
+     * @param proj The projection, the element itself by default.
      */
-    template<typename Iterator>
-    void FusionSort(Iterator first, Iterator last)
+    template<typename Iterator, typename Compare = std::less<>, typename Projection = std::identity>
+    void stable_sort(Iterator first, Iterator last, Compare comp = {}, Projection proj = {})
     {
-        auto distance = std::distance(first, last);
-        if (distance <= 1) return;
-
-        auto mid = first;
-        std::advance(mid, distance / 2);
-
-        FusionSort(first, mid);
-        FusionSort(mid, last);
-        merge(first, mid, last);
+        if constexpr (detail::ContiguousIterator<Iterator>)
+        {
+            // Reversing a radix sort would reverse the equal elements too, so only the ascending order qualifies.
+            // Floating-point keys stay out: the radix order puts -0.0 before +0.0, which std::less holds equal
+            using Key = detail::ProjectedKey<Iterator, Projection>;
+            if constexpr (std::is_integral_v<Key> && detail::defaultOrder<Compare, Key> == 1)
+            {
+                if (detail::tryRadixSort<Iterator, Compare>(first, last, proj))
+                    return;
+            }
+        }
+        FusionSort(first, last, comp, proj);
     }
 
     /**
      * @brief Sort a container using an appropriate sorting algorithm.
      *
+     * Containers with contiguous storage are sorted in place by introsort on
+     * their raw elements, or by radix sort when they hold at least 2048
+     * integers or floating-point numbers (or project them) in ascending or
+     * descending order. Up to 64 ints, unsigneds or floats in either order
+     * go through the AVX2 bitonic network, and myArray or std::array of up
+     * to 32 other arithmetic elements through the sorting network of their
+     * size. Other random-access ranges are sorted by introsort on their
+     * iterators, and the linked lists by merge sort.
+     *
      * @tparam Container Container type.
+     * @tparam Compare Strict weak ordering of the projected elements.
+     * @tparam Projection Applied to each element before comparing.
      * @param container The container to sort.
+     * @param comp The ordering, ascending by default.
+     * @param proj The projection, the element itself by default.
      */
-    template<typename Container>
-    void sort(Container& container)
+    template<typename Container, typename Compare = std::less<>, typename Projection = std::identity>
+    void sort(Container& container, Compare comp = {}, Projection proj = {})
     {
-        auto size = std::distance(container.begin(), container.end());
-        if (size <= 16)
-            InsertionSort(container.begin(), container.end());
-        else if (size <= 1000)
-            BubbleSort(container.begin(), container.end());
+        constexpr size_t extent = detail::fixedExtent<Container>;
+        if constexpr (extent >= 2 && extent <= detail::fixedNetworkThreshold)
+        {
+            using Pointer = decltype(container.data());
+            if constexpr (std::is_arithmetic_v<std::iter_value_t<Pointer>> && !detail::simdNetworkApplies<Pointer, Compare, Projection>)
+            {
+                network_sort<extent>(container.data(), comp, proj);
+                return;
+            }
+        }
+
+        if constexpr (requires { container.data(); container.size(); })
+            detail::sortRange(container.data(), container.data() + container.size(), comp, proj);
+        else if constexpr (std::random_access_iterator<decltype(container.begin())>)
+            introsort(container.begin(), container.end(), comp, proj);
         else
-            FusionSort(container.begin(), container.end());
+            FusionSort(container.begin(), container.end(), comp, proj);
+    }
+
+    /**
+     * @brief Rearrange a random-access range so that *nth is the element a full sort would put there.
+     *
+     * No element before nth is greater than *nth, and no element after it is
+     * smaller. Introselect partitions as introsort does but only keeps the side
+     * holding nth: O(n) on average, O(n log n) at worst.
+     *
+     * @tparam Iterator Random-access iterator type.
+     * @tparam Compare Strict weak ordering of the projected elements.
+     * @tparam Projection Applied to each element before comparing.
+     * @param first Iterator to the first element in the range.
+     * @param nth Iterator to the position to settle.
+     * @param last Iterator to the last element in the range.
+     * @param comp The ordering, ascending by default.
+     * @param proj The projection, the element itself by default.
+     */
+    template<std::random_access_iterator Iterator, typename Compare = std::less<>, typename Projection = std::identity>
+    void nth_element(Iterator first, Iterator nth, Iterator last, Compare comp = {}, Projection proj = {})
+    {
+        if (nth != last)
+            detail::introselect(first, nth, last, detail::projectedComparator(comp, proj));
+    }
+
+    /**
+     * @brief Sort the distance(first, middle) smallest elements of a random-access range into [first, middle).
+     *
+     * Up to 1024 elements are selected through a max-heap, in one pass over
+     * the range: O(n log k). Beyond, nth_element moves them in front and they
+     * are sorted as glg::sort would: O(n + k log k). The rest of the range is
+     * left in an unspecified order. The sort is not stable.
+     *
+     * @tparam Iterator Random-access iterator type.
+     * @tparam Compare Strict weak ordering of the projected elements.
+     * @tparam Projection Applied to each element before comparing.
+     * @param first Iterator to the first element in the range.
+     * @param middle Iterator past the last element to sort.
+     * @param last Iterator to the last element in the range.
+     * @param comp The ordering, ascending by default.
+     * @param proj The projection, the element itself by default.
+     */
+    template<std::random_access_iterator Iterator, typename Compare = std::less<>, typename Projection = std::identity>
+    void partial_sort(Iterator first, Iterator middle, Iterator last, Compare comp = {}, Projection proj = {})
+    {
+        if (first == middle)
+            return;
+
+        const auto less = detail::projectedComparator(comp, proj);
+        if (middle - first <= detail::heapSelectThreshold)
+            detail::heapSelect(first, middle, last, less);
+        else
+        {
+            detail::introselect(first, middle - 1, last, less);
+            detail::sortRange(first, middle - 1, comp, proj);
+        }
     }
-};
\ No newline at end of file
+};
@@ -6,7 +6,14 @@
  */
 
 #pragma once
+#include <cmath>
 #include <iostream>
+#include <type_traits>
+#include "myDecomposition.h"
+#include "myDynMatrix.h"
+#include "myHalf.h"
+#include "myMatrix.h"
+#include "myTranspose.h"
 #include "myVector.h"
 #include "myVectorND.h"
 
@@ -63,6 +70,71 @@ namespace Math
 		return result;
 	}
 
+	/**
+	 * @brief Computes the scalar product of two N-dimensional half vectors.
+	 * The elements are widened to float (F16C when available) and accumulated in float.
+	 *
+	 * @tparam N The size of the vectors.
+	 * @param vec1 The first vector.
+	 * @param vec2 The second vector.
+	 * @return The scalar product of the two vectors.
+	 */
+	template<size_t N>
+	float scalarProduct(const myVectorND<glg::half, N>& vec1, const myVectorND<glg::half, N>& vec2)
+	{
+		return glg::dot(vec1.data(), vec2.data(), N);
+	}
+
+	/**
+	 * @brief Computes the scalar product of two N-dimensional bfloat16 vectors, accumulated in float.
+	 *
+	 * @tparam N The size of the vectors.
+	 * @param vec1 The first vector.
+	 * @param vec2 The second vector.
+	 * @return The scalar product of the two vectors.
+	 */
+	template<size_t N>
+	float scalarProduct(const myVectorND<glg::bfloat16, N>& vec1, const myVectorND<glg::bfloat16, N>& vec2)
+	{
+		return glg::dot(vec1.data(), vec2.data(), N);
+	}
+
+	/**
+	 * @brief Computes the scalar product of two half vectors, accumulated in float.
+	 *
+	 * @tparam N The capacity of the vectors.
+	 * @param vec1 The first vector.
+	 * @param vec2 The second vector.
+	 * @return The scalar product of the two vectors.
+	 * @throw std::runtime_error if the sizes of the vectors are not equal.
+	 */
+	template<size_t N>
+	float scalarProduct(const myVector<glg::half, N>& vec1, const myVector<glg::half, N>& vec2)
+	{
+		if (vec1.size() != vec2.size())
+			throw std::runtime_error("size must be equal");
+
+		return glg::dot(vec1.data(), vec2.data(), vec1.size());
+	}
+
+	/**
+	 * @brief Computes the scalar product of two bfloat16 vectors, accumulated in float.
+	 *
+	 * @tparam N The capacity of the vectors.
+	 * @param vec1 The first vector.
+	 * @param vec2 The second vector.
+	 * @return The scalar product of the two vectors.
+	 * @throw std::runtime_error if the sizes of the vectors are not equal.
+	 */
+	template<size_t N>
+	float scalarProduct(const myVector<glg::bfloat16, N>& vec1, const myVector<glg::bfloat16, N>& vec2)
+	{
+		if (vec1.size() != vec2.size())
+			throw std::runtime_error("size must be equal");
+
+		return glg::dot(vec1.data(), vec2.data(), vec1.size());
+	}
+
 	/**
 	 * @brief Computes the cross product of two 3-dimensional vectors.
 	 *
@@ -190,4 +262,84 @@ namespace Math
 		}
 		return result;
 	};
+
+	/**
+	 * @brief Computes the matrix product of two matrices into an existing matrix.
+	 * Unlike operator*, no temporary is created, which matters for large matrices
+	 * allocated on the heap.
+	 *
+	 * The three matrices may be in any layouts: row-major and column-major
+	 * operands go to the kernels with their strides, tiled ones are copied first.
+	 *
+	 * @tparam T The type of elements in the matrices.
+	 * @tparam H The height of lhs and result.
+	 * @tparam K The width of lhs and height of rhs.
+	 * @tparam W The width of rhs and result.
+	 * @param lhs The left operand.
+	 * @param rhs The right operand.
+	 * @param result The matrix receiving lhs * rhs, it must not be lhs or rhs.
+	 * @throw std::invalid_argument if result aliases one of the operands.
+	 */
+	template<typename T, size_t H, size_t K, size_t W, typename LA, typename LB, typename LC>
+	void multiply(const myMatrix<T, H, K, LA>& lhs, const myMatrix<T, K, W, LB>& rhs, myMatrix<T, H, W, LC>& result)
+	{
+		if (result.data() == lhs.data() || result.data() == rhs.data())
+			throw std::invalid_argument("result must not alias an operand");
+
+		if constexpr (std::is_same_v<LA, glg::RowMajor> && std::is_same_v<LB, glg::RowMajor> && std::is_same_v<LC, glg::RowMajor>)
+			gemmFixed<T, H, W, K>(lhs.data(), rhs.data(), result.data());
+		else
+			(lhs * rhs).template evaluateInto<LC>(result.data(), T(1), T(0));
+	}
+
+	/**
+	 * @brief Computes result = lhs * rhs where every operand is a view (a block, a row, a transposed matrix...).
+	 * The strides of the views go straight to gemm, so nothing is copied.
+	 *
+	 * @tparam A The element type of lhs, possibly const.
+	 * @tparam B The element type of rhs, possibly const.
+	 * @tparam T The element type of result.
+	 * @param lhs The left operand, rows x inner.
+	 * @param rhs The right operand, inner x cols.
+	 * @param result The view receiving lhs * rhs, rows x cols. It must not overlap an operand.
+	 * @throw std::invalid_argument if the shapes do not match or result starts on an operand.
+	 */
+	template<typename A, typename B, typename T>
+	void multiply(myMatrixView<A> lhs, myMatrixView<B> rhs, myMatrixView<T> result)
+	{
+		static_assert(std::is_same_v<std::remove_const_t<A>, T> && std::is_same_v<std::remove_const_t<B>, T>,
+			"operands must have the same element type");
+
+		if (lhs.cols() != rhs.rows() || result.rows() != lhs.rows() || result.cols() != rhs.cols())
+			throw std::invalid_argument("size must be equal");
+		if (result.data() == lhs.data() || result.data() == rhs.data())
+			throw std::invalid_argument("result must not alias an operand");
+
+		gemm<T>(lhs.rows(), rhs.cols(), lhs.cols(), T(1),
+			lhs.data(), lhs.rowStride(), lhs.colStride(),
+			rhs.data(), rhs.rowStride(), rhs.colStride(),
+			T(0), result.data(), result.rowStride(), result.colStride());
+	}
+
+	/**
+	 * @brief Computes the matrix product of two runtime-sized matrices, result is resized if needed.
+	 *
+	 * @tparam T The type of elements in the matrices.
+	 * @param lhs The left operand.
+	 * @param rhs The right operand.
+	 * @param result The matrix receiving lhs * rhs, it must not be lhs or rhs.
+	 * @throw std::invalid_argument if the inner dimensions differ or result aliases an operand.
+	 */
+	template<typename T>
+	void multiply(const myDynMatrix<T>& lhs, const myDynMatrix<T>& rhs, myDynMatrix<T>& result)
+	{
+		if (&result == &lhs || &result == &rhs)
+			throw std::invalid_argument("result must not alias an operand");
+		if (lhs.cols() != rhs.rows())
+			throw std::invalid_argument("inner dimensions must be equal");
+
+		if (result.rows() != lhs.rows() || result.cols() != rhs.cols())
+			result.resize(lhs.rows(), rhs.cols());
+		multiply(lhs.view(), rhs.view(), result.view());
+	}
 };
\ No newline at end of file
@@ -7,8 +7,24 @@
 
 #pragma once
 #include <initializer_list>
+#include <iostream>
+#include <stdexcept>
 #include "helper.h"
 
+namespace glg
+{
+    /**
+     * @brief Tag selecting the constructors that leave the elements uninitialised,
+     * for callers that overwrite every element right away.
+     */
+    struct uninitialized_t
+    {
+        explicit uninitialized_t() = default;
+    };
+
+    inline constexpr uninitialized_t uninitialized{};
+};
+
  /**
   * @struct myArray
   * @brief Template class representing a fixed-size array with iterator support.
@@ -29,11 +45,14 @@ struct myArray
 	{
     public:
         using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept = std::contiguous_iterator_tag;
         using value_type = T;
         using difference_type = std::ptrdiff_t;
         using pointer = T*;
         using reference = T&;
 
+        iterator() = default;
+
         /**
          * @brief Constructor for iterator.
          * @param ptr Pointer to the array element.
@@ -41,12 +60,12 @@ struct myArray
         iterator(pointer ptr) : m_ptr(ptr) {}
 
         // Dereference operators
-        reference operator*() 
+        reference operator*() const
         {
             return *m_ptr;
         }
 
-        pointer operator->()
+        pointer operator->() const
     	{
             return m_ptr;
         }
@@ -64,6 +83,11 @@ struct myArray
             return tmp += n;
         }
 
+        friend iterator operator+(difference_type n, const iterator& it)
+        {
+            return it + n;
+        }
+
         iterator& operator-=(difference_type n)
     	{
             m_ptr -= n;
@@ -145,7 +169,7 @@ struct myArray
         }
 
     private:
-        pointer m_ptr;
+        pointer m_ptr = nullptr;
     };
 
     /**
@@ -156,11 +180,14 @@ struct myArray
 	{
     public:
         using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept = std::contiguous_iterator_tag;
         using value_type = T;
         using difference_type = std::ptrdiff_t;
         using pointer = const T*;
         using reference = const T&;
 
+        const_iterator() = default;
+
         /**
          * @brief Constructor for const iterator.
          * @param ptr Pointer to the array element.
@@ -194,6 +221,11 @@ struct myArray
             return tmp += n;
         }
 
+        friend const_iterator operator+(difference_type n, const const_iterator& it)
+        {
+            return it + n;
+        }
+
         const_iterator& operator-=(difference_type n)
     	{
             m_ptr -= n;
@@ -275,7 +307,7 @@ struct myArray
         }
 
     private:
-        pointer m_ptr;
+        pointer m_ptr = nullptr;
         friend struct myArray;
     };
 
@@ -296,7 +328,14 @@ struct myArray
      */
 	myArray()
 	{
-		glg::fill(begin(), end(), value_type{});
+		glg::fill(m_data, m_data + N, value_type{});
+	}
+
+    /**
+     * @brief Constructor leaving the elements default-initialised (uninitialised for arithmetic types).
+     */
+	explicit myArray(glg::uninitialized_t)
+	{
 	}
 
     /**
@@ -318,7 +357,7 @@ struct myArray
      */
 	myArray(const myArray& tab)
 	{
-		glg::copy(tab.begin(), tab.end(), m_data);
+		glg::copy(tab.m_data, tab.m_data + N, m_data);
 	}
 
     /**
@@ -329,7 +368,7 @@ struct myArray
 	myArray& operator=(const myArray& tab)
 	{
 		if (this != &tab)
-			glg::copy(tab.begin(), tab.end(), m_data);
+			glg::copy(tab.m_data, tab.m_data + N, m_data);
 
 		return *this;
 	}
@@ -0,0 +1,296 @@
+/**
+ * @file myBatched.h
+ * @brief Implementation of the batched product of many small fixed-size matrices.
+ * @author Guillaume
+ * @date 18/10/2026
+ *
+ * A 4x4 or 8x8 product is too small to fill the SIMD registers on its own,
+ * and calling a general GEMM for each pair spends more time in the setup
+ * than in the arithmetic. batchedMultiply() uses the compact (interleaved)
+ * layout instead: a group of as many matrices as there are SIMD lanes is
+ * transposed so that element (i, j) of the lane-th matrix sits in lane
+ * "lane" of a register. The group is then multiplied with the plain
+ * triple loop, each multiply-add computing the same element of every
+ * matrix of the group, whatever M, N and K are.
+ *
+ * The batch is a row-major (count x M*K) matrix, so interleaving a group
+ * is a Math::transpose of lanes x (M*K) elements. Groups are independent
+ * and split over the global glg::ThreadPool.
+ *
+ * When the rows of C are a whole number of registers (8x8 floats, 4x4 or
+ * 8x8 doubles...), gemmFixed() already runs at full width on each pair and
+ * the packing would only cost bandwidth: such batches keep the per-pair
+ * kernel and are only split over the pool.
+ */
+
+#pragma once
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include "myGemm.h"
+#include "myMatrix.h"
+#include "myThreadPool.h"
+#include "myTranspose.h"
+#include "simdConfig.h"
+
+namespace Math
+{
+    namespace detail
+    {
+        /** Batches with fewer multiply-adds than this run on the calling thread. */
+        constexpr size_t batchedParallelThreshold = 1 << 20;
+
+        /**
+         * @brief Number of matrices interleaved in a group: one per SIMD lane.
+         */
+        template<typename T>
+        constexpr size_t batchLanes()
+        {
+#if GLG_HAS_AVX2 && GLG_HAS_FMA
+            if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+                return SimdTraits<T>::lanes;
+#endif
+            return 32 / sizeof(T) > 1 ? 32 / sizeof(T) : 1;
+        }
+
+#if GLG_HAS_AVX2 && GLG_HAS_FMA
+        /**
+         * @brief Rows [i, i + R) and columns [j, j + 4) of C = A * B on a group of interleaved matrices, R being 1 or 2.
+         * The accumulators are named registers rather than an array, which compilers do not always keep out of memory.
+         */
+        template<typename T, size_t N, size_t K, size_t R>
+        inline void compactTile(const T* a, const T* b, T* c, size_t i, size_t j)
+        {
+            using S = SimdTraits<T>;
+            constexpr size_t L = S::lanes;
+            const T* a0 = a + i * K * L;
+            const T* a1 = a0 + K * L;
+            const T* bj = b + j * L;
+
+            typename S::reg c00 = S::zero(), c01 = S::zero(), c02 = S::zero(), c03 = S::zero();
+            typename S::reg c10 = S::zero(), c11 = S::zero(), c12 = S::zero(), c13 = S::zero();
+            for (size_t p = 0; p < K; ++p)
+            {
+                const T* bp = bj + p * N * L;
+                const typename S::reg b0 = S::load(bp), b1 = S::load(bp + L), b2 = S::load(bp + 2 * L), b3 = S::load(bp + 3 * L);
+                const typename S::reg x0 = S::load(a0 + p * L);
+                c00 = S::fmadd(x0, b0, c00);
+                c01 = S::fmadd(x0, b1, c01);
+                c02 = S::fmadd(x0, b2, c02);
+                c03 = S::fmadd(x0, b3, c03);
+                if constexpr (R == 2)
+                {
+                    const typename S::reg x1 = S::load(a1 + p * L);
+                    c10 = S::fmadd(x1, b0, c10);
+                    c11 = S::fmadd(x1, b1, c11);
+                    c12 = S::fmadd(x1, b2, c12);
+                    c13 = S::fmadd(x1, b3, c13);
+                }
+            }
+
+            T* c0 = c + (i * N + j) * L;
+            S::storeu(c0, c00);
+            S::storeu(c0 + L, c01);
+            S::storeu(c0 + 2 * L, c02);
+            S::storeu(c0 + 3 * L, c03);
+            if constexpr (R == 2)
+            {
+                T* c1 = c0 + N * L;
+                S::storeu(c1, c10);
+                S::storeu(c1 + L, c11);
+                S::storeu(c1 + 2 * L, c12);
+                S::storeu(c1 + 3 * L, c13);
+            }
+        }
+
+        /**
+         * @brief Element (i, j) of C = A * B on a group of interleaved matrices.
+         */
+        template<typename T, size_t N, size_t K>
+        inline void compactElement(const T* a, const T* b, T* c, size_t i, size_t j)
+        {
+            using S = SimdTraits<T>;
+            constexpr size_t L = S::lanes;
+
+            // Two chains hide the latency of the multiply-adds
+            typename S::reg even = S::zero(), odd = S::zero();
+            size_t p = 0;
+            for (; p + 2 <= K; p += 2)
+            {
+                even = S::fmadd(S::load(a + (i * K + p) * L), S::load(b + (p * N + j) * L), even);
+                odd = S::fmadd(S::load(a + (i * K + p + 1) * L), S::load(b + ((p + 1) * N + j) * L), odd);
+            }
+            if (p < K)
+                even = S::fmadd(S::load(a + (i * K + p) * L), S::load(b + (p * N + j) * L), even);
+            S::storeu(c + (i * N + j) * L, S::add(even, odd));
+        }
+#endif
+
+        /**
+         * @brief C = A * B on a group of L interleaved matrices: element e of matrix l is at [e * L + l].
+         */
+        template<typename T, size_t M, size_t N, size_t K, size_t L>
+        void compactMultiply(const T* a, const T* b, T* c)
+        {
+#if GLG_HAS_AVX2 && GLG_HAS_FMA
+            if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+            {
+                static_assert(SimdTraits<T>::lanes == L, "one matrix per lane");
+
+                // 2 x 4 blocks of C: every load of A feeds four multiply-adds and every load of B two
+                for (size_t i = 0; i < M; i += 2)
+                {
+                    size_t j = 0;
+                    for (; j + 4 <= N; j += 4)
+                    {
+                        if (i + 2 <= M)
+                            compactTile<T, N, K, 2>(a, b, c, i, j);
+                        else
+                            compactTile<T, N, K, 1>(a, b, c, i, j);
+                    }
+                    for (; j < N; ++j)
+                    {
+                        compactElement<T, N, K>(a, b, c, i, j);
+                        if (i + 1 < M)
+                            compactElement<T, N, K>(a, b, c, i + 1, j);
+                    }
+                }
+                return;
+            }
+#endif
+            // The innermost loop runs over the lanes, which the compiler vectorises
+            for (size_t i = 0; i < M; ++i)
+            {
+                for (size_t j = 0; j < N; ++j)
+                {
+                    T acc[L] = {};
+                    for (size_t p = 0; p < K; ++p)
+                    {
+                        const T* aip = a + (i * K + p) * L;
+                        const T* bpj = b + (p * N + j) * L;
+                        for (size_t l = 0; l < L; ++l)
+                            acc[l] += aip[l] * bpj[l];
+                    }
+                    for (size_t l = 0; l < L; ++l)
+                        c[(i * N + j) * L + l] = acc[l];
+                }
+            }
+        }
+
+        /**
+         * @brief Whether a pair is multiplied faster on its own by gemmFixed() than interleaved.
+         * It is when the rows of C fill whole registers (and for 4x4 floats, which have their own kernel):
+         * the interleaved layout then only adds its packing to the same number of multiply-adds.
+         */
+        template<typename T, size_t N, size_t K>
+        constexpr bool batchedPerPair()
+        {
+#if GLG_HAS_SSE2
+            if constexpr (std::is_same_v<T, float> && N == 4 && K == 4)
+                return true;
+#endif
+#if GLG_HAS_AVX2 && GLG_HAS_FMA
+            if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+                return N % SimdTraits<T>::lanes == 0;
+#endif
+            return false;
+        }
+
+        /**
+         * @brief Multiplies the pairs [first, last) of the batch, group by group.
+         */
+        template<typename T, size_t M, size_t N, size_t K>
+        void batchedRange(const T* a, const T* b, T* c, size_t first, size_t last)
+        {
+            if constexpr (batchedPerPair<T, N, K>())
+            {
+                for (size_t i = first; i < last; ++i)
+                    gemmFixed<T, M, N, K>(a + i * M * K, b + i * K * N, c + i * M * N);
+                return;
+            }
+
+            constexpr size_t L = batchLanes<T>();
+            alignas(64) T packedA[M * K * L];
+            alignas(64) T packedB[K * N * L];
+            alignas(64) T packedC[M * N * L];
+
+            for (size_t g = first; g < last; g += L)
+            {
+                const size_t count = last - g < L ? last - g : L;
+                if (count < L)
+                {
+                    // Missing matrices of the last group are zeros, their results are dropped
+                    for (size_t e = 0; e < M * K * L; ++e)
+                        packedA[e] = T(0);
+                    for (size_t e = 0; e < K * N * L; ++e)
+                        packedB[e] = T(0);
+                }
+
+                transpose(a + g * M * K, M * K, packedA, L, count, M * K);
+                transpose(b + g * K * N, K * N, packedB, L, count, K * N);
+                compactMultiply<T, M, N, K, L>(packedA, packedB, packedC);
+                transpose(packedC, L, c + g * M * N, M * N, M * N, count);
+            }
+        }
+    }
+
+    /**
+     * @brief Multiplies every pair of a batch of small matrices: c[i] = a[i] * b[i].
+     *
+     * @tparam T Element type.
+     * @tparam M Number of rows of the a[i] and c[i].
+     * @tparam N Number of columns of the b[i] and c[i].
+     * @tparam K Number of columns of the a[i] and rows of the b[i].
+     * @param a The left operands.
+     * @param b The right operands.
+     * @param c The results, they must not overlap a or b.
+     * @throw std::invalid_argument if the three spans differ in size.
+     */
+    template<typename T, size_t M, size_t N, size_t K>
+    void batchedMultiply(std::span<const myMatrix<T, M, K>> a, std::span<const myMatrix<T, K, N>> b, std::span<myMatrix<T, M, N>> c)
+    {
+        static_assert(sizeof(myMatrix<T, M, K>) == M * K * sizeof(T) && sizeof(myMatrix<T, K, N>) == K * N * sizeof(T),
+            "a batch must be a contiguous array of elements");
+
+        if (a.size() != c.size() || b.size() != c.size())
+            throw std::invalid_argument("size must be equal");
+        if (c.empty())
+            return;
+
+        const T* dataA = a[0].data();
+        const T* dataB = b[0].data();
+        T* dataC = c[0].data();
+        const auto range = [&](size_t first, size_t last) { detail::batchedRange<T, M, N, K>(dataA, dataB, dataC, first, last); };
+
+        constexpr size_t L = detail::batchLanes<T>();
+        if (c.size() * M * N * K < detail::batchedParallelThreshold)
+            range(0, c.size());
+        else
+        {
+            // Chunks hold whole groups, about 2^16 multiply-adds each
+            const size_t groups = (c.size() + L - 1) / L;
+            const size_t grain = (1 << 16) / (M * N * K * L) + 1;
+            glg::ThreadPool::global().parallelFor(0, groups, grain, [&](size_t firstGroup, size_t lastGroup)
+            {
+                range(firstGroup * L, lastGroup * L < c.size() ? lastGroup * L : c.size());
+            });
+        }
+    }
+
+    /**
+     * @brief Batched product of matrices held in contiguous containers (std::vector, std::array, non-const spans...).
+     * @throw std::invalid_argument if the three containers differ in size.
+     */
+    template<typename RangeA, typename RangeB, typename RangeC>
+        requires requires(RangeA& a, RangeB& b, RangeC& c) { std::data(a); std::size(a); std::data(b); std::size(b); std::data(c); std::size(c); }
+    void batchedMultiply(RangeA&& a, RangeB&& b, RangeC&& c)
+    {
+        using MatrixA = std::remove_cvref_t<decltype(*std::data(a))>;
+        using MatrixB = std::remove_cvref_t<decltype(*std::data(b))>;
+        using MatrixC = std::remove_reference_t<decltype(*std::data(c))>;
+        batchedMultiply(std::span<const MatrixA>(std::data(a), std::size(a)), std::span<const MatrixB>(std::data(b), std::size(b)),
+            std::span<MatrixC>(std::data(c), std::size(c)));
+    }
+};
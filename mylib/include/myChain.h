@@ -0,0 +1,230 @@
+/**
+ * @file myChain.h
+ * @brief Implementation of glg::chainMultiply, a product of several matrices in the cheapest order, chosen at compile time.
+ * @author Guillaume
+ * @date 18/10/2026
+ *
+ * The cost of A * B * C * D depends on where the parentheses go: with
+ * A 10x1000, B 1000x10 and C 10x1000, (A * B) * C costs 2e5 multiply-adds
+ * and A * (B * C) 2e7. The dimensions of myMatrix being template
+ * parameters, the matrix-chain ordering problem is solved by a constexpr
+ * dynamic program over the chain (O(n^3) for n matrices, at compile
+ * time). At run time, only the products of the chosen order remain, each
+ * one going to gemmFixed() or gemm().
+ *
+ * The intermediate products live in the same scratch as the expression
+ * templates, on the stack up to 4 KB and on the heap beyond. A myVectorND
+ * takes part as a column, so A * B * x is computed as A * (B * x).
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include "myExpr.h"
+#include "myGemm.h"
+#include "myLayout.h"
+#include "myMatrix.h"
+#include "myTranspose.h"
+#include "myVectorND.h"
+
+namespace glg
+{
+    /**
+     * @struct ChainPlan
+     * @brief Cheapest parenthesisation of a chain of count matrices.
+     *
+     * cost[i][j] is the number of multiply-adds of the best order for the
+     * matrices [i, j] and split[i][j] the last product of that order:
+     * (M_i ... M_split) * (M_split+1 ... M_j).
+     */
+    template<size_t count>
+    struct ChainPlan
+    {
+        size_t cost[count][count] = {};
+        size_t split[count][count] = {};
+    };
+
+    /**
+     * @brief Solves the matrix-chain ordering problem.
+     * @param dims Matrix i is dims[i] x dims[i + 1].
+     * @return The cost and the split of every sub-chain.
+     */
+    template<size_t count>
+    constexpr ChainPlan<count> planChain(const std::array<size_t, count + 1>& dims)
+    {
+        ChainPlan<count> plan;
+        for (size_t length = 2; length <= count; ++length)
+        {
+            for (size_t i = 0; i + length <= count; ++i)
+            {
+                const size_t j = i + length - 1;
+                plan.cost[i][j] = std::numeric_limits<size_t>::max();
+                for (size_t k = i; k < j; ++k)
+                {
+                    const size_t cost = plan.cost[i][k] + plan.cost[k + 1][j] + dims[i] * dims[k + 1] * dims[j + 1];
+                    if (cost < plan.cost[i][j])
+                    {
+                        plan.cost[i][j] = cost;
+                        plan.split[i][j] = k;
+                    }
+                }
+            }
+        }
+        return plan;
+    }
+
+    namespace detail
+    {
+        /**
+         * @struct Chain
+         * @brief Dimensions and plan of a chain of matrices and vectors, all computed at compile time.
+         */
+        template<typename... Operands>
+        struct Chain
+        {
+            static constexpr size_t count = sizeof...(Operands);
+            static_assert(count > 0, "a chain needs at least one operand");
+            static_assert((expr::Container<Operands> && ...), "chainMultiply takes myMatrix and myVectorND operands");
+
+            using First = std::tuple_element_t<0, std::tuple<std::remove_cvref_t<Operands>...>>;
+            using Last = std::tuple_element_t<count - 1, std::tuple<std::remove_cvref_t<Operands>...>>;
+            using value_type = typename First::value_type;
+            static_assert((std::is_same_v<typename std::remove_cvref_t<Operands>::value_type, value_type> && ...),
+                "operands must have the same element type");
+
+            static constexpr std::array<size_t, count> rows = { expr::ContainerTraits<std::remove_cvref_t<Operands>>::rows... };
+            static constexpr std::array<size_t, count> cols = { expr::ContainerTraits<std::remove_cvref_t<Operands>>::cols... };
+
+            static constexpr bool chained()
+            {
+                for (size_t i = 0; i + 1 < count; ++i)
+                {
+                    if (cols[i] != rows[i + 1])
+                        return false;
+                }
+                return true;
+            }
+            static_assert(chained(), "inner dimensions must be equal");
+
+            static constexpr std::array<size_t, count + 1> dims()
+            {
+                std::array<size_t, count + 1> result = {};
+                result[0] = rows[0];
+                for (size_t i = 0; i < count; ++i)
+                    result[i + 1] = cols[i];
+                return result;
+            }
+
+            static constexpr std::array<size_t, count + 1> dimensions = dims();
+            static constexpr ChainPlan<count> plan = planChain<count>(dimensions);
+
+            /** A chain ending with a vector is a vector, like the product of a matrix and a vector. */
+            static constexpr bool endsWithVector = std::is_same_v<Last, myVectorND<value_type, rows[count - 1]>>;
+            using result_type = std::conditional_t<endsWithVector, myVectorND<value_type, dimensions[0]>,
+                myMatrix<value_type, dimensions[0], dimensions[count]>>;
+        };
+
+        /** Elements and strides of an operand of one of the products. */
+        template<typename T>
+        struct ChainOperand
+        {
+            const T* data;
+            size_t rowStride;
+            size_t colStride;
+        };
+
+        template<typename C, size_t i, size_t j, typename Tuple>
+        void evaluateChain(const Tuple& operands, typename C::value_type* dst);
+
+        /**
+         * @brief The product of the operands [i, j]: the operand itself when i == j and it has strides, else computed into scratch.
+         */
+        template<typename C, size_t i, size_t j, typename Tuple, size_t count>
+        ChainOperand<typename C::value_type> chainOperand(const Tuple& operands, expr::Scratch<typename C::value_type, count>& scratch)
+        {
+            constexpr size_t rows = C::dimensions[i];
+            constexpr size_t cols = C::dimensions[j + 1];
+            if constexpr (i == j)
+            {
+                using Operand = std::remove_cvref_t<std::tuple_element_t<i, Tuple>>;
+                using Layout = typename expr::ContainerTraits<Operand>::layout;
+                const Operand& operand = std::get<i>(operands);
+                if constexpr (Layout::strided)
+                    return { operand.data(), Layout::rowStride(rows, cols), Layout::colStride(rows, cols) };
+                else
+                {
+                    Math::relayout<Layout, glg::RowMajor>(operand.data(), scratch.get(), rows, cols);
+                    return { scratch.get(), cols, 1 };
+                }
+            }
+            else
+            {
+                evaluateChain<C, i, j>(operands, scratch.get());
+                return { scratch.get(), cols, 1 };
+            }
+        }
+
+        /**
+         * @brief Writes the product of the operands [i, j] (i < j) into dst, row-major, following the plan.
+         */
+        template<typename C, size_t i, size_t j, typename Tuple>
+        void evaluateChain(const Tuple& operands, typename C::value_type* dst)
+        {
+            using T = typename C::value_type;
+            constexpr size_t k = C::plan.split[i][j];
+            constexpr size_t rows = C::dimensions[i];
+            constexpr size_t inner = C::dimensions[k + 1];
+            constexpr size_t cols = C::dimensions[j + 1];
+
+            expr::Scratch<T, rows * inner> lhsScratch;
+            expr::Scratch<T, inner * cols> rhsScratch;
+            const ChainOperand<T> a = chainOperand<C, i, k>(operands, lhsScratch);
+            const ChainOperand<T> b = chainOperand<C, k + 1, j>(operands, rhsScratch);
+
+            if (a.colStride == 1 && a.rowStride == inner && b.colStride == 1 && b.rowStride == cols)
+                Math::gemmFixed<T, rows, cols, inner>(a.data, b.data, dst);
+            else
+                Math::gemm<T>(rows, cols, inner, T(1), a.data, a.rowStride, a.colStride, b.data, b.rowStride, b.colStride, T(0), dst, cols, 1);
+        }
+    }
+
+    /**
+     * @brief Number of multiply-adds of the cheapest evaluation order of a chain, known at compile time.
+     */
+    template<typename... Operands>
+    constexpr size_t chainCost()
+    {
+        return detail::Chain<Operands...>::plan.cost[0][sizeof...(Operands) - 1];
+    }
+
+    /**
+     * @brief Multiplies a chain of matrices (and vectors) in the order with the fewest multiply-adds.
+     *
+     * The order is found at compile time from the dimensions, no search
+     * happens at run time. Operands may be in any layout, the result is
+     * row-major; it is a myVectorND when the chain ends with a vector.
+     *
+     * @param operands The chain, each operand having as many rows as the previous one has columns.
+     * @return The product of the whole chain.
+     */
+    template<typename... Operands>
+    auto chainMultiply(const Operands&... operands)
+    {
+        using C = detail::Chain<Operands...>;
+        using Result = typename C::result_type;
+
+        if constexpr (C::count == 1)
+        {
+            return Result(operands...);
+        }
+        else
+        {
+            Result result(glg::uninitialized);
+            detail::evaluateChain<C, 0, C::count - 1>(std::forward_as_tuple(operands...), result.data());
+            return result;
+        }
+    }
+};
@@ -0,0 +1,807 @@
+/**
+ * @file myDecomposition.h
+ * @brief Blocked LU (partial pivoting), Cholesky and Householder QR factorizations, with solve, inverse and determinant.
+ * @author Guillaume
+ * @date 18/10/2026
+ *
+ * The factorizations work on factorBlock-wide panels: a panel is factored
+ * with a plain loop, then the rest of the matrix is updated with one
+ * matrix product through Math::gemm. Nearly all the flops of a large
+ * factorization therefore run in the packed GEMM kernel, and the
+ * triangular solves behind solve() and inverse() are blocked the same way.
+ *
+ * The factors are kept in a myDynMatrix, so the classes serve myMatrix,
+ * myDynMatrix and views alike. Math::solve, Math::inverse and
+ * Math::determinant wrap them for the common cases, the 2x2, 3x3 and 4x4
+ * overloads of myTransform.h take over for the smallest matrices.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "myDynMatrix.h"
+#include "myGemm.h"
+#include "myMatrix.h"
+#include "myMatrixView.h"
+#include "myTransform.h"
+#include "myVectorND.h"
+
+namespace Math
+{
+    namespace detail
+    {
+        /** Width of the panels, the trailing updates are products of this depth. */
+        constexpr size_t factorBlock = 64;
+
+        /**
+         * @brief c += alpha * a * b, through gemm.
+         */
+        template<typename T>
+        void gemmUpdate(T alpha, std::type_identity_t<myMatrixView<const T>> a, std::type_identity_t<myMatrixView<const T>> b, std::type_identity_t<myMatrixView<T>> c)
+        {
+            if (c.rows() == 0 || c.cols() == 0 || a.cols() == 0)
+                return;
+
+            gemm<T>(c.rows(), c.cols(), a.cols(), alpha,
+                a.data(), a.rowStride(), a.colStride(),
+                b.data(), b.rowStride(), b.colStride(),
+                T(1), c.data(), c.rowStride(), c.colStride());
+        }
+
+        /**
+         * @brief b = L^-1 * b, L being the lower triangle of l.
+         * @param l Square matrix, only its lower triangle is read.
+         * @param b Right-hand sides, overwritten by the solution.
+         * @param unitDiagonal true if the diagonal of L is made of implicit ones.
+         */
+        template<typename T>
+        void solveLower(std::type_identity_t<myMatrixView<const T>> l, std::type_identity_t<myMatrixView<T>> b, bool unitDiagonal)
+        {
+            const size_t n = l.rows();
+            const size_t cols = b.cols();
+            for (size_t k = 0; k < n; k += factorBlock)
+            {
+                const size_t kb = std::min(factorBlock, n - k);
+                for (size_t i = k; i < k + kb; ++i)
+                {
+                    for (size_t p = k; p < i; ++p)
+                    {
+                        const T factor = l(i, p);
+                        if (factor != T(0))
+                        {
+                            for (size_t c = 0; c < cols; ++c)
+                                b(i, c) -= factor * b(p, c);
+                        }
+                    }
+                    if (!unitDiagonal)
+                    {
+                        const T inverse = T(1) / l(i, i);
+                        for (size_t c = 0; c < cols; ++c)
+                            b(i, c) *= inverse;
+                    }
+                }
+
+                gemmUpdate<T>(T(-1), l.block(k + kb, k, n - k - kb, kb), b.block(k, 0, kb, cols), b.block(k + kb, 0, n - k - kb, cols));
+            }
+        }
+
+        /**
+         * @brief b = U^-1 * b, U being the upper triangle of u.
+         * @param u Square matrix, only its upper triangle and diagonal are read.
+         * @param b Right-hand sides, overwritten by the solution.
+         */
+        template<typename T>
+        void solveUpper(std::type_identity_t<myMatrixView<const T>> u, std::type_identity_t<myMatrixView<T>> b)
+        {
+            const size_t n = u.rows();
+            const size_t cols = b.cols();
+            for (size_t end = n; end > 0;)
+            {
+                const size_t kb = std::min(factorBlock, end);
+                const size_t k = end - kb;
+                for (size_t i = end; i-- > k;)
+                {
+                    for (size_t p = i + 1; p < end; ++p)
+                    {
+                        const T factor = u(i, p);
+                        if (factor != T(0))
+                        {
+                            for (size_t c = 0; c < cols; ++c)
+                                b(i, c) -= factor * b(p, c);
+                        }
+                    }
+                    const T inverse = T(1) / u(i, i);
+                    for (size_t c = 0; c < cols; ++c)
+                        b(i, c) *= inverse;
+                }
+
+                gemmUpdate<T>(T(-1), u.block(0, k, k, kb), b.block(k, 0, kb, cols), b.block(0, 0, k, cols));
+                end = k;
+            }
+        }
+
+        /**
+         * @brief Builds the upper triangular T of the compact WY form H1 H2 ... Hk = I - V T V^T.
+         * @param v Householder vectors, unit lower trapezoidal (the ones and zeros are explicit).
+         * @param tau Scaling factor of every reflector.
+         * @param t kb x kb output, only its upper triangle is written.
+         */
+        template<typename T>
+        void householderTriangle(myMatrixView<const T> v, const T* tau, myMatrixView<T> t)
+        {
+            const size_t kb = v.cols();
+            std::vector<T> w(kb);
+            for (size_t i = 0; i < kb; ++i)
+            {
+                // T(0:i, i) = -tau_i * T(0:i, 0:i) * V(:, 0:i)^T * v_i
+                for (size_t j = 0; j < i; ++j)
+                {
+                    T sum = T(0);
+                    for (size_t r = i; r < v.rows(); ++r)
+                        sum += v(r, j) * v(r, i);
+                    w[j] = sum;
+                }
+                for (size_t j = 0; j < i; ++j)
+                {
+                    T sum = T(0);
+                    for (size_t p = j; p < i; ++p)
+                        sum += t(j, p) * w[p];
+                    t(j, i) = -tau[i] * sum;
+                }
+                t(i, i) = tau[i];
+            }
+        }
+
+        /**
+         * @brief c = H^T * c (or H * c) with H = I - V T V^T: two products through gemm and a small triangular one.
+         * @param v Householder vectors with explicit ones and zeros, rows(c) x kb.
+         * @param t Upper triangular factor from householderTriangle.
+         * @param c Block to update.
+         * @param transposed true to apply H^T, false to apply H.
+         */
+        template<typename T>
+        void applyBlockReflector(myMatrixView<const T> v, myMatrixView<const T> t, myMatrixView<T> c, bool transposed)
+        {
+            const size_t kb = v.cols();
+            if (c.cols() == 0 || kb == 0)
+                return;
+
+            // W = V^T C, then W = T^T W (rewritten from the bottom) or W = T W (from the top), in place
+            myDynMatrix<T> w(kb, c.cols());
+            gemmUpdate<T>(T(1), v.transpose(), c, w.view());
+            for (size_t step = 0; step < kb; ++step)
+            {
+                const size_t i = transposed ? kb - 1 - step : step;
+                const size_t first = transposed ? 0 : i;
+                const size_t last = transposed ? i + 1 : kb;
+                for (size_t col = 0; col < c.cols(); ++col)
+                {
+                    T sum = T(0);
+                    for (size_t p = first; p < last; ++p)
+                        sum += (transposed ? t(p, i) : t(i, p)) * w(p, col);
+                    w(i, col) = sum;
+                }
+            }
+            gemmUpdate<T>(T(-1), v, w.view(), c);
+        }
+    }
+
+    /**
+     * @class LU
+     * @brief P A = L U factorization of a square matrix, with partial pivoting.
+     * @tparam T Floating-point element type.
+     */
+    template<typename T>
+    class LU
+    {
+        static_assert(std::is_floating_point_v<T>, "LU needs a floating-point type");
+
+    public:
+        /**
+         * @brief Factors a copy of matrix.
+         * @throw std::invalid_argument if matrix is not square.
+         */
+        explicit LU(myMatrixView<const T> matrix) : LU(myDynMatrix<T>(matrix)) {}
+
+        /**
+         * @brief Factors matrix in its own storage.
+         * @throw std::invalid_argument if matrix is not square.
+         */
+        explicit LU(myDynMatrix<T>&& matrix) : m_factors(std::move(matrix))
+        {
+            if (m_factors.rows() != m_factors.cols())
+                throw std::invalid_argument("matrix must be square");
+
+            decompose();
+        }
+
+        /**
+         * @brief Solves A X = B.
+         * @param rhs B, with as many rows as A.
+         * @return X.
+         * @throw std::invalid_argument if the number of rows differs.
+         * @throw std::runtime_error if A is singular.
+         */
+        myDynMatrix<T> solve(myMatrixView<const T> rhs) const
+        {
+            myDynMatrix<T> result(rhs);
+            solveInPlace(result.view());
+            return result;
+        }
+
+        /**
+         * @brief Solves A X = B, B is overwritten by X.
+         * @throw std::invalid_argument if the number of rows differs.
+         * @throw std::runtime_error if A is singular.
+         */
+        void solveInPlace(myMatrixView<T> rhs) const
+        {
+            if (rhs.rows() != size())
+                throw std::invalid_argument("size must be equal");
+            if (m_singular)
+                throw std::runtime_error("matrix is singular");
+
+            for (size_t i = 0; i < size(); ++i)
+            {
+                if (m_pivots[i] != i)
+                {
+                    for (size_t c = 0; c < rhs.cols(); ++c)
+                        std::swap(rhs(i, c), rhs(m_pivots[i], c));
+                }
+            }
+            detail::solveLower<T>(m_factors.view(), rhs, true);
+            detail::solveUpper<T>(m_factors.view(), rhs);
+        }
+
+        /**
+         * @brief A^-1, by solving A X = I.
+         * @throw std::runtime_error if A is singular.
+         */
+        myDynMatrix<T> inverse() const
+        {
+            myDynMatrix<T> result(size(), size());
+            for (size_t i = 0; i < size(); ++i)
+                result(i, i) = T(1);
+
+            solveInPlace(result.view());
+            return result;
+        }
+
+        /**
+         * @brief det(A), the product of the pivots with the sign of the permutation.
+         */
+        T determinant() const
+        {
+            T result = m_sign;
+            for (size_t i = 0; i < size(); ++i)
+                result *= m_factors(i, i);
+            return result;
+        }
+
+        bool isSingular() const
+        {
+            return m_singular;
+        }
+
+        size_t size() const
+        {
+            return m_factors.rows();
+        }
+
+        /**
+         * @brief L (below the diagonal, unit diagonal implied) and U (diagonal and above) packed together.
+         */
+        const myDynMatrix<T>& factors() const
+        {
+            return m_factors;
+        }
+
+        /**
+         * @brief Row i was swapped with row pivots()[i] at step i.
+         */
+        const std::vector<size_t>& pivots() const
+        {
+            return m_pivots;
+        }
+
+    private:
+        void decompose()
+        {
+            const size_t n = size();
+            auto a = m_factors.view();
+            m_pivots.resize(n);
+
+            for (size_t k = 0; k < n; k += detail::factorBlock)
+            {
+                const size_t kb = std::min(detail::factorBlock, n - k);
+
+                // Panel: columns k..k+kb, every row swap covers the whole row so the left and right parts follow
+                for (size_t j = k; j < k + kb; ++j)
+                {
+                    size_t pivot = j;
+                    for (size_t r = j + 1; r < n; ++r)
+                    {
+                        if (std::abs(a(r, j)) > std::abs(a(pivot, j)))
+                            pivot = r;
+                    }
+                    m_pivots[j] = pivot;
+                    if (pivot != j)
+                    {
+                        std::swap_ranges(&a(j, 0), &a(j, 0) + n, &a(pivot, 0));
+                        m_sign = -m_sign;
+                    }
+
+                    const T diagonal = a(j, j);
+                    if (diagonal == T(0))
+                    {
+                        m_singular = true;
+                        continue;
+                    }
+
+                    const T inverse = T(1) / diagonal;
+                    for (size_t r = j + 1; r < n; ++r)
+                    {
+                        const T factor = a(r, j) *= inverse;
+                        for (size_t c = j + 1; c < k + kb; ++c)
+                            a(r, c) -= factor * a(j, c);
+                    }
+                }
+
+                // U12 = L11^-1 A12, then A22 -= L21 U12
+                const size_t rest = n - k - kb;
+                detail::solveLower<T>(a.block(k, k, kb, kb), a.block(k, k + kb, kb, rest), true);
+                detail::gemmUpdate<T>(T(-1), a.block(k + kb, k, rest, kb), a.block(k, k + kb, kb, rest), a.block(k + kb, k + kb, rest, rest));
+            }
+        }
+
+        myDynMatrix<T> m_factors;       ///< L and U packed
+        std::vector<size_t> m_pivots;   ///< Row interchanges
+        T m_sign = T(1);                ///< Sign of the permutation
+        bool m_singular = false;        ///< An exact zero pivot was met
+    };
+
+    /**
+     * @class Cholesky
+     * @brief A = L L^T factorization of a symmetric positive definite matrix.
+     * @tparam T Floating-point element type.
+     */
+    template<typename T>
+    class Cholesky
+    {
+        static_assert(std::is_floating_point_v<T>, "Cholesky needs a floating-point type");
+
+    public:
+        /**
+         * @brief Factors a copy of matrix, only its lower triangle is read.
+         * @throw std::invalid_argument if matrix is not square.
+         * @throw std::runtime_error if matrix is not positive definite.
+         */
+        explicit Cholesky(myMatrixView<const T> matrix) : Cholesky(myDynMatrix<T>(matrix)) {}
+
+        explicit Cholesky(myDynMatrix<T>&& matrix) : m_factor(std::move(matrix))
+        {
+            if (m_factor.rows() != m_factor.cols())
+                throw std::invalid_argument("matrix must be square");
+
+            decompose();
+        }
+
+        /**
+         * @brief Solves A X = B.
+         * @throw std::invalid_argument if the number of rows differs.
+         */
+        myDynMatrix<T> solve(myMatrixView<const T> rhs) const
+        {
+            myDynMatrix<T> result(rhs);
+            solveInPlace(result.view());
+            return result;
+        }
+
+        void solveInPlace(myMatrixView<T> rhs) const
+        {
+            if (rhs.rows() != size())
+                throw std::invalid_argument("size must be equal");
+
+            detail::solveLower<T>(m_factor.view(), rhs, false);
+            detail::solveUpper<T>(m_factor.view().transpose(), rhs);
+        }
+
+        myDynMatrix<T> inverse() const
+        {
+            myDynMatrix<T> result(size(), size());
+            for (size_t i = 0; i < size(); ++i)
+                result(i, i) = T(1);
+
+            solveInPlace(result.view());
+            return result;
+        }
+
+        /**
+         * @brief det(A), the squared product of the diagonal of L.
+         */
+        T determinant() const
+        {
+            T result = T(1);
+            for (size_t i = 0; i < size(); ++i)
+                result *= m_factor(i, i);
+            return result * result;
+        }
+
+        size_t size() const
+        {
+            return m_factor.rows();
+        }
+
+        /**
+         * @brief L, the upper triangle is zero.
+         */
+        const myDynMatrix<T>& factor() const
+        {
+            return m_factor;
+        }
+
+    private:
+        void decompose()
+        {
+            const size_t n = size();
+            auto a = m_factor.view();
+
+            for (size_t k = 0; k < n; k += detail::factorBlock)
+            {
+                const size_t kb = std::min(detail::factorBlock, n - k);
+                const size_t rest = n - k - kb;
+
+                // L11 = chol(A11)
+                for (size_t j = k; j < k + kb; ++j)
+                {
+                    T diagonal = a(j, j);
+                    for (size_t p = k; p < j; ++p)
+                        diagonal -= a(j, p) * a(j, p);
+                    if (!(diagonal > T(0)))
+                        throw std::runtime_error("matrix is not positive definite");
+
+                    diagonal = std::sqrt(diagonal);
+                    a(j, j) = diagonal;
+                    for (size_t r = j + 1; r < k + kb; ++r)
+                    {
+                        T sum = a(r, j);
+                        for (size_t p = k; p < j; ++p)
+                            sum -= a(r, p) * a(j, p);
+                        a(r, j) = sum / diagonal;
+                    }
+                }
+
+                // L21 = A21 L11^-T, i.e. L21^T = L11^-1 A21^T
+                const auto l21 = a.block(k + kb, k, rest, kb);
+                detail::solveLower<T>(a.block(k, k, kb, kb), l21.transpose(), false);
+
+                // A22 -= L21 L21^T, one block column at a time so only the lower triangle is computed
+                for (size_t j = 0; j < rest; j += detail::factorBlock)
+                {
+                    const size_t jb = std::min(detail::factorBlock, rest - j);
+                    detail::gemmUpdate<T>(T(-1), l21.block(j, 0, rest - j, kb), l21.block(j, 0, jb, kb).transpose(),
+                        a.block(k + kb + j, k + kb + j, rest - j, jb));
+                }
+            }
+
+            for (size_t r = 0; r < n; ++r)
+            {
+                for (size_t c = r + 1; c < n; ++c)
+                    a(r, c) = T(0);
+            }
+        }
+
+        myDynMatrix<T> m_factor; ///< L
+    };
+
+    /**
+     * @class QR
+     * @brief A = Q R factorization by Householder reflections, applied in blocks (compact WY form).
+     *
+     * A is rows x cols, Q is an orthogonal rows x rows matrix stored as
+     * min(rows, cols) reflectors below the diagonal of the factors, R is the
+     * upper triangle. solve() returns the least-squares solution when A has
+     * more rows than columns.
+     *
+     * @tparam T Floating-point element type.
+     */
+    template<typename T>
+    class QR
+    {
+        static_assert(std::is_floating_point_v<T>, "QR needs a floating-point type");
+
+    public:
+        explicit QR(myMatrixView<const T> matrix) : QR(myDynMatrix<T>(matrix)) {}
+
+        explicit QR(myDynMatrix<T>&& matrix) : m_factors(std::move(matrix)), m_tau(std::min(m_factors.rows(), m_factors.cols()))
+        {
+            decompose();
+        }
+
+        /**
+         * @brief Computes Q^T B, B is overwritten.
+         * @throw std::invalid_argument if B does not have rows() rows.
+         */
+        void applyQTranspose(myMatrixView<T> rhs) const
+        {
+            if (rhs.rows() != rows())
+                throw std::invalid_argument("size must be equal");
+
+            const size_t k = m_tau.size();
+            for (size_t p = 0; p < k; p += detail::factorBlock)
+            {
+                const size_t pb = std::min(detail::factorBlock, k - p);
+                const myDynMatrix<T> v = reflectors(p, pb);
+                myDynMatrix<T> t(pb, pb);
+                detail::householderTriangle<T>(v.view(), m_tau.data() + p, t.view());
+                detail::applyBlockReflector<T>(v.view(), t.view(), rhs.block(p, 0, rows() - p, rhs.cols()), true);
+            }
+        }
+
+        /**
+         * @brief Solves A X = B, in the least-squares sense when rows() > cols().
+         * @return cols() x B.cols() solution.
+         * @throw std::invalid_argument if rows() < cols() or B does not have rows() rows.
+         * @throw std::runtime_error if A does not have full column rank.
+         */
+        myDynMatrix<T> solve(myMatrixView<const T> rhs) const
+        {
+            if (rows() < cols())
+                throw std::invalid_argument("system is underdetermined");
+
+            myDynMatrix<T> work(rhs);
+            applyQTranspose(work.view());
+            for (size_t i = 0; i < cols(); ++i)
+            {
+                if (m_factors(i, i) == T(0))
+                    throw std::runtime_error("matrix is rank deficient");
+            }
+
+            myDynMatrix<T> result(work.view().block(0, 0, cols(), rhs.cols()));
+            detail::solveUpper<T>(m_factors.view().block(0, 0, cols(), cols()), result.view());
+            return result;
+        }
+
+        /**
+         * @brief det(A) for a square matrix: every non-trivial reflector flips the sign.
+         * @throw std::invalid_argument if A is not square.
+         */
+        T determinant() const
+        {
+            if (rows() != cols())
+                throw std::invalid_argument("matrix must be square");
+
+            T result = T(1);
+            for (size_t i = 0; i < rows(); ++i)
+                result *= m_tau[i] != T(0) ? -m_factors(i, i) : m_factors(i, i);
+            return result;
+        }
+
+        /**
+         * @brief The rows x rows orthogonal factor, built by applying the reflectors to the identity.
+         */
+        myDynMatrix<T> Q() const
+        {
+            // Q = H1 ... Hk I: the blocks are applied in reverse order with H instead of H^T
+            myDynMatrix<T> result(rows(), rows());
+            for (size_t i = 0; i < rows(); ++i)
+                result(i, i) = T(1);
+
+            const size_t k = m_tau.size();
+            for (size_t end = k; end > 0;)
+            {
+                const size_t pb = (end - 1) % detail::factorBlock + 1;
+                const size_t p = end - pb;
+                const myDynMatrix<T> v = reflectors(p, pb);
+                myDynMatrix<T> t(pb, pb);
+                detail::householderTriangle<T>(v.view(), m_tau.data() + p, t.view());
+                detail::applyBlockReflector<T>(v.view(), t.view(), result.view().block(p, 0, rows() - p, rows()), false);
+                end = p;
+            }
+            return result;
+        }
+
+        /**
+         * @brief The rows x cols upper trapezoidal factor.
+         */
+        myDynMatrix<T> R() const
+        {
+            myDynMatrix<T> result(rows(), cols());
+            for (size_t r = 0; r < rows(); ++r)
+            {
+                for (size_t c = r; c < cols(); ++c)
+                    result(r, c) = m_factors(r, c);
+            }
+            return result;
+        }
+
+        size_t rows() const
+        {
+            return m_factors.rows();
+        }
+
+        size_t cols() const
+        {
+            return m_factors.cols();
+        }
+
+        /**
+         * @brief R on and above the diagonal, the Householder vectors below it (their leading one is implied).
+         */
+        const myDynMatrix<T>& factors() const
+        {
+            return m_factors;
+        }
+
+        const std::vector<T>& tau() const
+        {
+            return m_tau;
+        }
+
+    private:
+        /**
+         * @brief Copies the reflectors p..p+pb into a (rows - p) x pb matrix with explicit ones and zeros.
+         */
+        myDynMatrix<T> reflectors(size_t p, size_t pb) const
+        {
+            myDynMatrix<T> v(rows() - p, pb);
+            for (size_t j = 0; j < pb; ++j)
+            {
+                v(j, j) = T(1);
+                for (size_t r = j + 1; r < rows() - p; ++r)
+                    v(r, j) = m_factors(p + r, p + j);
+            }
+            return v;
+        }
+
+        void decompose()
+        {
+            const size_t m = rows();
+            const size_t n = cols();
+            const size_t k = m_tau.size();
+            auto a = m_factors.view();
+
+            for (size_t p = 0; p < k; p += detail::factorBlock)
+            {
+                const size_t pb = std::min(detail::factorBlock, k - p);
+
+                // Panel: one reflector per column, applied to the remaining columns of the panel only
+                for (size_t j = p; j < p + pb; ++j)
+                {
+                    T norm = T(0);
+                    for (size_t r = j + 1; r < m; ++r)
+                        norm += a(r, j) * a(r, j);
+
+                    const T alpha = a(j, j);
+                    if (norm == T(0))
+                    {
+                        m_tau[j] = T(0);
+                        continue;
+                    }
+
+                    const T beta = alpha > T(0) ? -std::sqrt(alpha * alpha + norm) : std::sqrt(alpha * alpha + norm);
+                    m_tau[j] = (beta - alpha) / beta;
+                    const T scale = T(1) / (alpha - beta);
+                    for (size_t r = j + 1; r < m; ++r)
+                        a(r, j) *= scale;
+                    a(j, j) = beta;
+
+                    for (size_t c = j + 1; c < p + pb; ++c)
+                    {
+                        T dot = a(j, c);
+                        for (size_t r = j + 1; r < m; ++r)
+                            dot += a(r, j) * a(r, c);
+                        dot *= m_tau[j];
+                        a(j, c) -= dot;
+                        for (size_t r = j + 1; r < m; ++r)
+                            a(r, c) -= dot * a(r, j);
+                    }
+                }
+
+                // Trailing columns: C = (I - V T V^T)^T C
+                if (p + pb < n)
+                {
+                    const myDynMatrix<T> v = reflectors(p, pb);
+                    myDynMatrix<T> t(pb, pb);
+                    detail::householderTriangle<T>(v.view(), m_tau.data() + p, t.view());
+                    detail::applyBlockReflector<T>(v.view(), t.view(), a.block(p, p + pb, m - p, n - p - pb), true);
+                }
+            }
+        }
+
+        myDynMatrix<T> m_factors; ///< R and the Householder vectors
+        std::vector<T> m_tau;     ///< Scaling factor of every reflector
+    };
+
+    template<typename T, size_t height, size_t width>
+    LU(const myMatrix<T, height, width>&) -> LU<T>;
+    template<typename T>
+    LU(const myDynMatrix<T>&) -> LU<T>;
+    template<typename T>
+    LU(myMatrixView<T>) -> LU<std::remove_const_t<T>>;
+
+    template<typename T, size_t height, size_t width>
+    Cholesky(const myMatrix<T, height, width>&) -> Cholesky<T>;
+    template<typename T>
+    Cholesky(const myDynMatrix<T>&) -> Cholesky<T>;
+    template<typename T>
+    Cholesky(myMatrixView<T>) -> Cholesky<std::remove_const_t<T>>;
+
+    template<typename T, size_t height, size_t width>
+    QR(const myMatrix<T, height, width>&) -> QR<T>;
+    template<typename T>
+    QR(const myDynMatrix<T>&) -> QR<T>;
+    template<typename T>
+    QR(myMatrixView<T>) -> QR<std::remove_const_t<T>>;
+
+    /**
+     * @brief Solves A x = b through an LU factorization.
+     * @throw std::runtime_error if A is singular.
+     */
+    template<typename T, size_t N>
+    myVectorND<T, N> solve(const myMatrix<T, N, N>& matrix, const myVectorND<T, N>& rhs)
+    {
+        myVectorND<T, N> result(rhs);
+        LU<T>(matrix).solveInPlace(myMatrixView<T>(result.data(), N, 1, 1));
+        return result;
+    }
+
+    /**
+     * @brief Solves A X = B through an LU factorization.
+     * @throw std::runtime_error if A is singular.
+     */
+    template<typename T, size_t N, size_t K>
+    myMatrix<T, N, K> solve(const myMatrix<T, N, N>& matrix, const myMatrix<T, N, K>& rhs)
+    {
+        myMatrix<T, N, K> result(rhs);
+        LU<T>(matrix).solveInPlace(result);
+        return result;
+    }
+
+    /**
+     * @brief Solves A X = B through an LU factorization.
+     * @throw std::invalid_argument if A is not square or the number of rows differs.
+     * @throw std::runtime_error if A is singular.
+     */
+    template<typename T>
+    myDynMatrix<T> solve(const myDynMatrix<T>& matrix, const myDynMatrix<T>& rhs)
+    {
+        return LU<T>(matrix).solve(rhs);
+    }
+
+    /**
+     * @brief A^-1 through an LU factorization.
+     * @throw std::runtime_error if A is singular.
+     */
+    template<typename T, size_t N>
+    myMatrix<T, N, N> inverse(const myMatrix<T, N, N>& matrix)
+    {
+        return LU<T>(matrix).inverse().template toMatrix<N, N>();
+    }
+
+    template<typename T>
+    myDynMatrix<T> inverse(const myDynMatrix<T>& matrix)
+    {
+        return LU<T>(matrix).inverse();
+    }
+
+    /**
+     * @brief det(A) through an LU factorization, O(N^3) instead of the O(N!) cofactor expansion.
+     */
+    template<typename T, size_t N>
+    T determinant(const myMatrix<T, N, N>& matrix)
+    {
+        return LU<T>(matrix).determinant();
+    }
+
+    template<typename T>
+    T determinant(const myDynMatrix<T>& matrix)
+    {
+        return LU<T>(matrix).determinant();
+    }
+};
@@ -0,0 +1,497 @@
+/**
+ * @file myDynMatrix.h
+ * @brief Implementation of a matrix whose dimensions are chosen at runtime.
+ * @author Guillaume
+ * @date 18/10/2026
+ */
+
+#pragma once
+#include <initializer_list>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "helper.h"
+#include "myGemm.h"
+#include "myMatrix.h"
+#include "myMatrixView.h"
+#include "myTranspose.h"
+
+namespace glg
+{
+    template<typename M>
+    struct isRuntimeMatrix : std::false_type {};
+
+    template<typename T>
+    struct isRuntimeMatrix<myDynMatrix<T>> : std::true_type {};
+
+    template<typename T>
+    struct isRuntimeMatrix<myMatrixView<T>> : std::true_type {};
+
+    /**
+     * @brief Operand of the runtime-sized operators: a myDynMatrix or a myMatrixView.
+     *
+     * The operators below accept any mix of matrix types as long as one side is
+     * runtime-sized, the product of two myMatrix keeps its fixed-size operator.
+     */
+    template<typename M>
+    concept RuntimeMatrixOperand = isRuntimeMatrix<std::remove_cvref_t<M>>::value;
+
+    template<typename M>
+    using matrixValueType = typename decltype(glg::viewOf(std::declval<M&>()))::value_type;
+
+    namespace detail
+    {
+        /**
+         * @brief Copies src into dst, both views having the same shape.
+         */
+        template<typename T>
+        void copyMatrix(myMatrixView<const T> src, myMatrixView<T> dst)
+        {
+            // A transposed view of row-major storage is materialised by the blocked transpose
+            if (!src.isRowContiguous() && src.rowStride() == 1 && dst.isRowContiguous())
+            {
+                Math::transpose(src.data(), src.colStride(), dst.data(), dst.rowStride(), src.cols(), src.rows());
+                return;
+            }
+
+            for (size_t i = 0; i < src.rows(); ++i)
+            {
+                if (src.isRowContiguous() && dst.isRowContiguous())
+                {
+                    const T* first = &src(i, 0);
+                    glg::copy(first, first + src.cols(), &dst(i, 0));
+                }
+                else
+                {
+                    for (size_t j = 0; j < src.cols(); ++j)
+                        dst(i, j) = src(i, j);
+                }
+            }
+        }
+
+        template<typename T>
+        void checkSameShape(const myMatrixView<const T>& lhs, const myMatrixView<const T>& rhs)
+        {
+            if (lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols())
+                throw std::invalid_argument("size must be equal");
+        }
+
+        /**
+         * @brief result(i, j) = op(lhs(i, j), rhs(i, j)), rows with unit column stride run as plain loops.
+         */
+        template<typename T, typename Op>
+        myDynMatrix<T> elementWise(myMatrixView<const T> lhs, myMatrixView<const T> rhs, Op op)
+        {
+            checkSameShape(lhs, rhs);
+
+            myDynMatrix<T> result(lhs.rows(), lhs.cols());
+            const bool contiguous = lhs.isRowContiguous() && rhs.isRowContiguous();
+            for (size_t i = 0; i < lhs.rows(); ++i)
+            {
+                T* out = &result(i, 0);
+                if (contiguous)
+                {
+                    const T* a = &lhs(i, 0);
+                    const T* b = &rhs(i, 0);
+                    for (size_t j = 0; j < lhs.cols(); ++j)
+                        out[j] = op(a[j], b[j]);
+                }
+                else
+                {
+                    for (size_t j = 0; j < lhs.cols(); ++j)
+                        out[j] = op(lhs(i, j), rhs(i, j));
+                }
+            }
+            return result;
+        }
+    }
+};
+
+/**
+ * @struct myDynMatrix
+ * @brief Row-major heap matrix, element (r, c) lives at data()[r * stride() + c].
+ *
+ * The runtime counterpart of myMatrix: the shape is only known at runtime and
+ * the storage is on the heap, so it fits matrices too large for the stack.
+ * row(), col(), block() and transpose() return zero-copy myMatrixView that
+ * can be passed to every kernel taking a view.
+ *
+ * @tparam T Element type.
+ */
+template<typename T>
+struct myDynMatrix
+{
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using view_type = myMatrixView<T>;
+    using const_view_type = myMatrixView<const T>;
+
+    /**
+     * @brief Default constructor, an empty 0 x 0 matrix.
+     */
+    myDynMatrix() : m_data(nullptr), m_rows(0), m_cols(0), m_stride(0) {}
+
+    /**
+     * @brief Constructor of a rows x cols matrix filled with value-initialised elements.
+     * @param rows Number of rows.
+     * @param cols Number of columns.
+     */
+    myDynMatrix(size_t rows, size_t cols)
+        : m_data(rows != 0 && cols != 0 ? new T[rows * cols]() : nullptr), m_rows(rows), m_cols(cols), m_stride(cols) {}
+
+    /**
+     * @brief Constructor of a rows x cols matrix filled with value.
+     * @param rows Number of rows.
+     * @param cols Number of columns.
+     * @param value Value of every element.
+     */
+    myDynMatrix(size_t rows, size_t cols, const T& value) : myDynMatrix(rows, cols)
+    {
+        glg::fill(m_data, m_data + Size(), value);
+    }
+
+    /**
+     * @brief Constructor from row-major values, missing values are value-initialised.
+     * @param rows Number of rows.
+     * @param cols Number of columns.
+     * @param list Values in row-major order.
+     * @throw std::runtime_error if list holds more than rows * cols values.
+     */
+    myDynMatrix(size_t rows, size_t cols, std::initializer_list<T> list) : myDynMatrix(rows, cols)
+    {
+        if (list.size() > Size())
+            throw std::runtime_error("Out of Range");
+
+        glg::copy(list.begin(), list.end(), m_data);
+    }
+
+    /**
+     * @brief Copy of a fixed-size matrix, in any layout.
+     * @param matrix The matrix to copy.
+     */
+    template<size_t height, size_t width, typename layout>
+    explicit myDynMatrix(const myMatrix<T, height, width, layout>& matrix) : myDynMatrix(height, width)
+    {
+        Math::relayout<layout, glg::RowMajor>(matrix.data(), m_data, height, width);
+    }
+
+    /**
+     * @brief Copy of the elements seen through a view (a block, a transposed view...).
+     * @param view The view to materialise.
+     */
+    explicit myDynMatrix(const_view_type view) : myDynMatrix(view.rows(), view.cols())
+    {
+        glg::detail::copyMatrix(view, this->view());
+    }
+
+    myDynMatrix(const myDynMatrix& other) : myDynMatrix(other.m_rows, other.m_cols)
+    {
+        glg::detail::copyMatrix(other.view(), view());
+    }
+
+    myDynMatrix(myDynMatrix&& other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr)), m_rows(std::exchange(other.m_rows, 0)),
+          m_cols(std::exchange(other.m_cols, 0)), m_stride(std::exchange(other.m_stride, 0)) {}
+
+    myDynMatrix& operator=(const myDynMatrix& other)
+    {
+        if (this != &other)
+        {
+            if (m_rows != other.m_rows || m_cols != other.m_cols)
+                myDynMatrix(other.m_rows, other.m_cols).swap(*this);
+            glg::detail::copyMatrix(other.view(), view());
+        }
+        return *this;
+    }
+
+    myDynMatrix& operator=(myDynMatrix&& other) noexcept
+    {
+        myDynMatrix(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    ~myDynMatrix()
+    {
+        delete[] m_data;
+    }
+
+    void swap(myDynMatrix& other) noexcept
+    {
+        std::swap(m_data, other.m_data);
+        std::swap(m_rows, other.m_rows);
+        std::swap(m_cols, other.m_cols);
+        std::swap(m_stride, other.m_stride);
+    }
+
+    /**
+     * @brief Changes the shape, the content is discarded and value-initialised.
+     * @param rows Number of rows.
+     * @param cols Number of columns.
+     */
+    void resize(size_t rows, size_t cols)
+    {
+        myDynMatrix(rows, cols).swap(*this);
+    }
+
+    reference operator()(size_t row, size_t col)
+    {
+        return m_data[row * m_stride + col];
+    }
+
+    const_reference operator()(size_t row, size_t col) const
+    {
+        return m_data[row * m_stride + col];
+    }
+
+    reference getCell(size_t row, size_t col)
+    {
+        if (row >= m_rows || col >= m_cols)
+            throw std::out_of_range("Out of Range");
+        return (*this)(row, col);
+    }
+
+    const_reference getCell(size_t row, size_t col) const
+    {
+        if (row >= m_rows || col >= m_cols)
+            throw std::out_of_range("Out of Range");
+        return (*this)(row, col);
+    }
+
+    view_type view()
+    {
+        return view_type(m_data, m_rows, m_cols, m_stride, 1);
+    }
+
+    const_view_type view() const
+    {
+        return const_view_type(m_data, m_rows, m_cols, m_stride, 1);
+    }
+
+    view_type row(size_t row)
+    {
+        return view().row(row);
+    }
+
+    const_view_type row(size_t row) const
+    {
+        return view().row(row);
+    }
+
+    view_type col(size_t col)
+    {
+        return view().col(col);
+    }
+
+    const_view_type col(size_t col) const
+    {
+        return view().col(col);
+    }
+
+    view_type block(size_t row, size_t col, size_t height, size_t width)
+    {
+        return view().block(row, col, height, width);
+    }
+
+    const_view_type block(size_t row, size_t col, size_t height, size_t width) const
+    {
+        return view().block(row, col, height, width);
+    }
+
+    /**
+     * @brief Transposed view, nothing is copied. Construct a myDynMatrix from it to materialise it.
+     */
+    view_type transpose()
+    {
+        return view().transpose();
+    }
+
+    const_view_type transpose() const
+    {
+        return view().transpose();
+    }
+
+    /**
+     * @brief Transposes the matrix, in place when it is square.
+     */
+    void transposeInPlace()
+    {
+        if (m_rows == m_cols)
+            Math::transposeInPlace(m_data, m_stride, m_rows);
+        else
+            myDynMatrix(transpose()).swap(*this);
+    }
+
+    /**
+     * @brief Copy to a fixed-size matrix.
+     * @tparam layout The layout of the copy, row-major by default.
+     * @return The height x width copy.
+     * @throw std::invalid_argument if the shapes differ.
+     */
+    template<size_t height, size_t width, typename layout = glg::RowMajor>
+    myMatrix<T, height, width, layout> toMatrix() const
+    {
+        if (m_rows != height || m_cols != width)
+            throw std::invalid_argument("size must be equal");
+
+        myMatrix<T, height, width, layout> result(glg::uninitialized);
+        Math::relayout<glg::RowMajor, layout>(m_data, result.data(), height, width);
+        return result;
+    }
+
+    pointer data()
+    {
+        return m_data;
+    }
+
+    const_pointer data() const
+    {
+        return m_data;
+    }
+
+    size_t rows() const
+    {
+        return m_rows;
+    }
+
+    size_t cols() const
+    {
+        return m_cols;
+    }
+
+    /**
+     * @brief Leading dimension, the distance between two rows in elements.
+     */
+    size_t stride() const
+    {
+        return m_stride;
+    }
+
+    size_t Size() const
+    {
+        return m_rows * m_cols;
+    }
+
+    bool Empty() const
+    {
+        return Size() == 0;
+    }
+
+    myDynMatrix operator*(const T& scalar) const
+    {
+        myDynMatrix result(*this);
+        for (size_t i = 0; i < Size(); ++i)
+            result.m_data[i] *= scalar;
+        return result;
+    }
+
+    myDynMatrix operator/(const T& scalar) const
+    {
+        if (scalar == T(0))
+            throw std::runtime_error("cannot divide by 0");
+
+        myDynMatrix result(*this);
+        for (size_t i = 0; i < Size(); ++i)
+            result.m_data[i] /= scalar;
+        return result;
+    }
+
+private:
+    pointer m_data;   ///< Row-major elements, owned
+    size_t m_rows;    ///< Number of rows
+    size_t m_cols;    ///< Number of columns
+    size_t m_stride;  ///< Distance between two rows, in elements
+};
+
+template<typename T>
+std::ostream& operator<<(std::ostream& os, const myDynMatrix<T>& matrix)
+{
+    return os << matrix.view();
+}
+
+
+/**
+ * @brief Matrix product, at least one operand being a myDynMatrix or a myMatrixView.
+ *
+ * The strides of both operands go straight to Math::gemm, so multiplying by a
+ * transposed view or a block does not copy it first.
+ *
+ * @param lhs Left operand, rows x inner.
+ * @param rhs Right operand, inner x cols.
+ * @return The rows x cols product.
+ * @throw std::invalid_argument if the inner dimensions differ.
+ */
+template<glg::MatrixOperand L, glg::MatrixOperand R>
+    requires (glg::RuntimeMatrixOperand<L> || glg::RuntimeMatrixOperand<R>)
+myDynMatrix<glg::matrixValueType<L>> operator*(const L& lhs, const R& rhs)
+{
+    using T = glg::matrixValueType<L>;
+    static_assert(std::is_same_v<T, glg::matrixValueType<R>>, "operands must have the same element type");
+
+    const myMatrixView<const T> a = glg::viewOf(lhs);
+    const myMatrixView<const T> b = glg::viewOf(rhs);
+    if (a.cols() != b.rows())
+        throw std::invalid_argument("inner dimensions must be equal");
+
+    myDynMatrix<T> result(a.rows(), b.cols());
+    Math::gemm<T>(a.rows(), b.cols(), a.cols(), T(1),
+        a.data(), a.rowStride(), a.colStride(),
+        b.data(), b.rowStride(), b.colStride(),
+        T(0), result.data(), result.stride(), 1);
+    return result;
+}
+
+/**
+ * @brief Element-wise sum, at least one operand being a myDynMatrix or a myMatrixView.
+ * @throw std::invalid_argument if the shapes differ.
+ */
+template<glg::MatrixOperand L, glg::MatrixOperand R>
+    requires (glg::RuntimeMatrixOperand<L> || glg::RuntimeMatrixOperand<R>)
+myDynMatrix<glg::matrixValueType<L>> operator+(const L& lhs, const R& rhs)
+{
+    using T = glg::matrixValueType<L>;
+    return glg::detail::elementWise<T>(glg::viewOf(lhs), glg::viewOf(rhs), [](const T& a, const T& b) { return a + b; });
+}
+
+/**
+ * @brief Element-wise difference lhs - rhs, at least one operand being a myDynMatrix or a myMatrixView.
+ * @throw std::invalid_argument if the shapes differ.
+ */
+template<glg::MatrixOperand L, glg::MatrixOperand R>
+    requires (glg::RuntimeMatrixOperand<L> || glg::RuntimeMatrixOperand<R>)
+myDynMatrix<glg::matrixValueType<L>> operator-(const L& lhs, const R& rhs)
+{
+    using T = glg::matrixValueType<L>;
+    return glg::detail::elementWise<T>(glg::viewOf(lhs), glg::viewOf(rhs), [](const T& a, const T& b) { return a - b; });
+}
+
+template<glg::MatrixOperand L, glg::MatrixOperand R>
+    requires (glg::RuntimeMatrixOperand<L> || glg::RuntimeMatrixOperand<R>)
+bool operator==(const L& lhs, const R& rhs)
+{
+    using T = glg::matrixValueType<L>;
+    const myMatrixView<const T> a = glg::viewOf(lhs);
+    const myMatrixView<const T> b = glg::viewOf(rhs);
+    if (a.rows() != b.rows() || a.cols() != b.cols())
+        return false;
+
+    for (size_t i = 0; i < a.rows(); ++i)
+    {
+        for (size_t j = 0; j < a.cols(); ++j)
+        {
+            if (a(i, j) != b(i, j))
+                return false;
+        }
+    }
+    return true;
+}
+
+template<glg::MatrixOperand L, glg::MatrixOperand R>
+    requires (glg::RuntimeMatrixOperand<L> || glg::RuntimeMatrixOperand<R>)
+bool operator!=(const L& lhs, const R& rhs)
+{
+    return !(lhs == rhs);
+}
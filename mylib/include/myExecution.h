@@ -0,0 +1,571 @@
+/**
+ * @file myExecution.h
+ * @brief Implementation of the glg::execution policies and of the transform, for_each, reduce, transform_reduce,
+ * fill and copy overloads taking one.
+ * @author Guillaume
+ * @date 18/10/2026
+ *
+ * glg::execution::seq runs the serial algorithm of helper.h. par and
+ * par_unseq split the range into a few blocks per thread of a
+ * glg::ThreadPool, the global pool unless the policy is bound to another
+ * one with on(). Every block boundary but the first falls on a 64-byte cache
+ * line of the range being written, so two threads never write the same line.
+ * A reduction keeps one partial result per block, each on its own cache
+ * line, and combines them in order on the calling thread.
+ *
+ * par_unseq also lets a reduction run eight interleaved accumulators, which
+ * the compiler turns into vector code. The operation must then be
+ * associative and commutative, as for the parallel reductions anyway.
+ *
+ * Ranges shorter than 32K elements, ranges without random access and
+ * single-thread pools fall back to the serial algorithm. An exception thrown
+ * by a block is rethrown to the caller once every block is done.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "helper.h"
+#include "myThreadPool.h"
+
+namespace glg
+{
+    namespace execution
+    {
+        /**
+         * @struct sequenced_policy
+         * @brief Runs the algorithm on the calling thread, in order.
+         */
+        struct sequenced_policy
+        {
+        };
+
+        /**
+         * @struct parallel_policy
+         * @brief Runs the algorithm on the threads of a pool.
+         */
+        struct parallel_policy
+        {
+            ThreadPool* pool = nullptr; ///< Threads running the algorithm, the global pool when null
+
+            /**
+             * @brief Returns the same policy running on other threads.
+             * @param threads The pool to run on.
+             * @return parallel_policy bound to threads.
+             */
+            parallel_policy on(ThreadPool& threads) const
+            {
+                return parallel_policy{ &threads };
+            }
+        };
+
+        /**
+         * @struct parallel_unsequenced_policy
+         * @brief Runs the algorithm on the threads of a pool, each thread being free to interleave its elements.
+         */
+        struct parallel_unsequenced_policy
+        {
+            ThreadPool* pool = nullptr; ///< Threads running the algorithm, the global pool when null
+
+            /**
+             * @brief Returns the same policy running on other threads.
+             * @param threads The pool to run on.
+             * @return parallel_unsequenced_policy bound to threads.
+             */
+            parallel_unsequenced_policy on(ThreadPool& threads) const
+            {
+                return parallel_unsequenced_policy{ &threads };
+            }
+        };
+
+        inline constexpr sequenced_policy seq{};
+        inline constexpr parallel_policy par{};
+        inline constexpr parallel_unsequenced_policy par_unseq{};
+
+        /**
+         * @brief Tells whether T is one of the execution policies.
+         */
+        template<typename T>
+        struct is_execution_policy : std::false_type
+        {
+        };
+
+        template<>
+        struct is_execution_policy<sequenced_policy> : std::true_type
+        {
+        };
+
+        template<>
+        struct is_execution_policy<parallel_policy> : std::true_type
+        {
+        };
+
+        template<>
+        struct is_execution_policy<parallel_unsequenced_policy> : std::true_type
+        {
+        };
+
+        template<typename T>
+        inline constexpr bool is_execution_policy_v = is_execution_policy<std::remove_cvref_t<T>>::value;
+    };
+
+    namespace detail
+    {
+        /** Below this many elements a policy algorithm stays on the calling thread. */
+        constexpr size_t parallelExecutionThreshold = size_t(1) << 15;
+
+        /** Minimum number of elements per block of a policy algorithm. */
+        constexpr size_t executionGrain = size_t(1) << 13;
+
+        /** Size of the cache lines the blocks are aligned to. */
+        constexpr size_t executionLine = 64;
+
+        /** Number of independent accumulators of an unsequenced reduction. */
+        constexpr size_t unsequencedLanes = 8;
+
+        template<typename Policy>
+        concept ExecutionPolicy = execution::is_execution_policy_v<Policy>;
+
+        template<typename Policy>
+        inline constexpr bool isUnsequenced = std::is_same_v<std::remove_cvref_t<Policy>, execution::parallel_unsequenced_policy>;
+
+        /**
+         * The iterators a policy algorithm splits into blocks. The tag is
+         * checked rather than std::random_access_iterator, which the
+         * container iterators of mylib do not model.
+         */
+        template<typename Iterator>
+        concept BlockIterator = std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>;
+
+        /** A policy algorithm that may run in blocks on a pool. */
+        template<typename Policy, typename... Iterators>
+        concept BlockAlgorithm = ExecutionPolicy<Policy>
+            && !std::is_same_v<std::remove_cvref_t<Policy>, execution::sequenced_policy> && (BlockIterator<Iterators> && ...);
+
+        /**
+         * @brief Returns the pool a policy runs on.
+         */
+        template<typename Policy>
+        ThreadPool& policyPool(const Policy& policy)
+        {
+            return policy.pool ? *policy.pool : ThreadPool::global();
+        }
+
+        /**
+         * @brief Tells whether a parallel algorithm over count elements is worth splitting on the pool of policy.
+         */
+        template<typename Policy>
+        bool runsInBlocks(const Policy& policy, size_t count)
+        {
+            return count >= parallelExecutionThreshold && policyPool(policy).size() > 1;
+        }
+
+        /**
+         * @struct BlockPartition
+         * @brief Split of [0, count) into blocks whose inner boundaries start a cache line of the range written.
+         *
+         * Block 0 is [0, head + size), block i is [head + i * size, head + (i + 1) * size),
+         * the last one ending at count. size is a whole number of lines.
+         */
+        struct BlockPartition
+        {
+            size_t count;  ///< Number of elements
+            size_t head;   ///< Elements before the first line boundary
+            size_t size;   ///< Elements per block
+            size_t blocks; ///< Number of blocks
+
+            size_t begin(size_t block) const
+            {
+                return block == 0 ? 0 : head + block * size;
+            }
+
+            size_t end(size_t block) const
+            {
+                const size_t end = head + (block + 1) * size;
+                return end < count ? end : count;
+            }
+        };
+
+        /**
+         * @brief Splits count elements of elementSize bytes into a few blocks per thread of pool, aligned on the
+         * cache lines of the range starting at address (any split when address is null).
+         */
+        inline BlockPartition partitionBlocks(const ThreadPool& pool, const void* address, size_t elementSize, size_t count)
+        {
+            size_t line = 1;
+            size_t head = 0;
+            if (address && executionLine % elementSize == 0 && std::uintptr_t(address) % elementSize == 0)
+            {
+                line = executionLine / elementSize;
+                head = ((executionLine - std::uintptr_t(address) % executionLine) % executionLine) / elementSize;
+                head = head < count ? head : count;
+            }
+
+            size_t blocks = count / executionGrain;
+            blocks = blocks < 4 * pool.size() ? blocks : 4 * pool.size();
+            blocks = blocks ? blocks : 1;
+            size_t size = (count - head + blocks - 1) / blocks;
+            size = (size + line - 1) / line * line;
+            size = size ? size : line;
+            blocks = count > head ? (count - head + size - 1) / size : 1;
+
+            return BlockPartition{ count, head, size, blocks };
+        }
+
+        /**
+         * @brief Splits the count elements from first into blocks, aligned on its cache lines when the range is contiguous.
+         */
+        template<typename Iterator>
+        BlockPartition partitionBlocks(const ThreadPool& pool, Iterator first, size_t count)
+        {
+            if constexpr (ContiguousIterator<Iterator>)
+                return partitionBlocks(pool, std::to_address(first), sizeof(std::iter_value_t<Iterator>), count);
+            else
+                return partitionBlocks(pool, nullptr, 1, count);
+        }
+
+        /**
+         * @brief Runs func(begin, end) in parallel on the blocks of the count elements from first.
+         */
+        template<typename Iterator, typename Func>
+        void forEachBlock(ThreadPool& pool, Iterator first, size_t count, Func&& func)
+        {
+            const BlockPartition partition = partitionBlocks(pool, first, count);
+            pool.run(partition.blocks, [&](size_t block)
+            {
+                func(partition.begin(block), partition.end(block));
+            });
+        }
+
+        /**
+         * @brief init combined with read(i) for i in [begin, end), read(i) being combined in
+         * unsequencedLanes interleaved accumulators.
+         */
+        template<typename T, typename ReduceOp, typename Read>
+        T unsequencedReduce(size_t begin, size_t end, T init, ReduceOp& reduceOp, Read& read)
+        {
+            size_t i = begin;
+            if constexpr (std::is_default_constructible_v<T> && std::is_copy_assignable_v<T>)
+            {
+                if (end - begin >= 2 * unsequencedLanes)
+                {
+                    T lanes[unsequencedLanes];
+                    for (size_t lane = 0; lane < unsequencedLanes; ++lane)
+                        lanes[lane] = read(i + lane);
+
+                    for (i += unsequencedLanes; i + unsequencedLanes <= end; i += unsequencedLanes)
+                        for (size_t lane = 0; lane < unsequencedLanes; ++lane)
+                            lanes[lane] = reduceOp(lanes[lane], read(i + lane));
+
+                    for (size_t width = unsequencedLanes / 2; width > 0; width /= 2)
+                        for (size_t lane = 0; lane < width; ++lane)
+                            lanes[lane] = reduceOp(lanes[lane], lanes[lane + width]);
+
+                    init = reduceOp(std::move(init), lanes[0]);
+                }
+            }
+
+            for (; i < end; ++i)
+                init = reduceOp(std::move(init), read(i));
+            return init;
+        }
+
+        /**
+         * @brief init combined with read(i) for i in [0, count), in blocks of the elements from first on
+         * the pool of policy. Each block keeps its partial result on its own cache line.
+         */
+        template<typename Policy, typename Iterator, typename T, typename ReduceOp, typename Read>
+        T blockReduce(const Policy& policy, Iterator first, size_t count, T init, ReduceOp& reduceOp, Read& read)
+        {
+            struct alignas(executionLine) Partial
+            {
+                std::optional<T> value;
+            };
+
+            ThreadPool& pool = policyPool(policy);
+            const BlockPartition partition = partitionBlocks(pool, first, count);
+            const auto partials = std::make_unique<Partial[]>(partition.blocks);
+
+            pool.run(partition.blocks, [&](size_t block)
+            {
+                const size_t begin = partition.begin(block);
+                const size_t end = partition.end(block);
+                T value = read(begin);
+                if constexpr (isUnsequenced<Policy>)
+                    value = unsequencedReduce(begin + 1, end, std::move(value), reduceOp, read);
+                else
+                    for (size_t i = begin + 1; i < end; ++i)
+                        value = reduceOp(std::move(value), read(i));
+                partials[block].value.emplace(std::move(value));
+            });
+
+            for (size_t block = 0; block < partition.blocks; ++block)
+                init = reduceOp(std::move(init), std::move(*partials[block].value));
+            return init;
+        }
+
+        /**
+         * @brief init combined with read(i) for i in [0, count) under policy, read reading the elements from first.
+         */
+        template<typename Policy, typename Iterator, typename T, typename ReduceOp, typename Read>
+        T policyReduce(const Policy& policy, Iterator first, size_t count, T init, ReduceOp& reduceOp, Read& read)
+        {
+            if (runsInBlocks(policy, count))
+                return blockReduce(policy, first, count, std::move(init), reduceOp, read);
+            if constexpr (isUnsequenced<Policy>)
+                return unsequencedReduce(0, count, std::move(init), reduceOp, read);
+
+            for (size_t i = 0; i < count; ++i)
+                init = reduceOp(std::move(init), read(i));
+            return init;
+        }
+    };
+
+    /**
+     * @brief Transform elements from one range to another under an execution policy.
+     *
+     * @tparam Policy One of the glg::execution policies.
+     * @tparam Input Input iterator type.
+     * @tparam Output Output iterator type.
+     * @tparam Op Unary operation type.
+     * @param policy How the elements are distributed over threads.
+     * @param firstElem Iterator to the first element in the input range.
+     * @param secondElem Iterator to the last element in the input range.
+     * @param startOfElem Iterator to the first element in the output range.
+     * @param operation Unary operation applied to each element, possibly from several threads at once.
+     * @return Output Iterator to the element past the last element transformed.
+     */
+    template<detail::ExecutionPolicy Policy, typename Input, typename Output, typename Op>
+    Output transform(Policy&& policy, Input firstElem, Input secondElem, Output startOfElem, Op operation)
+    {
+        if constexpr (detail::BlockAlgorithm<Policy, Input, Output>)
+        {
+            const size_t count = size_t(secondElem - firstElem);
+            if (detail::runsInBlocks(policy, count))
+            {
+                detail::forEachBlock(detail::policyPool(policy), startOfElem, count, [&](size_t begin, size_t end)
+                {
+                    glg::transform(firstElem + std::ptrdiff_t(begin), firstElem + std::ptrdiff_t(end), startOfElem + std::ptrdiff_t(begin), operation);
+                });
+                return startOfElem + std::ptrdiff_t(count);
+            }
+        }
+
+        return glg::transform(firstElem, secondElem, startOfElem, operation);
+    }
+
+    /**
+     * @brief Transform pairs of elements from two ranges under an execution policy.
+     *
+     * @tparam Policy One of the glg::execution policies.
+     * @tparam Input1 First input iterator type.
+     * @tparam Input2 Second input iterator type.
+     * @tparam Output Output iterator type.
+     * @tparam Op Binary operation type.
+     * @param policy How the elements are distributed over threads.
+     * @param firstElem Iterator to the first element in the first input range.
+     * @param lastElem Iterator to the last element in the first input range.
+     * @param secondElem Iterator to the first element in the second input range.
+     * @param startOfElem Iterator to the first element in the output range.
+     * @param operation Binary operation applied to each pair, possibly from several threads at once.
+     * @return Output Iterator to the element past the last element transformed.
+     */
+    template<detail::ExecutionPolicy Policy, typename Input1, typename Input2, typename Output, typename Op>
+    Output transform(Policy&& policy, Input1 firstElem, Input1 lastElem, Input2 secondElem, Output startOfElem, Op operation)
+    {
+        if constexpr (detail::BlockAlgorithm<Policy, Input1, Input2, Output>)
+        {
+            const size_t count = size_t(lastElem - firstElem);
+            if (detail::runsInBlocks(policy, count))
+            {
+                detail::forEachBlock(detail::policyPool(policy), startOfElem, count, [&](size_t begin, size_t end)
+                {
+                    glg::transform(firstElem + std::ptrdiff_t(begin), firstElem + std::ptrdiff_t(end), secondElem + std::ptrdiff_t(begin),
+                        startOfElem + std::ptrdiff_t(begin), operation);
+                });
+                return startOfElem + std::ptrdiff_t(count);
+            }
+        }
+
+        return glg::transform(firstElem, lastElem, secondElem, startOfElem, operation);
+    }
+
+    /**
+     * @brief Apply a function to every element of a range under an execution policy.
+     *
+     * @tparam Policy One of the glg::execution policies.
+     * @tparam Input Input iterator type.
+     * @tparam Func Unary function type.
+     * @param policy How the elements are distributed over threads.
+     * @param first Iterator to the first element in the range.
+     * @param last Iterator to the last element in the range.
+     * @param func Function called with each element, possibly from several threads at once.
+     */
+    template<detail::ExecutionPolicy Policy, typename Input, typename Func>
+    void for_each(Policy&& policy, Input first, Input last, Func func)
+    {
+        if constexpr (detail::BlockAlgorithm<Policy, Input>)
+        {
+            const size_t count = size_t(last - first);
+            if (detail::runsInBlocks(policy, count))
+            {
+                detail::forEachBlock(detail::policyPool(policy), first, count, [&](size_t begin, size_t end)
+                {
+                    glg::for_each(first + std::ptrdiff_t(begin), first + std::ptrdiff_t(end), func);
+                });
+                return;
+            }
+        }
+
+        glg::for_each(first, last, func);
+    }
+
+    /**
+     * @brief Transform the elements of a range, then combine the results, under an execution policy.
+     * reduceOp must be associative and commutative, the results being combined in any grouping.
+     *
+     * @tparam Policy One of the glg::execution policies.
+     * @tparam Input Input iterator type.
+     * @tparam T Type of the result.
+     * @tparam ReduceOp Binary operation combining the results.
+     * @tparam TransformOp Unary operation applied to each element.
+     * @param policy How the elements are distributed over threads.
+     * @param first Iterator to the first element in the range.
+     * @param last Iterator to the last element in the range.
+     * @param init Initial value, combined once.
+     * @param reduceOp Binary operation combining the results.
+     * @param transformOp Unary operation applied to each element.
+     * @return T The combination of init and every transformed element.
+     */
+    template<detail::ExecutionPolicy Policy, typename Input, typename T, typename ReduceOp, typename TransformOp>
+    T transform_reduce(Policy&& policy, Input first, Input last, T init, ReduceOp reduceOp, TransformOp transformOp)
+    {
+        if constexpr (detail::BlockAlgorithm<Policy, Input>)
+        {
+            auto read = [&](size_t i) { return transformOp(first[std::ptrdiff_t(i)]); };
+            return detail::policyReduce(policy, first, size_t(last - first), std::move(init), reduceOp, read);
+        }
+        else
+            return glg::transform_reduce(first, last, std::move(init), reduceOp, transformOp);
+    }
+
+    /**
+     * @brief Combine the elements of a range under an execution policy.
+     * The operation must be associative and commutative, the elements being combined in any grouping.
+     *
+     * @tparam Policy One of the glg::execution policies.
+     * @tparam Input Input iterator type.
+     * @tparam T Type of the result.
+     * @tparam Op Binary operation type.
+     * @param policy How the elements are distributed over threads.
+     * @param first Iterator to the first element in the range.
+     * @param last Iterator to the last element in the range.
+     * @param init Initial value, combined once.
+     * @param operation Binary operation, addition by default.
+     * @return T The combination of init and every element.
+     */
+    template<detail::ExecutionPolicy Policy, typename Input, typename T, typename Op = std::plus<>>
+    T reduce(Policy&& policy, Input first, Input last, T init, Op operation = {})
+    {
+        return glg::transform_reduce(std::forward<Policy>(policy), first, last, std::move(init), operation, std::identity());
+    }
+
+    /**
+     * @brief Combine pairs of elements from two ranges, then combine the results, under an execution policy.
+     * With the default operations this is the inner product of the two ranges.
+     *
+     * @tparam Policy One of the glg::execution policies.
+     * @tparam Input1 First input iterator type.
+     * @tparam Input2 Second input iterator type.
+     * @tparam T Type of the result.
+     * @tparam ReduceOp Binary operation combining the results.
+     * @tparam TransformOp Binary operation applied to each pair of elements.
+     * @param policy How the elements are distributed over threads.
+     * @param first1 Iterator to the first element in the first range.
+     * @param last1 Iterator to the last element in the first range.
+     * @param first2 Iterator to the first element in the second range.
+     * @param init Initial value, combined once.
+     * @param reduceOp Binary operation combining the results, addition by default.
+     * @param transformOp Binary operation applied to each pair, multiplication by default.
+     * @return T The combination of init and every transformed pair.
+     */
+    template<detail::ExecutionPolicy Policy, typename Input1, detail::LegacyIterator Input2, typename T,
+        typename ReduceOp = std::plus<>, typename TransformOp = std::multiplies<>>
+    T transform_reduce(Policy&& policy, Input1 first1, Input1 last1, Input2 first2, T init, ReduceOp reduceOp = {}, TransformOp transformOp = {})
+    {
+        if constexpr (detail::BlockAlgorithm<Policy, Input1, Input2>)
+        {
+            auto read = [&](size_t i) { return transformOp(first1[std::ptrdiff_t(i)], first2[std::ptrdiff_t(i)]); };
+            return detail::policyReduce(policy, first1, size_t(last1 - first1), std::move(init), reduceOp, read);
+        }
+        else
+            return glg::transform_reduce(first1, last1, first2, std::move(init), reduceOp, transformOp);
+    }
+
+    /**
+     * @brief Fill a range with a specified value under an execution policy.
+     *
+     * @tparam Policy One of the glg::execution policies.
+     * @tparam Output Output iterator type.
+     * @tparam T Type of the value.
+     * @param policy How the elements are distributed over threads.
+     * @param first Iterator to the first element in the range.
+     * @param last Iterator to the last element in the range.
+     * @param value Value to fill the range with.
+     */
+    template<detail::ExecutionPolicy Policy, typename Output, typename T>
+    void fill(Policy&& policy, Output first, Output last, const T& value)
+    {
+        if constexpr (detail::BlockAlgorithm<Policy, Output>)
+        {
+            const size_t count = size_t(last - first);
+            if (detail::runsInBlocks(policy, count))
+            {
+                detail::forEachBlock(detail::policyPool(policy), first, count, [&](size_t begin, size_t end)
+                {
+                    glg::fill(first + std::ptrdiff_t(begin), first + std::ptrdiff_t(end), value);
+                });
+                return;
+            }
+        }
+
+        glg::fill(first, last, value);
+    }
+
+    /**
+     * @brief Copy elements from one range to another under an execution policy.
+     *
+     * @tparam Policy One of the glg::execution policies.
+     * @tparam Input Input iterator type.
+     * @tparam Output Output iterator type.
+     * @param policy How the elements are distributed over threads.
+     * @param firstElem Iterator to the first element in the input range.
+     * @param secondElem Iterator to the last element in the input range.
+     * @param output Iterator to the first element in the output range, which must not overlap the input.
+     * @return Output Iterator to the element past the last element copied.
+     */
+    template<detail::ExecutionPolicy Policy, typename Input, typename Output>
+    Output copy(Policy&& policy, Input firstElem, Input secondElem, Output output)
+    {
+        if constexpr (detail::BlockAlgorithm<Policy, Input, Output>)
+        {
+            const size_t count = size_t(secondElem - firstElem);
+            if (detail::runsInBlocks(policy, count))
+            {
+                detail::forEachBlock(detail::policyPool(policy), output, count, [&](size_t begin, size_t end)
+                {
+                    glg::copy(firstElem + std::ptrdiff_t(begin), firstElem + std::ptrdiff_t(end), output + std::ptrdiff_t(begin));
+                });
+                return output + std::ptrdiff_t(count);
+            }
+        }
+
+        return glg::copy(firstElem, secondElem, output);
+    }
+};
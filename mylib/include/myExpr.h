@@ -0,0 +1,778 @@
+/**
+ * @file myExpr.h
+ * @brief Implementation of the expression templates behind the myMatrix and myVectorND operators.
+ * @author Guillaume
+ * @date 18/10/2026
+ *
+ * An operator on matrices or vectors does not compute anything: it returns a
+ * small node recording its operands, and the whole expression is evaluated
+ * when it is assigned to a myMatrix or a myVectorND. Element-wise operations
+ * are fused in one loop with no temporary, and a product is written directly
+ * by the GEMM kernel: D = A * B + C copies C into D then accumulates A * B on
+ * top of it (beta = 1) instead of materialising A * B.
+ *
+ * A myVectorND<T, N> takes part in expressions as an N x 1 column, so a
+ * matrix-vector product fuses with the element-wise operations around it;
+ * it runs in the GEMV kernel (y = A * x + y is a single gemv with beta = 1).
+ *
+ * Matrices of different layouts mix freely. An element-wise expression whose
+ * operands all share the layout of the destination runs over the storage
+ * in one flat loop; otherwise it is evaluated position by position in the
+ * order of the destination. Products hand the strides of row-major and
+ * column-major operands to the kernels, and only copy tiled ones.
+ *
+ * Nodes hold their matrix and vector operands by reference: an expression
+ * stored in an auto variable must not outlive them. Use glg::eval() to get
+ * a concrete result.
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include "myGemm.h"
+#include "myGemv.h"
+#include "myLayout.h"
+#include "myTranspose.h"
+
+template<typename type, size_t size>
+struct myVectorND;
+
+namespace glg
+{
+    namespace expr
+    {
+        /** Base of every expression node. */
+        struct ExprBase {};
+
+        template<typename E>
+        concept Expression = std::is_base_of_v<ExprBase, std::remove_cvref_t<E>>;
+
+        /**
+         * @brief Shape and layout of the containers usable in an expression, a vector being a column.
+         */
+        template<typename C>
+        struct ContainerTraits
+        {
+            static constexpr bool value = false;
+        };
+
+        template<typename T, size_t H, size_t W, typename L>
+        struct ContainerTraits<myMatrix<T, H, W, L>>
+        {
+            static constexpr bool value = true;
+            static constexpr size_t rows = H;
+            static constexpr size_t cols = W;
+            using layout = L;
+        };
+
+        template<typename T, size_t N>
+        struct ContainerTraits<myVectorND<T, N>>
+        {
+            static constexpr bool value = true;
+            static constexpr size_t rows = N;
+            static constexpr size_t cols = 1;
+            using layout = glg::RowMajor;
+        };
+
+        template<typename C>
+        concept Container = ContainerTraits<std::remove_cvref_t<C>>::value;
+
+        /** Anything an operator accepts as a matrix or vector operand. */
+        template<typename X>
+        concept Operand = Expression<X> || Container<X>;
+
+        /** Anything an operator accepts as a scalar operand. */
+        template<typename S>
+        concept Scalar = std::is_arithmetic_v<S> || (std::is_convertible_v<S, float> && !Operand<S>);
+
+        /**
+         * @brief Scratch storage of a node, on the stack up to 4 KB. Copying a node never copies its scratch.
+         */
+        template<typename T, size_t count>
+        struct Scratch
+        {
+            static constexpr bool onStack = count * sizeof(T) <= 4096;
+
+            Scratch() = default;
+            Scratch(const Scratch&) {}
+            Scratch& operator=(const Scratch&) = delete;
+
+            T* get()
+            {
+                if constexpr (onStack)
+                {
+                    return m_stack.data();
+                }
+                else
+                {
+                    if (!m_heap)
+                        m_heap.reset(new T[count]);
+                    return m_heap.get();
+                }
+            }
+
+        private:
+            std::conditional_t<onStack, std::array<T, count>, char> m_stack;
+            std::conditional_t<onStack, char, std::unique_ptr<T[]>> m_heap;
+        };
+
+        /**
+         * @brief Checks if [first, first + count) overlaps [other, other + otherCount).
+         */
+        template<typename T>
+        bool overlaps(const T* first, size_t count, const T* other, size_t otherCount)
+        {
+            std::less<const T*> less;
+            return less(first, other + otherCount) && less(other, first + count);
+        }
+
+        template<typename D = glg::RowMajor, typename E, typename T>
+        void evaluate(const E& expr, T* dst);
+
+        /**
+         * @struct Terminal
+         * @brief Leaf of an expression, a reference to a myMatrix or a myVectorND.
+         */
+        template<typename C>
+        struct Terminal : ExprBase
+        {
+            using value_type = typename C::value_type;
+            using result_type = C;
+            using layout = typename ContainerTraits<C>::layout;
+            static constexpr size_t rows = ContainerTraits<C>::rows;
+            static constexpr size_t cols = ContainerTraits<C>::cols;
+
+            /** Whether element i of the storage is element i of a destination in layout D. */
+            template<typename D>
+            static constexpr bool storedAs = glg::sameOrder<layout, D, rows, cols>;
+
+            explicit Terminal(const C& container) : m_container(container) {}
+
+            value_type operator[](size_t idx) const
+            {
+                return m_container.data()[idx];
+            }
+
+            value_type at(size_t row, size_t col) const
+            {
+                return m_container.data()[layout::index(row, col, rows, cols)];
+            }
+
+            const value_type* data() const
+            {
+                return m_container.data();
+            }
+
+            bool aliases(const value_type* dst, size_t count) const
+            {
+                return overlaps(data(), rows * cols, dst, count);
+            }
+
+            void prepare() const {}
+
+            void release() const {}
+
+        private:
+            const C& m_container;
+        };
+
+        /**
+         * @struct Binary
+         * @brief Element-wise operation between two operands of the same shape.
+         */
+        template<typename L, typename R, typename Op>
+        struct Binary : ExprBase
+        {
+            static_assert(L::rows == R::rows && L::cols == R::cols, "operands must have the same shape");
+            static_assert(std::is_same_v<typename L::value_type, typename R::value_type>, "operands must have the same element type");
+
+            using value_type = typename L::value_type;
+            using result_type = typename L::result_type;
+            using layout = typename L::layout;
+            static constexpr size_t rows = L::rows;
+            static constexpr size_t cols = L::cols;
+
+            template<typename D>
+            static constexpr bool storedAs = L::template storedAs<D> && R::template storedAs<D>;
+
+            Binary(const L& lhs, const R& rhs) : m_lhs(lhs), m_rhs(rhs) {}
+
+            value_type operator[](size_t idx) const
+            {
+                return value_type(Op{}(m_lhs[idx], m_rhs[idx]));
+            }
+
+            value_type at(size_t row, size_t col) const
+            {
+                return value_type(Op{}(m_lhs.at(row, col), m_rhs.at(row, col)));
+            }
+
+            bool aliases(const value_type* dst, size_t count) const
+            {
+                return m_lhs.aliases(dst, count) || m_rhs.aliases(dst, count);
+            }
+
+            void prepare() const
+            {
+                m_lhs.prepare();
+                m_rhs.prepare();
+            }
+
+            void release() const
+            {
+                m_lhs.release();
+                m_rhs.release();
+            }
+
+            const L& lhs() const
+            {
+                return m_lhs;
+            }
+
+            const R& rhs() const
+            {
+                return m_rhs;
+            }
+
+        private:
+            L m_lhs;
+            R m_rhs;
+        };
+
+        /**
+         * @struct ScalarOp
+         * @brief Element-wise operation between an operand and a scalar (expr * s, expr / s).
+         */
+        template<typename E, typename S, typename Op>
+        struct ScalarOp : ExprBase
+        {
+            using value_type = typename E::value_type;
+            using result_type = typename E::result_type;
+            using layout = typename E::layout;
+            static constexpr size_t rows = E::rows;
+            static constexpr size_t cols = E::cols;
+
+            template<typename D>
+            static constexpr bool storedAs = E::template storedAs<D>;
+
+            ScalarOp(const E& expr, const S& scalar) : m_expr(expr), m_scalar(scalar) {}
+
+            value_type operator[](size_t idx) const
+            {
+                return value_type(Op{}(m_expr[idx], m_scalar));
+            }
+
+            value_type at(size_t row, size_t col) const
+            {
+                return value_type(Op{}(m_expr.at(row, col), m_scalar));
+            }
+
+            bool aliases(const value_type* dst, size_t count) const
+            {
+                return m_expr.aliases(dst, count);
+            }
+
+            void prepare() const
+            {
+                m_expr.prepare();
+            }
+
+            void release() const
+            {
+                m_expr.release();
+            }
+
+            const E& expr() const
+            {
+                return m_expr;
+            }
+
+            const S& scalar() const
+            {
+                return m_scalar;
+            }
+
+        private:
+            E m_expr;
+            S m_scalar;
+        };
+
+        /**
+         * @struct Negate
+         * @brief Element-wise negation.
+         */
+        template<typename E>
+        struct Negate : ExprBase
+        {
+            using value_type = typename E::value_type;
+            using result_type = typename E::result_type;
+            using layout = typename E::layout;
+            static constexpr size_t rows = E::rows;
+            static constexpr size_t cols = E::cols;
+
+            template<typename D>
+            static constexpr bool storedAs = E::template storedAs<D>;
+
+            explicit Negate(const E& expr) : m_expr(expr) {}
+
+            value_type operator[](size_t idx) const
+            {
+                return value_type(-m_expr[idx]);
+            }
+
+            value_type at(size_t row, size_t col) const
+            {
+                return value_type(-m_expr.at(row, col));
+            }
+
+            bool aliases(const value_type* dst, size_t count) const
+            {
+                return m_expr.aliases(dst, count);
+            }
+
+            void prepare() const
+            {
+                m_expr.prepare();
+            }
+
+            void release() const
+            {
+                m_expr.release();
+            }
+
+            const E& expr() const
+            {
+                return m_expr;
+            }
+
+        private:
+            E m_expr;
+        };
+
+        /**
+         * @struct Product
+         * @brief Matrix product of a rows x inner operand by an inner x cols operand.
+         *
+         * Assigned on its own or summed with another operand, it is written
+         * straight into the destination by Math::gemm. Nested deeper in an
+         * element-wise expression, it is computed into its own scratch, in the
+         * layout of the left operand, before each fused loop runs. Outside an
+         * evaluation, an element is the dot product of a row and a column.
+         */
+        template<typename L, typename R>
+        struct Product : ExprBase
+        {
+            static_assert(L::cols == R::rows, "inner dimensions must be equal");
+            static_assert(std::is_same_v<typename L::value_type, typename R::value_type>, "operands must have the same element type");
+
+            using value_type = typename L::value_type;
+            using layout = typename L::layout;
+            static constexpr size_t rows = L::rows;
+            static constexpr size_t inner = L::cols;
+            static constexpr size_t cols = R::cols;
+            using result_type = std::conditional_t<cols == 1 && ContainerTraits<typename R::result_type>::cols == 1,
+                myVectorND<value_type, rows>, myMatrix<value_type, rows, cols, layout>>;
+
+            template<typename D>
+            static constexpr bool storedAs = glg::sameOrder<layout, D, rows, cols>;
+
+            Product(const L& lhs, const R& rhs) : m_lhs(lhs), m_rhs(rhs) {}
+
+            value_type operator[](size_t idx) const
+            {
+                if (m_ready)
+                    return m_result.get()[idx];
+                const auto [row, col] = layout::position(idx, rows, cols);
+                return element(row, col);
+            }
+
+            value_type at(size_t row, size_t col) const
+            {
+                if (m_ready)
+                    return m_result.get()[layout::index(row, col, rows, cols)];
+                return element(row, col);
+            }
+
+            bool aliases(const value_type* dst, size_t count) const
+            {
+                return m_lhs.aliases(dst, count) || m_rhs.aliases(dst, count);
+            }
+
+            /** Computes the product into the scratch read by the accessors, until release(). */
+            void prepare() const
+            {
+                evaluateInto<layout>(m_result.get(), value_type(1), value_type(0));
+                m_ready = true;
+            }
+
+            /** The operands may change once the evaluation is over, the scratch is no longer read. */
+            void release() const
+            {
+                m_ready = false;
+            }
+
+            /**
+             * @brief c = alpha * lhs * rhs + beta * c, c being a rows x cols matrix in layout D that does not overlap an operand.
+             */
+            template<typename D>
+            void evaluateInto(value_type* c, value_type alpha, value_type beta) const
+            {
+                if constexpr (!D::strided && !glg::sameOrder<D, glg::RowMajor, rows, cols>)
+                {
+                    // The kernels need strides: the product goes through a row-major copy of c
+                    Scratch<value_type, rows * cols> rowMajor;
+                    value_type* buffer = rowMajor.get();
+                    if (beta != value_type(0))
+                        Math::relayout<D, glg::RowMajor>(c, buffer, rows, cols);
+                    evaluateInto<glg::RowMajor>(buffer, alpha, beta);
+                    Math::relayout<glg::RowMajor, D>(buffer, c, rows, cols);
+                }
+                else
+                {
+                    using Strided = std::conditional_t<D::strided, D, glg::RowMajor>;
+                    constexpr size_t rowStrideC = Strided::rowStride(rows, cols);
+                    constexpr size_t colStrideC = Strided::colStride(rows, cols);
+
+                    Scratch<value_type, rows * inner> lhsScratch;
+                    Scratch<value_type, inner * cols> rhsScratch;
+                    const Operand a = operandOf(m_lhs, lhsScratch);
+                    const Operand b = operandOf(m_rhs, rhsScratch);
+
+                    if constexpr (cols == 1)
+                    {
+                        Math::gemv<value_type>(rows, inner, alpha, a.data, a.rowStride, a.colStride, b.data, b.rowStride, beta, c, rowStrideC);
+                    }
+                    else
+                    {
+                        const bool rowMajor = a.colStride == 1 && a.rowStride == inner && b.colStride == 1 && b.rowStride == cols
+                            && colStrideC == 1 && rowStrideC == cols;
+                        const bool colMajor = a.rowStride == 1 && a.colStride == rows && b.rowStride == 1 && b.colStride == inner
+                            && rowStrideC == 1 && colStrideC == rows;
+
+                        if (alpha == value_type(1) && beta == value_type(0) && rowMajor)
+                            Math::gemmFixed<value_type, rows, cols, inner>(a.data, b.data, c);
+                        else if (alpha == value_type(1) && beta == value_type(0) && colMajor)
+                            Math::gemmFixed<value_type, cols, rows, inner>(b.data, a.data, c); // C^T = B^T A^T, all row-major
+                        else
+                            Math::gemm<value_type>(rows, cols, inner, alpha, a.data, a.rowStride, a.colStride,
+                                b.data, b.rowStride, b.colStride, beta, c, rowStrideC, colStrideC);
+                    }
+                }
+            }
+
+        private:
+            value_type element(size_t row, size_t col) const
+            {
+                value_type sum = value_type(0);
+                for (size_t k = 0; k < inner; ++k)
+                    sum += m_lhs.at(row, k) * m_rhs.at(k, col);
+                return sum;
+            }
+
+            /** Elements and strides of an operand of the product. */
+            struct Operand
+            {
+                const value_type* data;
+                size_t rowStride;
+                size_t colStride;
+            };
+
+            /** A row-major or column-major matrix is used in place, anything else is evaluated row-major first. */
+            template<typename E, size_t count>
+            static Operand operandOf(const E& operand, Scratch<value_type, count>& scratch)
+            {
+                if constexpr (requires { operand.data(); } && E::layout::strided)
+                {
+                    using Layout = typename E::layout;
+                    return { operand.data(), Layout::rowStride(E::rows, E::cols), Layout::colStride(E::rows, E::cols) };
+                }
+                else
+                {
+                    value_type* buffer = scratch.get();
+                    evaluate(operand, buffer);
+                    return { buffer, E::cols, 1 };
+                }
+            }
+
+            L m_lhs;
+            R m_rhs;
+            mutable Scratch<value_type, rows * cols> m_result;
+            mutable bool m_ready = false;
+        };
+
+        /**
+         * @brief Recognises a (possibly scaled or negated) product, the terms that map to a GEMM with alpha.
+         */
+        template<typename E>
+        struct ProductTerm
+        {
+            static constexpr bool value = false;
+        };
+
+        template<typename L, typename R>
+        struct ProductTerm<Product<L, R>>
+        {
+            static constexpr bool value = true;
+            using value_type = typename Product<L, R>::value_type;
+
+            static const Product<L, R>& product(const Product<L, R>& expr)
+            {
+                return expr;
+            }
+
+            static value_type alpha(const Product<L, R>&)
+            {
+                return value_type(1);
+            }
+        };
+
+        template<typename L, typename R, typename S>
+        struct ProductTerm<ScalarOp<Product<L, R>, S, std::multiplies<>>>
+        {
+            static constexpr bool value = true;
+            using value_type = typename Product<L, R>::value_type;
+
+            static const Product<L, R>& product(const ScalarOp<Product<L, R>, S, std::multiplies<>>& expr)
+            {
+                return expr.expr();
+            }
+
+            static value_type alpha(const ScalarOp<Product<L, R>, S, std::multiplies<>>& expr)
+            {
+                return value_type(expr.scalar());
+            }
+        };
+
+        template<typename L, typename R>
+        struct ProductTerm<Negate<Product<L, R>>>
+        {
+            static constexpr bool value = true;
+            using value_type = typename Product<L, R>::value_type;
+
+            static const Product<L, R>& product(const Negate<Product<L, R>>& expr)
+            {
+                return expr.expr();
+            }
+
+            static value_type alpha(const Negate<Product<L, R>>&)
+            {
+                return value_type(-1);
+            }
+        };
+
+        template<typename E>
+        struct IsSum
+        {
+            static constexpr bool value = false;
+        };
+
+        template<typename L, typename R>
+        struct IsSum<Binary<L, R, std::plus<>>>
+        {
+            static constexpr bool value = true;
+            static constexpr bool subtract = false;
+        };
+
+        template<typename L, typename R>
+        struct IsSum<Binary<L, R, std::minus<>>>
+        {
+            static constexpr bool value = true;
+            static constexpr bool subtract = true;
+        };
+
+        /**
+         * @brief Writes the rows x cols elements of expr into dst, a contiguous matrix in layout D.
+         *
+         * A product term that does not read dst becomes one GEMM call: alone
+         * with beta = 0, or as the last term of a sum with beta = 1 once the
+         * rest of the sum has been written to dst. Everything else runs as a
+         * single fused element-wise loop; since element i only reads element
+         * i of each operand, dst may be one of them. When the operands are not
+         * all stored like dst, the loop runs by position instead, through a
+         * copy if an operand is dst.
+         */
+        template<typename D, typename E, typename T>
+        void evaluate(const E& expr, T* dst)
+        {
+            constexpr size_t count = E::rows * E::cols;
+
+            if constexpr (ProductTerm<E>::value)
+            {
+                const auto& product = ProductTerm<E>::product(expr);
+                if (!product.aliases(dst, count))
+                {
+                    product.template evaluateInto<D>(dst, ProductTerm<E>::alpha(expr), T(0));
+                    return;
+                }
+            }
+            else if constexpr (requires { expr.data(); } && E::template storedAs<D>)
+            {
+                if (expr.data() == dst)
+                    return;
+            }
+            else if constexpr (IsSum<E>::value)
+            {
+                using L = std::remove_cvref_t<decltype(expr.lhs())>;
+                using R = std::remove_cvref_t<decltype(expr.rhs())>;
+                constexpr bool subtract = IsSum<E>::subtract;
+
+                if constexpr (ProductTerm<R>::value)
+                {
+                    // dst = lhs, then dst += (+/-) alpha * product
+                    const auto& product = ProductTerm<R>::product(expr.rhs());
+                    if (!product.aliases(dst, count))
+                    {
+                        const T alpha = ProductTerm<R>::alpha(expr.rhs());
+                        evaluate<D>(expr.lhs(), dst);
+                        product.template evaluateInto<D>(dst, subtract ? T(-alpha) : alpha, T(1));
+                        return;
+                    }
+                }
+                else if constexpr (ProductTerm<L>::value)
+                {
+                    // dst = (+/-) rhs, then dst += alpha * product
+                    const auto& product = ProductTerm<L>::product(expr.lhs());
+                    if (!product.aliases(dst, count))
+                    {
+                        if constexpr (subtract)
+                            evaluate<D>(Negate<R>(expr.rhs()), dst);
+                        else
+                            evaluate<D>(expr.rhs(), dst);
+                        product.template evaluateInto<D>(dst, ProductTerm<L>::alpha(expr.lhs()), T(1));
+                        return;
+                    }
+                }
+            }
+
+            // Released on every exit, so that no product keeps serving a result computed from older operands
+            struct Release
+            {
+                const E& expr;
+                ~Release() { expr.release(); }
+            } release{ expr };
+            expr.prepare();
+            if constexpr (E::template storedAs<D>)
+            {
+                for (size_t i = 0; i < count; ++i)
+                    dst[i] = expr[i];
+            }
+            else
+            {
+                Scratch<T, count> copy;
+                T* out = expr.aliases(dst, count) ? copy.get() : dst;
+                for (size_t i = 0; i < E::rows; ++i)
+                {
+                    for (size_t j = 0; j < E::cols; ++j)
+                        out[D::index(i, j, E::rows, E::cols)] = expr.at(i, j);
+                }
+                if (out != dst)
+                    std::copy(out, out + count, dst);
+            }
+        }
+
+        /**
+         * @brief Wraps a container into a Terminal, expressions are returned unchanged.
+         */
+        template<typename X>
+        auto wrap(const X& operand)
+        {
+            if constexpr (Expression<X>)
+                return operand;
+            else
+                return Terminal<X>(operand);
+        }
+
+        template<typename X>
+        using wrapped = decltype(wrap(std::declval<const X&>()));
+    }
+
+    /**
+     * @brief Evaluates an expression into a new myMatrix or myVectorND.
+     * @param expr The expression.
+     * @return The materialised result.
+     */
+    template<expr::Expression E>
+    typename E::result_type eval(const E& expr)
+    {
+        return typename E::result_type(expr);
+    }
+};
+
+/**
+ * @brief Element-wise sum of two matrices, vectors or expressions of the same shape.
+ */
+template<glg::expr::Operand L, glg::expr::Operand R>
+auto operator+(const L& lhs, const R& rhs)
+{
+    using namespace glg::expr;
+    return Binary<wrapped<L>, wrapped<R>, std::plus<>>(wrap(lhs), wrap(rhs));
+}
+
+/**
+ * @brief Element-wise difference lhs - rhs of two matrices, vectors or expressions of the same shape.
+ */
+template<glg::expr::Operand L, glg::expr::Operand R>
+auto operator-(const L& lhs, const R& rhs)
+{
+    using namespace glg::expr;
+    return Binary<wrapped<L>, wrapped<R>, std::minus<>>(wrap(lhs), wrap(rhs));
+}
+
+template<glg::expr::Operand E>
+auto operator-(const E& operand)
+{
+    using namespace glg::expr;
+    return Negate<wrapped<E>>(wrap(operand));
+}
+
+/**
+ * @brief Matrix product, a myVectorND on the right being an N x 1 column.
+ */
+template<glg::expr::Operand L, glg::expr::Operand R>
+auto operator*(const L& lhs, const R& rhs)
+{
+    using namespace glg::expr;
+    return Product<wrapped<L>, wrapped<R>>(wrap(lhs), wrap(rhs));
+}
+
+template<glg::expr::Operand E, glg::expr::Scalar S>
+auto operator*(const E& operand, const S& scalar)
+{
+    using namespace glg::expr;
+    return ScalarOp<wrapped<E>, S, std::multiplies<>>(wrap(operand), scalar);
+}
+
+template<glg::expr::Scalar S, glg::expr::Operand E>
+auto operator*(const S& scalar, const E& operand)
+{
+    return operand * scalar;
+}
+
+/**
+ * @brief Element-wise division by a scalar.
+ * @throw std::runtime_error if scalar is 0.
+ */
+template<glg::expr::Operand E, glg::expr::Scalar S>
+auto operator/(const E& operand, const S& scalar)
+{
+    using namespace glg::expr;
+    if (scalar == S(0))
+        throw std::runtime_error("cannot divide by 0");
+
+    return ScalarOp<wrapped<E>, S, std::divides<>>(wrap(operand), scalar);
+}
+
+/**
+ * @brief Stream insertion operator for expressions, the expression is evaluated first.
+ */
+template<glg::expr::Expression E>
+std::ostream& operator<<(std::ostream& os, const E& expr)
+{
+    return os << glg::eval(expr);
+}
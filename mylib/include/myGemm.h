@@ -0,0 +1,719 @@
+/**
+ * @file myGemm.h
+ * @brief Implementation of a packed, cache-blocked general matrix multiplication (GEMM).
+ * @author Guillaume
+ * @date 18/10/2026
+ *
+ * C = alpha * A * B + beta * C, with every operand described by a pointer and
+ * a row/column stride, so the same kernel serves row-major, column-major and
+ * transposed operands. float and double go through the classic three-level
+ * blocking (NC columns of B, KC-deep panels, MC rows of A), both operands are
+ * packed into contiguous micro-panels and an MR x NR register tile is
+ * computed by the micro-kernel (AVX2/FMA when available). Other element types
+ * use a straightforward blocked loop.
+ *
+ * Large products are spread over a glg::ThreadPool: every KC x NC panel of B
+ * is packed once, cooperatively, and shared by the threads, which each pack
+ * their own MC x KC blocks of A and compute disjoint tiles of C.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "cpuInfo.h"
+#include "myThreadPool.h"
+#include "simdConfig.h"
+
+namespace Math
+{
+    namespace detail
+    {
+        /**
+         * @brief Growable 64-byte aligned scratch buffer for trivial types, reused between calls.
+         * @tparam T Element type.
+         */
+        template<typename T>
+        struct AlignedBuffer
+        {
+            AlignedBuffer() = default;
+            AlignedBuffer(const AlignedBuffer&) = delete;
+            AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+            ~AlignedBuffer()
+            {
+                release();
+            }
+
+            /**
+             * @brief Returns storage for at least count elements (the content is not preserved).
+             * @param count Number of elements needed.
+             * @return Pointer to the aligned storage.
+             */
+            T* get(size_t count)
+            {
+                if (count > m_capacity)
+                {
+                    release();
+                    m_data = static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{ 64 }));
+                    m_capacity = count;
+                }
+                return m_data;
+            }
+
+        private:
+            void release()
+            {
+                if (m_data)
+                    ::operator delete(m_data, std::align_val_t{ 64 });
+                m_data = nullptr;
+                m_capacity = 0;
+            }
+
+            T* m_data = nullptr;    ///< Aligned storage
+            size_t m_capacity = 0;  ///< Number of elements the storage can hold
+        };
+
+        /**
+         * @brief Register blocking of the packed GEMM for one element type: MR x NR is the
+         * tile of C held in registers by the micro-kernel. The cache blocking depends on
+         * the machine, see gemmBlockSizes().
+         */
+        template<typename T>
+        struct GemmBlocking
+        {
+            static constexpr bool packed = false;
+        };
+
+#if GLG_HAS_AVX2 && GLG_HAS_FMA
+        template<>
+        struct GemmBlocking<float>
+        {
+            static constexpr bool packed = true;
+            static constexpr size_t MR = 6;
+            static constexpr size_t NR = 16;
+        };
+
+        template<>
+        struct GemmBlocking<double>
+        {
+            static constexpr bool packed = true;
+            static constexpr size_t MR = 6;
+            static constexpr size_t NR = 8;
+        };
+
+        /**
+         * @brief Thin wrappers over the AVX2 intrinsics, so one micro-kernel serves float and double.
+         */
+        template<typename T>
+        struct SimdTraits;
+
+        template<>
+        struct SimdTraits<float>
+        {
+            using reg = __m256;
+            static constexpr size_t lanes = 8;
+            static reg zero() { return _mm256_setzero_ps(); }
+            static reg set1(float value) { return _mm256_set1_ps(value); }
+            static reg load(const float* src) { return _mm256_load_ps(src); }
+            static reg loadu(const float* src) { return _mm256_loadu_ps(src); }
+            static void storeu(float* dst, reg value) { _mm256_storeu_ps(dst, value); }
+            static reg broadcast(const float* src) { return _mm256_broadcast_ss(src); }
+            static reg add(reg lhs, reg rhs) { return _mm256_add_ps(lhs, rhs); }
+            static reg mul(reg lhs, reg rhs) { return _mm256_mul_ps(lhs, rhs); }
+            static reg fmadd(reg lhs, reg rhs, reg acc) { return _mm256_fmadd_ps(lhs, rhs, acc); }
+        };
+
+        template<>
+        struct SimdTraits<double>
+        {
+            using reg = __m256d;
+            static constexpr size_t lanes = 4;
+            static reg zero() { return _mm256_setzero_pd(); }
+            static reg set1(double value) { return _mm256_set1_pd(value); }
+            static reg load(const double* src) { return _mm256_load_pd(src); }
+            static reg loadu(const double* src) { return _mm256_loadu_pd(src); }
+            static void storeu(double* dst, reg value) { _mm256_storeu_pd(dst, value); }
+            static reg broadcast(const double* src) { return _mm256_broadcast_sd(src); }
+            static reg add(reg lhs, reg rhs) { return _mm256_add_pd(lhs, rhs); }
+            static reg mul(reg lhs, reg rhs) { return _mm256_mul_pd(lhs, rhs); }
+            static reg fmadd(reg lhs, reg rhs, reg acc) { return _mm256_fmadd_pd(lhs, rhs, acc); }
+        };
+#else
+        template<>
+        struct GemmBlocking<float>
+        {
+            static constexpr bool packed = true;
+            static constexpr size_t MR = 4;
+            static constexpr size_t NR = 8;
+        };
+
+        template<>
+        struct GemmBlocking<double>
+        {
+            static constexpr bool packed = true;
+            static constexpr size_t MR = 4;
+            static constexpr size_t NR = 4;
+        };
+#endif
+
+        /**
+         * @brief Cache blocking of the packed GEMM: MC x KC block of A, KC x NC panel of B.
+         */
+        struct GemmBlockSizes
+        {
+            size_t mc; ///< Rows of the packed block of A, a multiple of MR
+            size_t kc; ///< Depth of the packed block of A and panel of B
+            size_t nc; ///< Columns of the packed panel of B, a multiple of NR
+        };
+
+        /**
+         * @brief Chooses the cache blocking from the cache sizes of the machine, once per type.
+         * An NR-wide micro-panel of B stays in half of L1, the block of A in half of L2 and
+         * the panel of B, shared by every thread, in half of L3.
+         */
+        template<typename T>
+        const GemmBlockSizes& gemmBlockSizes()
+        {
+            static const GemmBlockSizes sizes = []
+            {
+                constexpr size_t MR = GemmBlocking<T>::MR;
+                constexpr size_t NR = GemmBlocking<T>::NR;
+                const glg::CacheInfo& cache = glg::cacheInfo();
+
+                GemmBlockSizes result;
+                result.kc = std::clamp<size_t>(cache.l1 / 2 / (NR * sizeof(T)), 128, 512) / 8 * 8;
+                result.mc = std::clamp<size_t>(cache.l2 / 2 / (result.kc * sizeof(T)), 4 * MR, 1024) / MR * MR;
+                result.nc = std::clamp<size_t>(cache.l3 / 2 / (result.kc * sizeof(T)), 16 * NR, 8192) / NR * NR;
+                return result;
+            }();
+            return sizes;
+        }
+
+        /**
+         * @brief Packs an mc x kc block of A into MR-tall row panels, each stored column by column.
+         * Rows past mc are zero padded so the micro-kernel never needs a bound check.
+         */
+        template<typename T, size_t MR>
+        void packA(size_t mc, size_t kc, const T* a, size_t rowStride, size_t colStride, T* dst)
+        {
+            for (size_t i = 0; i < mc; i += MR)
+            {
+                const size_t mr = std::min(MR, mc - i);
+                const T* src = a + i * rowStride;
+                for (size_t p = 0; p < kc; ++p)
+                {
+                    for (size_t r = 0; r < mr; ++r)
+                        dst[r] = src[r * rowStride + p * colStride];
+                    for (size_t r = mr; r < MR; ++r)
+                        dst[r] = T{};
+                    dst += MR;
+                }
+            }
+        }
+
+        /**
+         * @brief Packs a kc x nc panel of B into NR-wide column panels, each stored row by row.
+         * Columns past nc are zero padded.
+         */
+        template<typename T, size_t NR>
+        void packB(size_t kc, size_t nc, const T* b, size_t rowStride, size_t colStride, T* dst)
+        {
+            for (size_t j = 0; j < nc; j += NR)
+            {
+                const size_t nr = std::min(NR, nc - j);
+                const T* src = b + j * colStride;
+                for (size_t p = 0; p < kc; ++p)
+                {
+                    const T* row = src + p * rowStride;
+                    if (colStride == 1)
+                    {
+                        for (size_t c = 0; c < nr; ++c)
+                            dst[c] = row[c];
+                    }
+                    else
+                    {
+                        for (size_t c = 0; c < nr; ++c)
+                            dst[c] = row[c * colStride];
+                    }
+                    for (size_t c = nr; c < NR; ++c)
+                        dst[c] = T{};
+                    dst += NR;
+                }
+            }
+        }
+
+        /**
+         * @brief Writes an MR x NR accumulator tile back to C: C = alpha * tile + beta * C.
+         * beta == 0 never reads C, so uninitialised or NaN outputs are overwritten cleanly.
+         */
+        template<typename T>
+        void storeTile(const T* tile, size_t tileStride, T alpha, T beta, T* c, size_t rowStride, size_t colStride, size_t mr, size_t nr)
+        {
+            for (size_t i = 0; i < mr; ++i)
+            {
+                for (size_t j = 0; j < nr; ++j)
+                {
+                    T& out = c[i * rowStride + j * colStride];
+                    const T value = alpha * tile[i * tileStride + j];
+                    out = beta == T{} ? value : value + beta * out;
+                }
+            }
+        }
+
+#if GLG_HAS_AVX2 && GLG_HAS_FMA
+        /**
+         * @brief MR x NR register-tiled micro-kernel: 12 vector accumulators, 2 loads of B
+         * and MR broadcasts of A per step of k.
+         */
+        template<typename T>
+        void microKernel(size_t kc, T alpha, const T* a, const T* b, T beta, T* c, size_t rowStride, size_t colStride, size_t mr, size_t nr)
+        {
+            using S = SimdTraits<T>;
+            using reg = typename S::reg;
+            constexpr size_t MR = GemmBlocking<T>::MR;
+            constexpr size_t NR = GemmBlocking<T>::NR;
+            constexpr size_t L = S::lanes;
+            static_assert(MR == 6 && NR == 2 * L, "the micro-kernel holds a 6 x (2 vectors) tile");
+
+            // Explicit accumulators: the 12 registers must not round-trip through memory
+            reg c00 = S::zero(), c01 = S::zero(), c10 = S::zero(), c11 = S::zero();
+            reg c20 = S::zero(), c21 = S::zero(), c30 = S::zero(), c31 = S::zero();
+            reg c40 = S::zero(), c41 = S::zero(), c50 = S::zero(), c51 = S::zero();
+
+            for (size_t p = 0; p < kc; ++p)
+            {
+                const reg b0 = S::load(b);
+                const reg b1 = S::load(b + L);
+                reg ai = S::broadcast(a);
+                c00 = S::fmadd(ai, b0, c00);
+                c01 = S::fmadd(ai, b1, c01);
+                ai = S::broadcast(a + 1);
+                c10 = S::fmadd(ai, b0, c10);
+                c11 = S::fmadd(ai, b1, c11);
+                ai = S::broadcast(a + 2);
+                c20 = S::fmadd(ai, b0, c20);
+                c21 = S::fmadd(ai, b1, c21);
+                ai = S::broadcast(a + 3);
+                c30 = S::fmadd(ai, b0, c30);
+                c31 = S::fmadd(ai, b1, c31);
+                ai = S::broadcast(a + 4);
+                c40 = S::fmadd(ai, b0, c40);
+                c41 = S::fmadd(ai, b1, c41);
+                ai = S::broadcast(a + 5);
+                c50 = S::fmadd(ai, b0, c50);
+                c51 = S::fmadd(ai, b1, c51);
+                a += MR;
+                b += NR;
+            }
+
+            const reg acc0[MR] = { c00, c10, c20, c30, c40, c50 };
+            const reg acc1[MR] = { c01, c11, c21, c31, c41, c51 };
+
+            if (mr == MR && nr == NR && colStride == 1)
+            {
+                const reg alphaV = S::set1(alpha);
+                const reg betaV = S::set1(beta);
+                for (size_t i = 0; i < MR; ++i)
+                {
+                    T* row = c + i * rowStride;
+                    reg r0 = S::mul(acc0[i], alphaV);
+                    reg r1 = S::mul(acc1[i], alphaV);
+                    if (beta != T{})
+                    {
+                        r0 = S::fmadd(S::loadu(row), betaV, r0);
+                        r1 = S::fmadd(S::loadu(row + L), betaV, r1);
+                    }
+                    S::storeu(row, r0);
+                    S::storeu(row + L, r1);
+                }
+                return;
+            }
+
+            alignas(64) T tile[MR * NR];
+            for (size_t i = 0; i < MR; ++i)
+            {
+                S::storeu(tile + i * NR, acc0[i]);
+                S::storeu(tile + i * NR + L, acc1[i]);
+            }
+            storeTile(tile, NR, alpha, beta, c, rowStride, colStride, mr, nr);
+        }
+#else
+        /**
+         * @brief Portable MR x NR micro-kernel, written so the compiler can vectorise the NR loop.
+         */
+        template<typename T>
+        void microKernel(size_t kc, T alpha, const T* a, const T* b, T beta, T* c, size_t rowStride, size_t colStride, size_t mr, size_t nr)
+        {
+            constexpr size_t MR = GemmBlocking<T>::MR;
+            constexpr size_t NR = GemmBlocking<T>::NR;
+
+            T tile[MR * NR] = {};
+            for (size_t p = 0; p < kc; ++p)
+            {
+                for (size_t i = 0; i < MR; ++i)
+                    for (size_t j = 0; j < NR; ++j)
+                        tile[i * NR + j] += a[i] * b[j];
+                a += MR;
+                b += NR;
+            }
+            storeTile(tile, NR, alpha, beta, c, rowStride, colStride, mr, nr);
+        }
+#endif
+
+        /**
+         * @brief Multiplies a packed MC x KC block of A by a packed KC x NC panel of B into C.
+         */
+        template<typename T>
+        void macroKernel(size_t mc, size_t nc, size_t kc, T alpha, const T* packedA, const T* packedB, T beta, T* c, size_t rowStride, size_t colStride)
+        {
+            constexpr size_t MR = GemmBlocking<T>::MR;
+            constexpr size_t NR = GemmBlocking<T>::NR;
+
+            for (size_t j = 0; j < nc; j += NR)
+            {
+                const size_t nr = std::min(NR, nc - j);
+                for (size_t i = 0; i < mc; i += MR)
+                {
+                    const size_t mr = std::min(MR, mc - i);
+                    microKernel<T>(kc, alpha, packedA + i * kc, packedB + j * kc, beta,
+                        c + i * rowStride + j * colStride, rowStride, colStride, mr, nr);
+                }
+            }
+        }
+
+        /**
+         * @brief C = beta * C, used when the product has no depth.
+         */
+        template<typename T>
+        void scaleMatrix(size_t m, size_t n, T beta, T* c, size_t rowStride, size_t colStride)
+        {
+            for (size_t i = 0; i < m; ++i)
+            {
+                for (size_t j = 0; j < n; ++j)
+                {
+                    T& out = c[i * rowStride + j * colStride];
+                    out = beta == T{} ? T{} : T(beta * out);
+                }
+            }
+        }
+
+        /**
+         * @brief Unpacked GEMM for small products and element types without a packed kernel.
+         * Each row of C is built in blocks of columns, streaming through rows of B.
+         */
+        template<typename T>
+        void gemmLoop(size_t m, size_t n, size_t k, T alpha,
+            const T* a, size_t rowStrideA, size_t colStrideA,
+            const T* b, size_t rowStrideB, size_t colStrideB,
+            T beta, T* c, size_t rowStrideC, size_t colStrideC)
+        {
+            using acc_type = std::remove_cvref_t<decltype(std::declval<T>() * std::declval<T>())>;
+            constexpr size_t block = 64;
+
+            acc_type acc[block];
+            for (size_t i = 0; i < m; ++i)
+            {
+                for (size_t j0 = 0; j0 < n; j0 += block)
+                {
+                    const size_t nb = std::min(block, n - j0);
+                    for (size_t j = 0; j < nb; ++j)
+                        acc[j] = acc_type{};
+
+                    for (size_t p = 0; p < k; ++p)
+                    {
+                        const acc_type aip = a[i * rowStrideA + p * colStrideA];
+                        const T* row = b + p * rowStrideB + j0 * colStrideB;
+                        for (size_t j = 0; j < nb; ++j)
+                            acc[j] += aip * row[j * colStrideB];
+                    }
+
+                    T* out = c + i * rowStrideC + j0 * colStrideC;
+                    for (size_t j = 0; j < nb; ++j)
+                    {
+                        T& cell = out[j * colStrideC];
+                        const acc_type value = alpha * acc[j];
+                        cell = beta == T{} ? T(value) : T(value + beta * cell);
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Products with fewer multiply-adds than this skip packing entirely.
+         */
+        constexpr size_t gemmPackingThreshold = 32 * 32 * 32;
+
+        /**
+         * @brief Products with at least this many multiply-adds use the global thread pool.
+         */
+        constexpr size_t gemmParallelThreshold = 192 * 192 * 192;
+
+        /**
+         * @brief Packed, cache-blocked GEMM driver, optionally spread over a thread pool.
+         *
+         * For each KC x NC panel of B, the panel is packed once (strips of NR columns are
+         * shared out between the threads) and then the MC-row blocks of C, further split
+         * into groups of NR-wide strips when there are fewer blocks than threads, are
+         * computed in parallel. Each task packs its own block of A.
+         */
+        template<typename T>
+        void gemmPacked(glg::ThreadPool* pool, size_t m, size_t n, size_t k, T alpha,
+            const T* a, size_t rowStrideA, size_t colStrideA,
+            const T* b, size_t rowStrideB, size_t colStrideB,
+            T beta, T* c, size_t rowStrideC, size_t colStrideC)
+        {
+            constexpr size_t MR = GemmBlocking<T>::MR;
+            constexpr size_t NR = GemmBlocking<T>::NR;
+            const GemmBlockSizes& blocks = gemmBlockSizes<T>();
+            const size_t threads = pool ? pool->size() : 1;
+
+            auto forEach = [pool](size_t count, auto&& body)
+            {
+                if (pool)
+                    pool->run(count, body);
+                else
+                    for (size_t i = 0; i < count; ++i)
+                        body(i);
+            };
+
+            // The packed panel belongs to this call: while it waits for its tasks, this thread may run
+            // tasks of other jobs, and a GEMM among them must not repack over it
+            AlignedBuffer<T> panelBuffer;
+            const size_t panelWidth = (std::min(blocks.nc, n) + NR - 1) / NR * NR;
+            T* packedB = panelBuffer.get(blocks.kc * panelWidth);
+
+            for (size_t jc = 0; jc < n; jc += blocks.nc)
+            {
+                const size_t nc = std::min(blocks.nc, n - jc);
+                const size_t strips = (nc + NR - 1) / NR;
+
+                for (size_t pc = 0; pc < k; pc += blocks.kc)
+                {
+                    const size_t kc = std::min(blocks.kc, k - pc);
+                    const T betaPanel = pc == 0 ? beta : T(1);
+                    const T* panelB = b + pc * rowStrideB + jc * colStrideB;
+
+                    const size_t packGroups = std::min(strips, threads);
+                    forEach(packGroups, [&](size_t group)
+                    {
+                        const size_t first = strips * group / packGroups;
+                        const size_t last = strips * (group + 1) / packGroups;
+                        const size_t width = std::min(last * NR, nc) - first * NR;
+                        packB<T, NR>(kc, width, panelB + first * NR * colStrideB, rowStrideB, colStrideB, packedB + first * NR * kc);
+                    });
+
+                    const size_t rowBlocks = (m + blocks.mc - 1) / blocks.mc;
+                    const size_t columnGroups = threads == 1 ? 1 : std::clamp<size_t>((2 * threads + rowBlocks - 1) / rowBlocks, 1, strips);
+
+                    forEach(rowBlocks * columnGroups, [&](size_t task)
+                    {
+                        const size_t ic = task / columnGroups * blocks.mc;
+                        const size_t group = task % columnGroups;
+                        const size_t mc = std::min(blocks.mc, m - ic);
+                        const size_t first = strips * group / columnGroups;
+                        const size_t last = strips * (group + 1) / columnGroups;
+                        if (first == last)
+                            return;
+
+                        thread_local AlignedBuffer<T> blockBuffer;
+                        T* packedA = blockBuffer.get(blocks.mc * blocks.kc);
+                        packA<T, MR>(mc, kc, a + ic * rowStrideA + pc * colStrideA, rowStrideA, colStrideA, packedA);
+
+                        const size_t column = first * NR;
+                        const size_t width = std::min(last * NR, nc) - column;
+                        macroKernel<T>(mc, width, kc, alpha, packedA, packedB + column * kc, betaPanel,
+                            c + ic * rowStrideC + (jc + column) * colStrideC, rowStrideC, colStrideC);
+                    });
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief General matrix multiplication: C = alpha * A * B + beta * C.
+     *
+     * Element (i, j) of a matrix X lives at X[i * rowStride + j * colStride], so a
+     * row-major matrix has (width, 1) strides and a transposed view simply swaps
+     * them. C must not overlap A or B. When beta is zero C is only written.
+     *
+     * @tparam T Element type.
+     * @param m Number of rows of A and C.
+     * @param n Number of columns of B and C.
+     * @param k Number of columns of A and rows of B.
+     * @param alpha Scale of the product.
+     * @param a First element of A.
+     * @param rowStrideA Distance between two rows of A.
+     * @param colStrideA Distance between two columns of A.
+     * @param b First element of B.
+     * @param rowStrideB Distance between two rows of B.
+     * @param colStrideB Distance between two columns of B.
+     * @param beta Scale of the previous content of C.
+     * @param c First element of C.
+     * @param rowStrideC Distance between two rows of C.
+     * @param colStrideC Distance between two columns of C.
+     */
+    template<typename T>
+    void gemm(size_t m, size_t n, size_t k, T alpha,
+        const T* a, size_t rowStrideA, size_t colStrideA,
+        const T* b, size_t rowStrideB, size_t colStrideB,
+        T beta, T* c, size_t rowStrideC, size_t colStrideC)
+    {
+        if (m == 0 || n == 0)
+            return;
+
+        if (k == 0 || alpha == T{})
+        {
+            detail::scaleMatrix(m, n, beta, c, rowStrideC, colStrideC);
+            return;
+        }
+
+        using Blocking = detail::GemmBlocking<T>;
+        if constexpr (!Blocking::packed)
+        {
+            detail::gemmLoop(m, n, k, alpha, a, rowStrideA, colStrideA, b, rowStrideB, colStrideB, beta, c, rowStrideC, colStrideC);
+        }
+        else
+        {
+            if (m * n * k < detail::gemmPackingThreshold)
+            {
+                detail::gemmLoop(m, n, k, alpha, a, rowStrideA, colStrideA, b, rowStrideB, colStrideB, beta, c, rowStrideC, colStrideC);
+                return;
+            }
+
+            glg::ThreadPool* pool = m * n * k >= detail::gemmParallelThreshold ? &glg::ThreadPool::global() : nullptr;
+            detail::gemmPacked(pool, m, n, k, alpha, a, rowStrideA, colStrideA, b, rowStrideB, colStrideB, beta, c, rowStrideC, colStrideC);
+        }
+    }
+
+    /**
+     * @brief General matrix multiplication on an explicit thread pool: C = alpha * A * B + beta * C.
+     * Same contract as gemm(), every packed product is spread over the threads of pool.
+     *
+     * @param pool Pool running the product (a pool of size 1 runs it on the calling thread).
+     * @see gemm()
+     */
+    template<typename T>
+    void gemm(glg::ThreadPool& pool, size_t m, size_t n, size_t k, T alpha,
+        const T* a, size_t rowStrideA, size_t colStrideA,
+        const T* b, size_t rowStrideB, size_t colStrideB,
+        T beta, T* c, size_t rowStrideC, size_t colStrideC)
+    {
+        if constexpr (detail::GemmBlocking<T>::packed)
+        {
+            if (m != 0 && n != 0 && k != 0 && alpha != T{} && m * n * k >= detail::gemmPackingThreshold)
+            {
+                detail::gemmPacked(&pool, m, n, k, alpha, a, rowStrideA, colStrideA, b, rowStrideB, colStrideB, beta, c, rowStrideC, colStrideC);
+                return;
+            }
+        }
+        gemm(m, n, k, alpha, a, rowStrideA, colStrideA, b, rowStrideB, colStrideB, beta, c, rowStrideC, colStrideC);
+    }
+
+    namespace detail
+    {
+#if GLG_HAS_SSE2
+        /**
+         * @brief C = A * B for a rows x 4 float A and a 4 x 4 float B: the rows of B stay in
+         * registers and every row of C is a combination of them (4x4 transforms, point batches).
+         */
+        inline void gemmRows4x4(const float* a, const float* b, float* c, size_t rows)
+        {
+            const __m128 b0 = _mm_loadu_ps(b);
+            const __m128 b1 = _mm_loadu_ps(b + 4);
+            const __m128 b2 = _mm_loadu_ps(b + 8);
+            const __m128 b3 = _mm_loadu_ps(b + 12);
+            for (size_t i = 0; i < rows; ++i, a += 4, c += 4)
+            {
+#if GLG_HAS_FMA
+                __m128 row = _mm_mul_ps(_mm_set1_ps(a[0]), b0);
+                row = _mm_fmadd_ps(_mm_set1_ps(a[1]), b1, row);
+                row = _mm_fmadd_ps(_mm_set1_ps(a[2]), b2, row);
+                row = _mm_fmadd_ps(_mm_set1_ps(a[3]), b3, row);
+#else
+                __m128 row = _mm_mul_ps(_mm_set1_ps(a[0]), b0);
+                row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[1]), b1));
+                row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[2]), b2));
+                row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[3]), b3));
+#endif
+                _mm_storeu_ps(c, row);
+            }
+        }
+#endif
+    }
+
+    /**
+     * @brief Product of contiguous row-major matrices with compile-time dimensions: C = A * B.
+     * Small products run a loop the compiler can fully unroll, larger ones go to gemm().
+     *
+     * @tparam T Element type.
+     * @tparam M Number of rows of A and C.
+     * @tparam N Number of columns of B and C.
+     * @tparam K Number of columns of A and rows of B.
+     * @param a First element of A (M x K).
+     * @param b First element of B (K x N).
+     * @param c First element of C (M x N), must not overlap A or B.
+     */
+    template<typename T, size_t M, size_t N, size_t K>
+    void gemmFixed(const T* a, const T* b, T* c)
+    {
+#if GLG_HAS_SSE2
+        if constexpr (std::is_same_v<T, float> && N == 4 && K == 4)
+        {
+            detail::gemmRows4x4(a, b, c, M);
+            return;
+        }
+#endif
+        if constexpr (M * N * K < detail::gemmPackingThreshold && N <= 64)
+        {
+#if GLG_HAS_AVX2 && GLG_HAS_FMA
+            if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+            {
+                // Each output row is built lane by lane, one broadcast of A per step of k
+                using S = detail::SimdTraits<T>;
+                constexpr size_t L = S::lanes;
+                constexpr size_t vectorWidth = N / L * L;
+                for (size_t i = 0; i < M; ++i)
+                {
+                    const T* rowA = a + i * K;
+                    T* rowC = c + i * N;
+                    for (size_t j = 0; j < vectorWidth; j += L)
+                    {
+                        typename S::reg acc = S::zero();
+                        for (size_t p = 0; p < K; ++p)
+                            acc = S::fmadd(S::broadcast(rowA + p), S::loadu(b + p * N + j), acc);
+                        S::storeu(rowC + j, acc);
+                    }
+                    for (size_t j = vectorWidth; j < N; ++j)
+                    {
+                        T sum = T(0);
+                        for (size_t p = 0; p < K; ++p)
+                            sum += rowA[p] * b[p * N + j];
+                        rowC[j] = sum;
+                    }
+                }
+                return;
+            }
+#endif
+            using acc_type = std::remove_cvref_t<decltype(std::declval<T>() * std::declval<T>())>;
+            for (size_t i = 0; i < M; ++i)
+            {
+                acc_type row[N] = {};
+                for (size_t p = 0; p < K; ++p)
+                {
+                    const acc_type aip = a[i * K + p];
+                    for (size_t j = 0; j < N; ++j)
+                        row[j] += aip * b[p * N + j];
+                }
+                for (size_t j = 0; j < N; ++j)
+                    c[i * N + j] = T(row[j]);
+            }
+        }
+        else
+        {
+            gemm<T>(M, N, K, T(1), a, K, 1, b, N, 1, T(0), c, N, 1);
+        }
+    }
+};
\ No newline at end of file
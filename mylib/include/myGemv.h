@@ -0,0 +1,250 @@
+/**
+ * @file myGemv.h
+ * @brief Implementation of the general matrix-vector product (GEMV): y = alpha * A * x + beta * y.
+ * @author Guillaume
+ * @date 18/10/2026
+ *
+ * A matrix-vector product reads every element of A once, so it is bound by
+ * memory, not by arithmetic: the kernels only make sure A is streamed
+ * contiguously. When the rows of A are contiguous, four rows are reduced at
+ * once against the same loads of x. When the columns are contiguous (A is
+ * a transposed row-major matrix), y is updated with four rows of A at a
+ * time instead, so the product never walks A with a stride.
+ *
+ * Large products are split over the global glg::ThreadPool, by rows of A
+ * in the first case and by elements of y in the second.
+ */
+
+#pragma once
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include "myGemm.h"
+#include "myLayout.h"
+#include "myMatrixView.h"
+#include "myThreadPool.h"
+#include "simdConfig.h"
+
+template<typename type, size_t size>
+struct myVectorND;
+
+namespace Math
+{
+    namespace detail
+    {
+        /** Products reading fewer elements of A than this run on the calling thread. */
+        constexpr size_t gemvParallelThreshold = 1 << 18;
+
+        /**
+         * @brief y[i] = alpha * A(i, :) . x + beta * y[i] for rows [first, last), the rows of A being contiguous.
+         */
+        template<typename T>
+        void gemvRows(size_t first, size_t last, size_t n, T alpha, const T* a, size_t rowStride, const T* x, T beta, T* y, size_t incY)
+        {
+            size_t i = first;
+#if GLG_HAS_AVX2 && GLG_HAS_FMA
+            if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+            {
+                using S = SimdTraits<T>;
+                constexpr size_t L = S::lanes;
+                const size_t vectorWidth = n / L * L;
+
+                // Four rows share every load of x
+                for (; i + 4 <= last; i += 4)
+                {
+                    const T* a0 = a + i * rowStride;
+                    const T* a1 = a0 + rowStride;
+                    const T* a2 = a1 + rowStride;
+                    const T* a3 = a2 + rowStride;
+                    typename S::reg acc0 = S::zero(), acc1 = S::zero(), acc2 = S::zero(), acc3 = S::zero();
+                    for (size_t j = 0; j < vectorWidth; j += L)
+                    {
+                        const typename S::reg xj = S::loadu(x + j);
+                        acc0 = S::fmadd(S::loadu(a0 + j), xj, acc0);
+                        acc1 = S::fmadd(S::loadu(a1 + j), xj, acc1);
+                        acc2 = S::fmadd(S::loadu(a2 + j), xj, acc2);
+                        acc3 = S::fmadd(S::loadu(a3 + j), xj, acc3);
+                    }
+
+                    alignas(32) T sums[4][L];
+                    S::storeu(sums[0], acc0);
+                    S::storeu(sums[1], acc1);
+                    S::storeu(sums[2], acc2);
+                    S::storeu(sums[3], acc3);
+                    const T* rows[4] = { a0, a1, a2, a3 };
+                    for (size_t r = 0; r < 4; ++r)
+                    {
+                        T sum = T(0);
+                        for (size_t lane = 0; lane < L; ++lane)
+                            sum += sums[r][lane];
+                        for (size_t j = vectorWidth; j < n; ++j)
+                            sum += rows[r][j] * x[j];
+
+                        T& out = y[(i + r) * incY];
+                        out = beta == T(0) ? alpha * sum : alpha * sum + beta * out;
+                    }
+                }
+            }
+#endif
+            for (; i < last; ++i)
+            {
+                const T* row = a + i * rowStride;
+                T sum = T(0);
+                for (size_t j = 0; j < n; ++j)
+                    sum += row[j] * x[j];
+
+                T& out = y[i * incY];
+                out = beta == T(0) ? alpha * sum : alpha * sum + beta * out;
+            }
+        }
+
+        /**
+         * @brief y[first, last) += sum over i of s[i] * B(i, first..last), B being m x n row-major: y += B^T s.
+         */
+        template<typename T>
+        void gemvColumns(size_t first, size_t last, size_t m, const T* b, size_t rowStride, const T* s, T* y)
+        {
+            size_t i = 0;
+            for (; i + 4 <= m; i += 4)
+            {
+                const T s0 = s[i], s1 = s[i + 1], s2 = s[i + 2], s3 = s[i + 3];
+                const T* b0 = b + i * rowStride;
+                const T* b1 = b0 + rowStride;
+                const T* b2 = b1 + rowStride;
+                const T* b3 = b2 + rowStride;
+                size_t j = first;
+#if GLG_HAS_AVX2 && GLG_HAS_FMA
+                if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+                {
+                    using S = SimdTraits<T>;
+                    const typename S::reg v0 = S::set1(s0), v1 = S::set1(s1), v2 = S::set1(s2), v3 = S::set1(s3);
+                    for (; j + S::lanes <= last; j += S::lanes)
+                    {
+                        typename S::reg acc = S::loadu(y + j);
+                        acc = S::fmadd(v0, S::loadu(b0 + j), acc);
+                        acc = S::fmadd(v1, S::loadu(b1 + j), acc);
+                        acc = S::fmadd(v2, S::loadu(b2 + j), acc);
+                        acc = S::fmadd(v3, S::loadu(b3 + j), acc);
+                        S::storeu(y + j, acc);
+                    }
+                }
+#endif
+                for (; j < last; ++j)
+                    y[j] += s0 * b0[j] + s1 * b1[j] + s2 * b2[j] + s3 * b3[j];
+            }
+            for (; i < m; ++i)
+            {
+                const T* row = b + i * rowStride;
+                for (size_t j = first; j < last; ++j)
+                    y[j] += s[i] * row[j];
+            }
+        }
+    }
+
+    /**
+     * @brief General matrix-vector product: y = alpha * A * x + beta * y.
+     * With beta == 0, y is not read (it may hold NaN or garbage).
+     *
+     * @tparam T Element type.
+     * @param m Number of rows of A and elements of y.
+     * @param n Number of columns of A and elements of x.
+     * @param alpha Scale of the product.
+     * @param a First element of A.
+     * @param rowStrideA Distance between two rows of A.
+     * @param colStrideA Distance between two columns of A.
+     * @param x First element of x.
+     * @param incX Distance between two elements of x.
+     * @param beta Scale of the previous content of y.
+     * @param y First element of y, it must not overlap A or x.
+     * @param incY Distance between two elements of y.
+     */
+    template<typename T>
+    void gemv(size_t m, size_t n, T alpha, const T* a, size_t rowStrideA, size_t colStrideA,
+        const T* x, size_t incX, T beta, T* y, size_t incY)
+    {
+        if (m == 0)
+            return;
+
+        const bool parallel = m * n >= detail::gemvParallelThreshold;
+        if (colStrideA == 1 && incX == 1)
+        {
+            const auto rows = [&](size_t first, size_t last) { detail::gemvRows(first, last, n, alpha, a, rowStrideA, x, beta, y, incY); };
+            if (parallel)
+                glg::ThreadPool::global().parallelFor(0, m, 64, rows);
+            else
+                rows(0, m);
+            return;
+        }
+
+        if (rowStrideA == 1 && incY == 1)
+        {
+            // A^T is a row-major n x m matrix B: y = alpha * B^T x + beta * y
+            detail::AlignedBuffer<T> scaled;
+            T* s = scaled.get(n);
+            for (size_t i = 0; i < n; ++i)
+                s[i] = alpha * x[i * incX];
+
+            const auto columns = [&](size_t first, size_t last)
+            {
+                for (size_t j = first; j < last; ++j)
+                    y[j] = beta == T(0) ? T(0) : beta * y[j];
+                detail::gemvColumns(first, last, n, a, colStrideA, s, y);
+            };
+            if (parallel)
+                glg::ThreadPool::global().parallelFor(0, m, 256, columns);
+            else
+                columns(0, m);
+            return;
+        }
+
+        for (size_t i = 0; i < m; ++i)
+        {
+            T sum = T(0);
+            for (size_t j = 0; j < n; ++j)
+                sum += a[i * rowStrideA + j * colStrideA] * x[j * incX];
+
+            T& out = y[i * incY];
+            out = beta == T(0) ? alpha * sum : alpha * sum + beta * out;
+        }
+    }
+
+    /**
+     * @brief y = alpha * A * x + beta * y on a view (a block, a transposed matrix...).
+     * @throw std::invalid_argument if the sizes do not match.
+     */
+    template<typename T>
+    void gemv(T alpha, std::type_identity_t<myMatrixView<const T>> a, std::span<const T> x, T beta, std::span<T> y)
+    {
+        if (a.cols() != x.size() || a.rows() != y.size())
+            throw std::invalid_argument("size must be equal");
+
+        gemv<T>(a.rows(), a.cols(), alpha, a.data(), a.rowStride(), a.colStride(), x.data(), 1, beta, y.data(), 1);
+    }
+
+    /**
+     * @brief y = alpha * A * x + beta * y, A being row-major or column-major.
+     * @throw std::invalid_argument if y is x.
+     */
+    template<typename T, size_t H, size_t W, typename L> requires L::strided
+    void gemv(T alpha, const myMatrix<T, H, W, L>& a, const myVectorND<T, W>& x, T beta, myVectorND<T, H>& y)
+    {
+        if (static_cast<const void*>(x.data()) == static_cast<const void*>(y.data()))
+            throw std::invalid_argument("result must not alias an operand");
+
+        gemv<T>(H, W, alpha, a.data(), L::rowStride(H, W), L::colStride(H, W), x.data(), 1, beta, y.data(), 1);
+    }
+
+    /**
+     * @brief y = alpha * A^T * x + beta * y, without transposing A.
+     * @throw std::invalid_argument if y is x.
+     */
+    template<typename T, size_t H, size_t W, typename L> requires L::strided
+    void gemvTransposed(T alpha, const myMatrix<T, H, W, L>& a, const myVectorND<T, H>& x, T beta, myVectorND<T, W>& y)
+    {
+        if (static_cast<const void*>(x.data()) == static_cast<const void*>(y.data()))
+            throw std::invalid_argument("result must not alias an operand");
+
+        gemv<T>(W, H, alpha, a.data(), L::colStride(H, W), L::rowStride(H, W), x.data(), 1, beta, y.data(), 1);
+    }
+};
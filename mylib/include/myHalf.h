@@ -0,0 +1,413 @@
+/**
+ * @file myHalf.h
+ * @brief Implementation of 16-bit floating point storage types (IEEE half and bfloat16).
+ * @author Guillaume
+ * @date 18/10/2026
+ *
+ * Both types only store 16 bits and compute in float: every arithmetic
+ * operation converts to float, so they can be used as the element type of
+ * myArray, myVectorND or myMatrix to halve the memory traffic of a container.
+ */
+
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+#include "simdConfig.h"
+
+namespace glg
+{
+    /**
+     * @brief Converts a float to the bits of an IEEE 754 half (round to nearest even).
+     * @param value The float to convert.
+     * @return The 16 bits of the half.
+     */
+    inline std::uint16_t floatToHalfBits(float value)
+    {
+#if GLG_HAS_F16C
+        return static_cast<std::uint16_t>(_cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT));
+#else
+        const std::uint32_t infinity = 255u << 23;
+        const std::uint32_t halfMax = (127u + 16u) << 23;
+        const std::uint32_t denormMagic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+        std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+        const std::uint32_t sign = bits & 0x80000000u;
+        bits ^= sign;
+
+        std::uint32_t result;
+        if (bits >= halfMax)
+        {
+            // Overflow to infinity, NaN stays a quiet NaN
+            result = bits > infinity ? 0x7e00u : 0x7c00u;
+        }
+        else if (bits < (113u << 23))
+        {
+            // Subnormal or zero: let the FPU do the rounding
+            const float shifted = std::bit_cast<float>(bits) + std::bit_cast<float>(denormMagic);
+            result = std::bit_cast<std::uint32_t>(shifted) - denormMagic;
+        }
+        else
+        {
+            const std::uint32_t mantissaOdd = (bits >> 13) & 1u;
+            bits += ((15u - 127u) << 23) + 0xfffu;
+            bits += mantissaOdd;
+            result = bits >> 13;
+        }
+
+        return static_cast<std::uint16_t>(result | (sign >> 16));
+#endif
+    }
+
+    /**
+     * @brief Converts the bits of an IEEE 754 half to a float.
+     * @param bits The 16 bits of the half.
+     * @return The float value (exact, every half is representable).
+     */
+    inline float halfBitsToFloat(std::uint16_t bits)
+    {
+#if GLG_HAS_F16C
+        return _cvtsh_ss(bits);
+#else
+        const std::uint32_t shiftedExponent = 0x7c00u << 13;
+
+        std::uint32_t result = (bits & 0x7fffu) << 13;
+        const std::uint32_t exponent = shiftedExponent & result;
+        result += (127u - 15u) << 23;
+
+        if (exponent == shiftedExponent)
+        {
+            // Infinity or NaN
+            result += (128u - 16u) << 23;
+        }
+        else if (exponent == 0)
+        {
+            // Zero or subnormal: renormalise
+            result += 1u << 23;
+            result = std::bit_cast<std::uint32_t>(std::bit_cast<float>(result) - std::bit_cast<float>(113u << 23));
+        }
+
+        result |= static_cast<std::uint32_t>(bits & 0x8000u) << 16;
+        return std::bit_cast<float>(result);
+#endif
+    }
+
+    /**
+     * @brief Converts a float to the bits of a bfloat16 (round to nearest even).
+     * @param value The float to convert.
+     * @return The 16 bits of the bfloat16.
+     */
+    inline std::uint16_t floatToBfloat16Bits(float value)
+    {
+        const std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+        if ((bits & 0x7fffffffu) > 0x7f800000u)
+            return static_cast<std::uint16_t>((bits >> 16) | 0x0040u);
+
+        const std::uint32_t rounding = 0x7fffu + ((bits >> 16) & 1u);
+        return static_cast<std::uint16_t>((bits + rounding) >> 16);
+    }
+
+    /**
+     * @brief Converts the bits of a bfloat16 to a float.
+     * @param bits The 16 bits of the bfloat16.
+     * @return The float value (exact).
+     */
+    inline float bfloat16BitsToFloat(std::uint16_t bits)
+    {
+        return std::bit_cast<float>(static_cast<std::uint32_t>(bits) << 16);
+    }
+
+    /**
+     * @struct half
+     * @brief IEEE 754 binary16 storage type, 1 sign bit, 5 exponent bits and 10 mantissa bits.
+     */
+    struct half
+    {
+        /**
+         * @brief Default constructor, value-initialisation gives +0.
+         */
+        half() = default;
+
+        /**
+         * @brief Converting constructor from float.
+         * @param value Value to store, rounded to nearest even.
+         */
+        half(float value) : m_bits(floatToHalfBits(value)) {}
+
+        /**
+         * @brief Builds a half from its raw bits.
+         * @param bits The 16 bits of the half.
+         * @return The half holding these bits.
+         */
+        static half fromBits(std::uint16_t bits)
+        {
+            half result;
+            result.m_bits = bits;
+            return result;
+        }
+
+        /**
+         * @brief Conversion to float, used for every arithmetic operation.
+         */
+        operator float() const
+        {
+            return halfBitsToFloat(m_bits);
+        }
+
+        /**
+         * @brief Returns the raw bits of the half.
+         * @return m_bits
+         */
+        std::uint16_t bits() const
+        {
+            return m_bits;
+        }
+
+        half& operator+=(float value)
+        {
+            return *this = half(float(*this) + value);
+        }
+
+        half& operator-=(float value)
+        {
+            return *this = half(float(*this) - value);
+        }
+
+        half& operator*=(float value)
+        {
+            return *this = half(float(*this) * value);
+        }
+
+        half& operator/=(float value)
+        {
+            return *this = half(float(*this) / value);
+        }
+
+    private:
+        std::uint16_t m_bits; ///< Raw IEEE 754 binary16 bits
+    };
+
+    /**
+     * @struct bfloat16
+     * @brief Brain floating point storage type, the upper 16 bits of a float (8 exponent bits, 7 mantissa bits).
+     */
+    struct bfloat16
+    {
+        /**
+         * @brief Default constructor, value-initialisation gives +0.
+         */
+        bfloat16() = default;
+
+        /**
+         * @brief Converting constructor from float.
+         * @param value Value to store, rounded to nearest even.
+         */
+        bfloat16(float value) : m_bits(floatToBfloat16Bits(value)) {}
+
+        /**
+         * @brief Builds a bfloat16 from its raw bits.
+         * @param bits The 16 bits of the bfloat16.
+         * @return The bfloat16 holding these bits.
+         */
+        static bfloat16 fromBits(std::uint16_t bits)
+        {
+            bfloat16 result;
+            result.m_bits = bits;
+            return result;
+        }
+
+        /**
+         * @brief Conversion to float, used for every arithmetic operation.
+         */
+        operator float() const
+        {
+            return bfloat16BitsToFloat(m_bits);
+        }
+
+        /**
+         * @brief Returns the raw bits of the bfloat16.
+         * @return m_bits
+         */
+        std::uint16_t bits() const
+        {
+            return m_bits;
+        }
+
+        bfloat16& operator+=(float value)
+        {
+            return *this = bfloat16(float(*this) + value);
+        }
+
+        bfloat16& operator-=(float value)
+        {
+            return *this = bfloat16(float(*this) - value);
+        }
+
+        bfloat16& operator*=(float value)
+        {
+            return *this = bfloat16(float(*this) * value);
+        }
+
+        bfloat16& operator/=(float value)
+        {
+            return *this = bfloat16(float(*this) / value);
+        }
+
+    private:
+        std::uint16_t m_bits; ///< Upper 16 bits of the equivalent float
+    };
+
+    static_assert(sizeof(half) == 2, "glg::half must stay a 16-bit type");
+    static_assert(sizeof(bfloat16) == 2, "glg::bfloat16 must stay a 16-bit type");
+
+    inline std::ostream& operator<<(std::ostream& os, const half& value)
+    {
+        return os << float(value);
+    }
+
+    inline std::ostream& operator<<(std::ostream& os, const bfloat16& value)
+    {
+        return os << float(value);
+    }
+
+#if GLG_HAS_F16C
+    /**
+     * @brief Loads 8 halves and widens them to 8 floats.
+     */
+    inline __m256 loadHalf8(const half* src)
+    {
+        return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+    }
+#endif
+
+#if GLG_HAS_AVX2
+    /**
+     * @brief Loads 8 bfloat16 and widens them to 8 floats.
+     */
+    inline __m256 loadBfloat16x8(const bfloat16* src)
+    {
+        const __m256i wide = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+        return _mm256_castsi256_ps(_mm256_slli_epi32(wide, 16));
+    }
+#endif
+
+    /**
+     * @brief Converts a range of halves to floats.
+     * @param src First half to convert.
+     * @param dst First float to write.
+     * @param count Number of elements.
+     */
+    inline void convert(const half* src, float* dst, size_t count)
+    {
+        size_t i = 0;
+#if GLG_HAS_F16C
+        for (; i + 8 <= count; i += 8)
+            _mm256_storeu_ps(dst + i, loadHalf8(src + i));
+#endif
+        for (; i < count; ++i)
+            dst[i] = float(src[i]);
+    }
+
+    /**
+     * @brief Converts a range of floats to halves.
+     * @param src First float to convert.
+     * @param dst First half to write.
+     * @param count Number of elements.
+     */
+    inline void convert(const float* src, half* dst, size_t count)
+    {
+        size_t i = 0;
+#if GLG_HAS_F16C
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m128i packed = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), packed);
+        }
+#endif
+        for (; i < count; ++i)
+            dst[i] = half(src[i]);
+    }
+
+    /**
+     * @brief Converts a range of bfloat16 to floats.
+     * @param src First bfloat16 to convert.
+     * @param dst First float to write.
+     * @param count Number of elements.
+     */
+    inline void convert(const bfloat16* src, float* dst, size_t count)
+    {
+        size_t i = 0;
+#if GLG_HAS_AVX2
+        for (; i + 8 <= count; i += 8)
+            _mm256_storeu_ps(dst + i, loadBfloat16x8(src + i));
+#endif
+        for (; i < count; ++i)
+            dst[i] = float(src[i]);
+    }
+
+    /**
+     * @brief Converts a range of floats to bfloat16.
+     * @param src First float to convert.
+     * @param dst First bfloat16 to write.
+     * @param count Number of elements.
+     */
+    inline void convert(const float* src, bfloat16* dst, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            dst[i] = bfloat16(src[i]);
+    }
+
+    /**
+     * @brief Dot product of two 16-bit float ranges, accumulated in float.
+     *
+     * @tparam Half16 glg::half or glg::bfloat16.
+     * @param lhs First range.
+     * @param rhs Second range.
+     * @param count Number of elements in each range.
+     * @return The dot product, in float.
+     */
+    template<typename Half16>
+    float dot(const Half16* lhs, const Half16* rhs, size_t count)
+    {
+        size_t i = 0;
+        float result = 0.f;
+#if GLG_HAS_AVX2 && GLG_HAS_FMA
+        // Halves are widened by F16C, bfloat16 by a plain shift
+        if constexpr (!std::is_same_v<Half16, half> || GLG_HAS_F16C)
+        {
+            auto load = [](const Half16* src)
+            {
+#if GLG_HAS_F16C
+                if constexpr (std::is_same_v<Half16, half>)
+                    return loadHalf8(src);
+                else
+#endif
+                    return loadBfloat16x8(src);
+            };
+
+            // Two independent accumulators hide the FMA latency
+            __m256 acc0 = _mm256_setzero_ps();
+            __m256 acc1 = _mm256_setzero_ps();
+            for (; i + 16 <= count; i += 16)
+            {
+                acc0 = _mm256_fmadd_ps(load(lhs + i), load(rhs + i), acc0);
+                acc1 = _mm256_fmadd_ps(load(lhs + i + 8), load(rhs + i + 8), acc1);
+            }
+            for (; i + 8 <= count; i += 8)
+                acc0 = _mm256_fmadd_ps(load(lhs + i), load(rhs + i), acc0);
+
+            const __m256 acc = _mm256_add_ps(acc0, acc1);
+            __m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+            sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+            sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+            result = _mm_cvtss_f32(sum);
+        }
+#endif
+        for (; i < count; ++i)
+            result += float(lhs[i]) * float(rhs[i]);
+
+        return result;
+    }
+};
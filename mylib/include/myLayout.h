@@ -0,0 +1,147 @@
+/**
+ * @file myLayout.h
+ * @brief Implementation of the storage layouts of myMatrix: row-major, column-major and tiled.
+ * @author Guillaume
+ * @date 18/10/2026
+ *
+ * A layout is a policy class mapping element (row, col) of a height x width
+ * matrix to its offset in the storage. Row-major and column-major layouts are
+ * strided: the offset is row * rowStride + col * colStride, so a matrix in
+ * either layout is a myMatrixView with no copy and goes straight to the
+ * strided kernels (gemm, gemv, transpose). A column-major matrix is also the
+ * row-major storage of its transpose, which is how the kernels that only
+ * handle row-major data (gemmFixed) serve it.
+ *
+ * The tiled layout stores tile x tile blocks one after the other, each block
+ * being row-major, so that a block of the matrix is a few contiguous cache
+ * lines whatever the width of the matrix. The blocks of the last row and
+ * column are cut to the size of the matrix, there is no padding.
+ *
+ * This header also holds the only forward declaration of myMatrix, the one
+ * carrying the default layout.
+ */
+
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace glg
+{
+    /**
+     * @struct RowMajor
+     * @brief Rows one after the other, the default layout.
+     */
+    struct RowMajor
+    {
+        static constexpr bool strided = true;
+
+        static constexpr size_t index(size_t row, size_t col, size_t, size_t width)
+        {
+            return row * width + col;
+        }
+
+        /** Row and column of the element at a given index, the inverse of index(). */
+        static constexpr std::pair<size_t, size_t> position(size_t index, size_t, size_t width)
+        {
+            return { index / width, index % width };
+        }
+
+        static constexpr size_t rowStride(size_t, size_t width)
+        {
+            return width;
+        }
+
+        static constexpr size_t colStride(size_t, size_t)
+        {
+            return 1;
+        }
+    };
+
+    /**
+     * @struct ColMajor
+     * @brief Columns one after the other, the layout of BLAS, LAPACK and most numerical tools.
+     */
+    struct ColMajor
+    {
+        static constexpr bool strided = true;
+
+        static constexpr size_t index(size_t row, size_t col, size_t height, size_t)
+        {
+            return col * height + row;
+        }
+
+        static constexpr std::pair<size_t, size_t> position(size_t index, size_t height, size_t)
+        {
+            return { index % height, index / height };
+        }
+
+        static constexpr size_t rowStride(size_t, size_t)
+        {
+            return 1;
+        }
+
+        static constexpr size_t colStride(size_t height, size_t)
+        {
+            return height;
+        }
+    };
+
+    /**
+     * @struct Tiled
+     * @brief Row-major tile x tile blocks stored one after the other, in row-major order of blocks.
+     * @tparam tile Height and width of a block, 8 by default (64 elements, four cache lines of floats).
+     */
+    template<size_t tile = 8>
+    struct Tiled
+    {
+        static_assert(tile > 0, "tiles must not be empty");
+
+        static constexpr bool strided = false;
+
+        static constexpr size_t index(size_t row, size_t col, size_t height, size_t width)
+        {
+            // Blocks of the last row and column are cut, so the extent of the block holding the element is needed
+            const size_t firstRow = row - row % tile;
+            const size_t firstCol = col - col % tile;
+            const size_t blockHeight = height - firstRow < tile ? height - firstRow : tile;
+            const size_t blockWidth = width - firstCol < tile ? width - firstCol : tile;
+            return firstRow * width + firstCol * blockHeight + (row - firstRow) * blockWidth + (col - firstCol);
+        }
+
+        static constexpr std::pair<size_t, size_t> position(size_t index, size_t height, size_t width)
+        {
+            // A band of blocks holds tile full rows, but the last one, then its blocks hold tile full columns of the band
+            const size_t firstRow = index / (tile * width) * tile;
+            const size_t blockHeight = height - firstRow < tile ? height - firstRow : tile;
+            const size_t inBand = index - firstRow * width;
+            const size_t firstCol = inBand / (blockHeight * tile) * tile;
+            const size_t blockWidth = width - firstCol < tile ? width - firstCol : tile;
+            const size_t inBlock = inBand - firstCol * blockHeight;
+            return { firstRow + inBlock / blockWidth, firstCol + inBlock % blockWidth };
+        }
+    };
+
+    /**
+     * @brief Checks if two layouts place every element of a height x width matrix at the same offset.
+     * Different layouts agree on vectors: a single row or column is contiguous in all of them.
+     */
+    template<typename A, typename B, size_t height, size_t width>
+    inline constexpr bool sameOrder = std::is_same_v<A, B> || height <= 1 || width <= 1;
+
+    /**
+     * @brief Copies a height x width matrix from one layout to another, element by element.
+     */
+    template<typename From, typename To, typename T>
+    void relayoutElements(const T* src, T* dst, size_t height, size_t width)
+    {
+        for (size_t i = 0; i < height; ++i)
+        {
+            for (size_t j = 0; j < width; ++j)
+                dst[To::index(i, j, height, width)] = src[From::index(i, j, height, width)];
+        }
+    }
+};
+
+template<typename type, size_t height, size_t width, typename layout = glg::RowMajor>
+struct myMatrix;
@@ -8,6 +8,7 @@
 #pragma once
 #include <iterator>
 #include <stdexcept>
+#include <utility>
 
  /**
   * @struct myList
@@ -262,6 +263,44 @@ struct myList
         return *this;
     }
 
+    /**
+	 * @brief Move constructor for the myList, takes the nodes without copying them
+     * @param other List to move from, left empty
+     */
+    myList(myList&& other) noexcept
+        : m_start(std::exchange(other.m_start, nullptr)), m_end(std::exchange(other.m_end, nullptr)),
+          m_size(std::exchange(other.m_size, 0)) {}
+
+    /**
+	 * @brief Move assignment operator for the myList
+     * @param other List to move from, left empty
+     * @return Reference to this list
+     */
+    myList& operator=(myList&& other) noexcept
+	{
+        myList(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    /**
+	 * @brief Exchanges the nodes with another list in constant time
+     * @param other List to swap with
+     */
+    void swap(myList& other) noexcept
+	{
+        std::swap(m_start, other.m_start);
+        std::swap(m_end, other.m_end);
+        std::swap(m_size, other.m_size);
+    }
+
+    /**
+	 * @brief Swap found by argument-dependent lookup, for callers of the using std::swap; swap(a, b) idiom
+     */
+    friend void swap(myList& first, myList& second) noexcept
+	{
+        first.swap(second);
+    }
+
     /**
 	 * @brief Push the value at the front of the list
      * @param value 
@@ -5,11 +5,30 @@
  * @date 08/02/2025
  */
 
+#pragma once
 #include <initializer_list>
+#include <type_traits>
 #include "myArray.h"
+#include "myExpr.h"
+#include "myGemm.h"
+#include "myLayout.h"
+#include "myTranspose.h"
 #include "helper.h"
 
-    template<typename type, size_t height, size_t width>
+    /**
+     * @struct myMatrix
+     * @brief Fixed-size matrix, its elements stored in the given layout.
+     *
+     * getCell() and operator()(row, col) address elements by position in any
+     * layout. data(), operator[], at() and the iterators walk the storage in
+     * its own order, which is the row-major order only for glg::RowMajor.
+     *
+     * @tparam type Element type.
+     * @tparam height Number of rows.
+     * @tparam width Number of columns.
+     * @tparam layout glg::RowMajor (the default), glg::ColMajor or glg::Tiled<tile>.
+     */
+    template<typename type, size_t height, size_t width, typename layout>
     struct myMatrix
     {
         using value_type = type;
@@ -21,40 +40,118 @@
         using const_reverse_iterator = myArray<type, width* height >::const_reverse_iterator;
         using iterator = myArray<type, width* height>::iterator;
         using const_iterator = myArray<type, width* height>::const_iterator;
+        using layout_type = layout;
 
-        myMatrix(std::initializer_list<type> list)
+        /**
+         * @brief Constructor from the elements in row-major order, whatever the layout. Missing elements are value-initialised.
+         * @throw std::runtime_error if the list holds more than height * width elements.
+         */
+        myMatrix(std::initializer_list<type> list) : m_data(glg::uninitialized)
         {
             if (list.size() > size)
                 throw std::runtime_error("Out of Range");
 
-            glg::copy(list.begin(), list.end(), m_data.data());
-            glg::fill((m_data.begin() + list.size()), m_data.end(), type());
+            if constexpr (glg::sameOrder<layout, glg::RowMajor, height, width>)
+            {
+                glg::copy(list.begin(), list.end(), m_data.data());
+                glg::fill(m_data.data() + list.size(), m_data.data() + m_data.size(), type());
+            }
+            else
+            {
+                glg::fill(m_data.data(), m_data.data() + m_data.size(), type());
+                size_t idx = 0;
+                for (const type& value : list)
+                {
+                    (*this)(idx / width, idx % width) = value;
+                    ++idx;
+                }
+            }
         }
         myMatrix()
         {
-            glg::fill(m_data.begin(), m_data.end(), type());
         }
-        myMatrix(const myMatrix& tab)
+        explicit myMatrix(glg::uninitialized_t) : m_data(glg::uninitialized)
+        {
+        }
+        myMatrix(const myMatrix& tab) : m_data(glg::uninitialized)
+        {
+            glg::copy(tab.m_data.data(), tab.m_data.data() + tab.m_data.size(), m_data.data());
+        }
+        /**
+         * @brief Copy of a matrix stored in another layout.
+         * @param other The matrix to copy.
+         */
+        template<typename otherLayout> requires (!std::is_same_v<otherLayout, layout>)
+        explicit myMatrix(const myMatrix<type, height, width, otherLayout>& other) : m_data(glg::uninitialized)
         {
-            if (tab.m_data.Size() != size)
-                throw std::runtime_error("size must be equal");
-            glg::copy(tab.m_data.begin(), tab.m_data.end(), m_data.data());
+            Math::relayout<otherLayout, layout>(other.data(), data(), height, width);
+        }
+        /**
+         * @brief Evaluates an expression (A + B, A * B - C...) straight into the new matrix.
+         * @param expr An expression of height x width elements.
+         */
+        template<glg::expr::Expression E> requires (E::rows == height && E::cols == width)
+        myMatrix(const E& expr) : m_data(glg::uninitialized)
+        {
+            glg::expr::evaluate<layout>(expr, data());
         }
         myMatrix& operator=(const myMatrix& tab)
         {
-            if (m_data.Size() != tab.m_data.Size())
+            if (m_data.size() != tab.m_data.size())
                 throw std::out_of_range("size must be equal");
             if (this != &tab)
-                glg::copy(tab.m_data.begin(), tab.m_data.end(), m_data.data());
+                glg::copy(tab.m_data.data(), tab.m_data.data() + tab.m_data.size(), m_data.data());
+            return *this;
+        }
+        /**
+         * @brief Evaluates an expression into the matrix, the matrix may appear in the expression.
+         * @param expr An expression of height x width elements.
+         */
+        template<glg::expr::Expression E> requires (E::rows == height && E::cols == width)
+        myMatrix& operator=(const E& expr)
+        {
+            glg::expr::evaluate<layout>(expr, data());
             return *this;
         }
+        template<glg::expr::Operand E>
+        myMatrix& operator+=(const E& expr)
+        {
+            return *this = *this + expr;
+        }
+        template<glg::expr::Operand E>
+        myMatrix& operator-=(const E& expr)
+        {
+            return *this = *this - expr;
+        }
+        template<glg::expr::Scalar S>
+        myMatrix& operator*=(const S& scalar)
+        {
+            return *this = *this * scalar;
+        }
+        template<glg::expr::Scalar S>
+        myMatrix& operator/=(const S& scalar)
+        {
+            return *this = *this / scalar;
+        }
         reference getCell(size_t row, size_t col)
         {
-            return m_data.at(row * width + col);
+            if (row >= height || col >= width)
+                throw std::out_of_range("Out of Range");
+            return m_data[layout::index(row, col, height, width)];
         }
         const_reference getCell(size_t row, size_t col) const
         {
-            return m_data.at(row * width + col);
+            if (row >= height || col >= width)
+                throw std::out_of_range("Out of Range");
+            return m_data[layout::index(row, col, height, width)];
+        }
+        reference operator()(size_t row, size_t col)
+        {
+            return m_data[layout::index(row, col, height, width)];
+        }
+        const_reference operator()(size_t row, size_t col) const
+        {
+            return m_data[layout::index(row, col, height, width)];
         }
         reference operator[](const size_t& idx)
         {
@@ -86,11 +183,11 @@
         }
         bool Empty()
         {
-            return m_data.Empty();
+            return m_data.empty();
         }
         bool Empty() const
         {
-            return  m_data.Empty();
+            return  m_data.empty();
         }
         pointer data()
         {
@@ -148,141 +245,48 @@
                 throw std::out_of_range("Array is empty");
             return const_reverse_iterator(data() - 1);
         }
-        myMatrix<type, height, width > operator+(const myMatrix<type, height, width >& data)
-        {
-            myMatrix<type, height, width > result;
-            for (size_t i = 0; i < m_data.Size(); ++i)
-            {
-                result[i] = data[i] + m_data[i];
-            }
-            return result;
-        }
-        myMatrix<type, height, width > operator-(const myMatrix<type, height, width >& data)
-        {
-            myMatrix<type, height, width > result;
-            for (size_t i = 0; i < m_data.Size(); ++i)
-            {
-                result[i] = data[i] - m_data[i];
-            }
-            return result;
-        }
-        myMatrix<type, height, width > operator*(const int& idx)
-        {
-            myMatrix<type, height, width > result;
-            for (size_t i = 0; i < m_data.Size(); ++i)
-            {
-                result[i] = m_data[i] * idx;
-            }
-            return result;
-        }
-        myMatrix<type, height, width > operator/(const int& idx)
-        {
-            if (idx == 0)
-                throw std::runtime_error("cannot divide by 0");
-
-            myMatrix<type, height, width > result;
-            for (size_t i = 0; i < m_data.Size(); ++i)
-            {
-                result[i] = m_data[i] / idx;
-            }
-            return result;
-        }
-        bool operator ==(const myMatrix<type, height, width >& data)
+        bool operator ==(const myMatrix& data)
         {
-            for (size_t i = 0; i < m_data.Size(); ++i)
+            for (size_t i = 0; i < m_data.size(); ++i)
             {
                 if (data[i] != m_data[i])
                     return false;
             }
             return true;
         }
-        bool operator !=(const myMatrix<type, height, width >& data)
-        {
-            bool result;
-            for (size_t i = 0; i < m_data.Size(); ++i)
-            {
-                if (data[i] == m_data[i])
-                    result = false;
-                else
-                    result = true;
-            }
-            return result;
-        }
-        myMatrix<type, height, width > operator+(const myMatrix<type, height, width >& data) const
+        bool operator !=(const myMatrix& data)
         {
-            myMatrix<type, height, width > result;
-            for (size_t i = 0; i < m_data.Size(); ++i)
-            {
-                result[i] = data[i] + m_data[i];
-            }
-            return result;
-        }
-        myMatrix<type, height, width > operator-(const myMatrix<type, height, width >& data) const
-        {
-            myMatrix<type, height, width> result;
-            for (size_t i = 0; i < m_data.Size(); ++i)
-            {
-                result[i] = data[i] - m_data[i];
-            }
-            return result;
-        }
-        myMatrix<type, height, width > operator*(const int& idx) const
-        {
-            myMatrix<type, height, width > result;
-            for (size_t i = 0; i < m_data.Size(); ++i)
-            {
-                result[i] = m_data[i] * idx;
-            }
-            return result;
-        }
-        myMatrix<type, height, width > operator/(const int& idx) const
-        {
-            if (idx == 0)
-                throw std::runtime_error("cannot divide by 0");
-            myMatrix<type, height, width > result;
-            for (size_t i = 0; i < m_data.Size(); ++i)
-            {
-                result[i] = m_data[i] / idx;
-            }
-            return result;
+            return !(*this == data);
         }
-        bool operator ==(const myMatrix<type, height, width >& data) const
+        bool operator ==(const myMatrix& data) const
         {
-            for (size_t i = 0; i < m_data.Size(); ++i)
+            for (size_t i = 0; i < m_data.size(); ++i)
             {
                 if (data[i] != m_data[i])
                     return false;
             }
             return true;
         }
-        bool operator !=(const myMatrix<type, height, width >& data) const
+        bool operator !=(const myMatrix& data) const
         {
-            bool result;
-            for (size_t i = 0; i < m_data.Size(); ++i)
-            {
-                if (data[i] == m_data[i])
-                    result = false;
-                else
-                    result = true;
-            }
-            return result;
+            return !(*this == data);
         }
     private:
-        size_t size = width * height;
+        static constexpr size_t size = width * height;
         myArray<type, height* width > m_data;
     };
 
-template<typename type, size_t height, size_t width>
-std::ostream& operator<<(std::ostream& os, const myMatrix<type, height, width >& tab)
+template<typename type, size_t height, size_t width, typename layout>
+std::ostream& operator<<(std::ostream& os, const myMatrix<type, height, width, layout>& tab)
 {
     if (tab.Size() == 0)
         return os;
-    for (auto i = 0; i < height; ++i)
+    for (size_t i = 0; i < height; ++i)
     {
         os << "(";
-        for (auto j = 0; j < width; ++j)
+        for (size_t j = 0; j < width; ++j)
         {
-            os << tab.getCell(i, j);
+            os << tab(i, j);
             if (j != width - 1)
                 os << ",";
         }
@@ -290,4 +294,4 @@ std::ostream& operator<<(std::ostream& os, const myMatrix<type, height, width >&
     }
 
     return os;
-}
\ No newline at end of file
+}
@@ -0,0 +1,284 @@
+/**
+ * @file myMatrixView.h
+ * @brief Implementation of a non-owning, strided view over the elements of a matrix.
+ * @author Guillaume
+ * @date 18/10/2026
+ */
+
+#pragma once
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+#include "myLayout.h"
+
+template<typename T>
+struct myDynMatrix;
+
+/**
+ * @struct myMatrixView
+ * @brief Rows x cols window over existing storage, element (r, c) lives at data[r * rowStride + c * colStride].
+ *
+ * A view never owns nor copies its elements: row(), col(), block() and
+ * transpose() only adjust the pointer, the shape and the strides, so slicing
+ * a matrix of any size is O(1). The strides are handed unchanged to the
+ * kernels (Math::gemm and the others), a transposed view is simply a view
+ * whose strides are swapped. Row-major and column-major myMatrix convert to
+ * a view with no copy; a tiled one has no strides and must be converted to
+ * one of them first.
+ *
+ * @tparam T Element type, const-qualified for a read-only view.
+ */
+template<typename T>
+struct myMatrixView
+{
+    using value_type = std::remove_const_t<T>;
+    using element_type = T;
+    using pointer = T*;
+    using reference = T&;
+
+    /**
+     * @brief Default constructor, an empty view.
+     */
+    myMatrixView() : m_data(nullptr), m_rows(0), m_cols(0), m_rowStride(0), m_colStride(0) {}
+
+    /**
+     * @brief Constructor from raw storage.
+     * @param data First element of the view.
+     * @param rows Number of rows.
+     * @param cols Number of columns.
+     * @param rowStride Distance between two rows, in elements.
+     * @param colStride Distance between two columns, in elements.
+     */
+    myMatrixView(pointer data, size_t rows, size_t cols, size_t rowStride, size_t colStride = 1)
+        : m_data(data), m_rows(rows), m_cols(cols), m_rowStride(rowStride), m_colStride(colStride) {}
+
+    /**
+     * @brief View over a whole fixed-size matrix, row-major or column-major.
+     * @param matrix The matrix to view.
+     */
+    template<size_t height, size_t width, typename layout> requires layout::strided
+    myMatrixView(myMatrix<value_type, height, width, layout>& matrix)
+        : myMatrixView(matrix.data(), height, width, layout::rowStride(height, width), layout::colStride(height, width)) {}
+
+    /**
+     * @brief Read-only view over a whole fixed-size matrix, row-major or column-major.
+     * @param matrix The matrix to view.
+     */
+    template<size_t height, size_t width, typename layout> requires (std::is_const_v<T> && layout::strided)
+    myMatrixView(const myMatrix<value_type, height, width, layout>& matrix)
+        : myMatrixView(matrix.data(), height, width, layout::rowStride(height, width), layout::colStride(height, width)) {}
+
+    /**
+     * @brief View over a whole runtime-sized matrix.
+     * @param matrix The matrix to view.
+     */
+    myMatrixView(myDynMatrix<value_type>& matrix)
+        : myMatrixView(matrix.data(), matrix.rows(), matrix.cols(), matrix.stride(), 1) {}
+
+    /**
+     * @brief Read-only view over a whole runtime-sized matrix.
+     * @param matrix The matrix to view.
+     */
+    myMatrixView(const myDynMatrix<value_type>& matrix) requires std::is_const_v<T>
+        : myMatrixView(matrix.data(), matrix.rows(), matrix.cols(), matrix.stride(), 1) {}
+
+    /**
+     * @brief Conversion of a mutable view to a read-only view.
+     * @param other The view to convert.
+     */
+    template<typename U> requires (std::is_const_v<T> && std::is_same_v<U, value_type>)
+    myMatrixView(const myMatrixView<U>& other)
+        : myMatrixView(other.data(), other.rows(), other.cols(), other.rowStride(), other.colStride()) {}
+
+    /**
+     * @brief Access element without bounds checking.
+     * @param row Row of the element.
+     * @param col Column of the element.
+     * @return Reference to the element.
+     */
+    reference operator()(size_t row, size_t col) const
+    {
+        return m_data[row * m_rowStride + col * m_colStride];
+    }
+
+    /**
+     * @brief Access element with bounds checking.
+     * @param row Row of the element.
+     * @param col Column of the element.
+     * @return Reference to the element.
+     * @throw std::out_of_range if the element is outside of the view.
+     */
+    reference getCell(size_t row, size_t col) const
+    {
+        if (row >= m_rows || col >= m_cols)
+            throw std::out_of_range("Out of Range");
+
+        return (*this)(row, col);
+    }
+
+    /**
+     * @brief View over one row.
+     * @param row Index of the row.
+     * @return 1 x cols view.
+     * @throw std::out_of_range if row is out of range.
+     */
+    myMatrixView row(size_t row) const
+    {
+        return block(row, 0, 1, m_cols);
+    }
+
+    /**
+     * @brief View over one column.
+     * @param col Index of the column.
+     * @return rows x 1 view.
+     * @throw std::out_of_range if col is out of range.
+     */
+    myMatrixView col(size_t col) const
+    {
+        return block(0, col, m_rows, 1);
+    }
+
+    /**
+     * @brief View over a rectangular block.
+     * @param row First row of the block.
+     * @param col First column of the block.
+     * @param height Number of rows of the block.
+     * @param width Number of columns of the block.
+     * @return height x width view sharing the strides of this view.
+     * @throw std::out_of_range if the block does not fit in the view.
+     */
+    myMatrixView block(size_t row, size_t col, size_t height, size_t width) const
+    {
+        if (row + height > m_rows || col + width > m_cols)
+            throw std::out_of_range("Block out of Range");
+
+        return myMatrixView(m_data + row * m_rowStride + col * m_colStride, height, width, m_rowStride, m_colStride);
+    }
+
+    /**
+     * @brief Transposed view, the strides are swapped and nothing is copied.
+     * @return cols x rows view.
+     */
+    myMatrixView transpose() const
+    {
+        return myMatrixView(m_data, m_cols, m_rows, m_colStride, m_rowStride);
+    }
+
+    /**
+     * @brief Checks if each row is contiguous in memory.
+     * @return true if the column stride is 1.
+     */
+    bool isRowContiguous() const
+    {
+        return m_colStride == 1 || m_cols <= 1;
+    }
+
+    pointer data() const
+    {
+        return m_data;
+    }
+
+    size_t rows() const
+    {
+        return m_rows;
+    }
+
+    size_t cols() const
+    {
+        return m_cols;
+    }
+
+    size_t rowStride() const
+    {
+        return m_rowStride;
+    }
+
+    size_t colStride() const
+    {
+        return m_colStride;
+    }
+
+    size_t Size() const
+    {
+        return m_rows * m_cols;
+    }
+
+    bool Empty() const
+    {
+        return m_rows == 0 || m_cols == 0;
+    }
+
+private:
+    pointer m_data;       ///< First element of the view
+    size_t m_rows;        ///< Number of rows
+    size_t m_cols;        ///< Number of columns
+    size_t m_rowStride;   ///< Distance between two rows, in elements
+    size_t m_colStride;   ///< Distance between two columns, in elements
+};
+
+/**
+ * @brief Stream insertion operator for myMatrixView, one row per line.
+ * @param os The output stream.
+ * @param view The view to print.
+ * @return std::ostream& The output stream.
+ */
+template<typename T>
+std::ostream& operator<<(std::ostream& os, const myMatrixView<T>& view)
+{
+    for (size_t i = 0; i < view.rows(); ++i)
+    {
+        os << "(";
+        for (size_t j = 0; j < view.cols(); ++j)
+        {
+            os << view(i, j);
+            if (j != view.cols() - 1)
+                os << ",";
+        }
+        os << ")" << std::endl;
+    }
+
+    return os;
+}
+
+namespace glg
+{
+    /**
+     * @brief Returns a view over any matrix of the library, used to write operators once for every matrix type.
+     */
+    template<typename T>
+    myMatrixView<T> viewOf(myMatrixView<T> view)
+    {
+        return view;
+    }
+
+    template<typename T, size_t height, size_t width, typename layout> requires layout::strided
+    myMatrixView<T> viewOf(myMatrix<T, height, width, layout>& matrix)
+    {
+        return myMatrixView<T>(matrix);
+    }
+
+    template<typename T, size_t height, size_t width, typename layout> requires layout::strided
+    myMatrixView<const T> viewOf(const myMatrix<T, height, width, layout>& matrix)
+    {
+        return myMatrixView<const T>(matrix);
+    }
+
+    template<typename T>
+    myMatrixView<T> viewOf(myDynMatrix<T>& matrix)
+    {
+        return matrix.view();
+    }
+
+    template<typename T>
+    myMatrixView<const T> viewOf(const myDynMatrix<T>& matrix)
+    {
+        return matrix.view();
+    }
+
+    /**
+     * @brief Matrix types accepted by the runtime-sized operators.
+     */
+    template<typename M>
+    concept MatrixOperand = requires(M& matrix) { glg::viewOf(matrix); };
+};
@@ -0,0 +1,1164 @@
+/**
+ * @file myPackedMatrix.h
+ * @brief Implementation of packed triangular, symmetric and band matrices, with their products and solvers.
+ * @author Guillaume
+ * @date 18/10/2026
+ *
+ * A triangular or symmetric n x n matrix stores only the n(n+1)/2 elements
+ * of one triangle, row after row, and a band matrix only the diagonals
+ * around the main one. The kernels never read an element that is not
+ * stored: every row of the packed storage is contiguous, so the products
+ * and the substitutions are dot products or AXPYs over whole rows.
+ *
+ * Storing half of the matrix halves the traffic of the memory-bound
+ * kernels, the matrix-vector products and the triangular solves. Large
+ * products are split over the global glg::ThreadPool.
+ *
+ * - myTriangularMatrix<T, glg::Triangle::Lower> keeps row r as columns [0, r],
+ *   the Upper one as columns [r, n).
+ * - mySymmetricMatrix<T> keeps the lower triangle, element (r, c) above
+ *   the diagonal is read at (c, r).
+ * - myBandMatrix<T> keeps, for every row r, the lower + upper + 1 columns
+ *   [r - lower, r + upper]; the positions outside of the matrix, in the
+ *   first and last rows, are padding holding zeros.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "myDynMatrix.h"
+#include "myGemm.h"
+#include "myLayout.h"
+#include "myMatrix.h"
+#include "myMatrixView.h"
+#include "myThreadPool.h"
+#include "myVectorND.h"
+#include "simdConfig.h"
+
+namespace glg
+{
+    /** Triangle kept by a myTriangularMatrix. */
+    enum class Triangle
+    {
+        Lower,
+        Upper
+    };
+};
+
+/**
+ * @struct myTriangularMatrix
+ * @brief Square lower or upper triangular matrix, only the triangle is stored, row after row.
+ * @tparam T Element type.
+ * @tparam triangle The stored triangle, the other one is zero.
+ */
+template<typename T, glg::Triangle triangle = glg::Triangle::Lower>
+struct myTriangularMatrix
+{
+    using value_type = T;
+    static constexpr bool lower = triangle == glg::Triangle::Lower;
+
+    /**
+     * @brief Default constructor, an empty 0 x 0 matrix.
+     */
+    myTriangularMatrix() : m_size(0) {}
+
+    /**
+     * @brief Constructor of a size x size zero matrix.
+     */
+    explicit myTriangularMatrix(size_t size) : m_size(size), m_values(size * (size + 1) / 2, T(0)) {}
+
+    /**
+     * @brief Conversion from a dense matrix (myDynMatrix or a view), only the stored triangle is read.
+     * @throw std::invalid_argument if the matrix is not square.
+     */
+    explicit myTriangularMatrix(myMatrixView<const T> dense) : myTriangularMatrix(checkSquare(dense.rows(), dense.cols()))
+    {
+        for (size_t r = 0; r < m_size; ++r)
+        {
+            for (size_t c = firstCol(r); c < lastCol(r); ++c)
+                (*this)(r, c) = dense(r, c);
+        }
+    }
+
+    /**
+     * @brief Conversion from a fixed-size matrix in any layout, only the stored triangle is read.
+     */
+    template<size_t N, typename layout>
+    explicit myTriangularMatrix(const myMatrix<T, N, N, layout>& dense) : myTriangularMatrix(N)
+    {
+        for (size_t r = 0; r < N; ++r)
+        {
+            for (size_t c = firstCol(r); c < lastCol(r); ++c)
+                (*this)(r, c) = dense(r, c);
+        }
+    }
+
+    /**
+     * @brief Access a stored element without bounds checking, (row, col) must lie in the triangle.
+     */
+    T& operator()(size_t row, size_t col)
+    {
+        return m_values[rowOffset(row) + col - firstCol(row)];
+    }
+
+    const T& operator()(size_t row, size_t col) const
+    {
+        return m_values[rowOffset(row) + col - firstCol(row)];
+    }
+
+    /**
+     * @brief Value of any element, 0 outside of the triangle.
+     * @throw std::out_of_range if the position is outside of the matrix.
+     */
+    T getCell(size_t row, size_t col) const
+    {
+        if (row >= m_size || col >= m_size)
+            throw std::out_of_range("Out of Range");
+
+        return isStored(row, col) ? (*this)(row, col) : T(0);
+    }
+
+    bool isStored(size_t row, size_t col) const
+    {
+        return lower ? col <= row : col >= row;
+    }
+
+    /** First stored column of a row. */
+    size_t firstCol(size_t row) const
+    {
+        return lower ? 0 : row;
+    }
+
+    /** One past the last stored column of a row. */
+    size_t lastCol(size_t row) const
+    {
+        return lower ? row + 1 : m_size;
+    }
+
+    /** Position of the first stored element of a row in values(). */
+    size_t rowOffset(size_t row) const
+    {
+        return lower ? row * (row + 1) / 2 : row * m_size - row * (row - 1) / 2;
+    }
+
+    /**
+     * @brief Product of the diagonal.
+     */
+    T determinant() const
+    {
+        T result = T(1);
+        for (size_t i = 0; i < m_size; ++i)
+            result *= (*this)(i, i);
+        return result;
+    }
+
+    /**
+     * @brief Returns the transpose, stored in the other triangle.
+     */
+    auto transpose() const
+    {
+        constexpr glg::Triangle other = lower ? glg::Triangle::Upper : glg::Triangle::Lower;
+        myTriangularMatrix<T, other> result(m_size);
+        for (size_t r = 0; r < m_size; ++r)
+        {
+            for (size_t c = firstCol(r); c < lastCol(r); ++c)
+                result(c, r) = (*this)(r, c);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Converts to a dense matrix.
+     */
+    myDynMatrix<T> toDense() const
+    {
+        myDynMatrix<T> result(m_size, m_size);
+        for (size_t r = 0; r < m_size; ++r)
+            std::copy(m_values.begin() + rowOffset(r), m_values.begin() + rowOffset(r) + (lastCol(r) - firstCol(r)), &result(r, firstCol(r)));
+        return result;
+    }
+
+    /**
+     * @brief Converts to a fixed-size matrix.
+     * @throw std::invalid_argument if the matrix is not N x N.
+     */
+    template<size_t N, typename layout = glg::RowMajor>
+    myMatrix<T, N, N, layout> toMatrix() const
+    {
+        if (m_size != N)
+            throw std::invalid_argument("size must be equal");
+
+        myMatrix<T, N, N, layout> result;
+        for (size_t r = 0; r < N; ++r)
+        {
+            for (size_t c = firstCol(r); c < lastCol(r); ++c)
+                result(r, c) = (*this)(r, c);
+        }
+        return result;
+    }
+
+    size_t rows() const
+    {
+        return m_size;
+    }
+
+    size_t cols() const
+    {
+        return m_size;
+    }
+
+    /** Number of stored elements, n(n+1)/2. */
+    size_t packedSize() const
+    {
+        return m_values.size();
+    }
+
+    std::span<const T> values() const
+    {
+        return m_values;
+    }
+
+    std::span<T> values()
+    {
+        return m_values;
+    }
+
+private:
+    static size_t checkSquare(size_t rows, size_t cols)
+    {
+        if (rows != cols)
+            throw std::invalid_argument("matrix must be square");
+        return rows;
+    }
+
+    size_t m_size;            ///< Number of rows and columns
+    std::vector<T> m_values;  ///< The triangle, row after row
+};
+
+/**
+ * @struct mySymmetricMatrix
+ * @brief Square symmetric matrix, only the lower triangle is stored, row after row.
+ * @tparam T Element type.
+ */
+template<typename T>
+struct mySymmetricMatrix
+{
+    using value_type = T;
+
+    /**
+     * @brief Default constructor, an empty 0 x 0 matrix.
+     */
+    mySymmetricMatrix() : m_size(0) {}
+
+    /**
+     * @brief Constructor of a size x size zero matrix.
+     */
+    explicit mySymmetricMatrix(size_t size) : m_size(size), m_values(size * (size + 1) / 2, T(0)) {}
+
+    /**
+     * @brief Conversion from a dense matrix (myDynMatrix or a view), only the lower triangle is read.
+     * @throw std::invalid_argument if the matrix is not square.
+     */
+    explicit mySymmetricMatrix(myMatrixView<const T> dense) : mySymmetricMatrix(dense.rows())
+    {
+        if (dense.rows() != dense.cols())
+            throw std::invalid_argument("matrix must be square");
+
+        for (size_t r = 0; r < m_size; ++r)
+        {
+            for (size_t c = 0; c <= r; ++c)
+                (*this)(r, c) = dense(r, c);
+        }
+    }
+
+    /**
+     * @brief Conversion from a fixed-size matrix in any layout, only the lower triangle is read.
+     */
+    template<size_t N, typename layout>
+    explicit mySymmetricMatrix(const myMatrix<T, N, N, layout>& dense) : mySymmetricMatrix(N)
+    {
+        for (size_t r = 0; r < N; ++r)
+        {
+            for (size_t c = 0; c <= r; ++c)
+                (*this)(r, c) = dense(r, c);
+        }
+    }
+
+    /**
+     * @brief Access an element without bounds checking, (row, col) and (col, row) are the same element.
+     */
+    T& operator()(size_t row, size_t col)
+    {
+        return row >= col ? m_values[row * (row + 1) / 2 + col] : m_values[col * (col + 1) / 2 + row];
+    }
+
+    const T& operator()(size_t row, size_t col) const
+    {
+        return row >= col ? m_values[row * (row + 1) / 2 + col] : m_values[col * (col + 1) / 2 + row];
+    }
+
+    /**
+     * @brief Value of an element.
+     * @throw std::out_of_range if the position is outside of the matrix.
+     */
+    T getCell(size_t row, size_t col) const
+    {
+        if (row >= m_size || col >= m_size)
+            throw std::out_of_range("Out of Range");
+
+        return (*this)(row, col);
+    }
+
+    /**
+     * @brief Cholesky factor L of the matrix, A = L * L^T, computed on the packed rows.
+     * @throw std::runtime_error if the matrix is not positive definite.
+     */
+    myTriangularMatrix<T, glg::Triangle::Lower> cholesky() const;
+
+    /**
+     * @brief Converts to a dense matrix, both triangles filled.
+     */
+    myDynMatrix<T> toDense() const
+    {
+        myDynMatrix<T> result(m_size, m_size);
+        for (size_t r = 0; r < m_size; ++r)
+        {
+            for (size_t c = 0; c <= r; ++c)
+                result(r, c) = result(c, r) = (*this)(r, c);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Converts to a fixed-size matrix, both triangles filled.
+     * @throw std::invalid_argument if the matrix is not N x N.
+     */
+    template<size_t N, typename layout = glg::RowMajor>
+    myMatrix<T, N, N, layout> toMatrix() const
+    {
+        if (m_size != N)
+            throw std::invalid_argument("size must be equal");
+
+        myMatrix<T, N, N, layout> result(glg::uninitialized);
+        for (size_t r = 0; r < N; ++r)
+        {
+            for (size_t c = 0; c <= r; ++c)
+                result(r, c) = result(c, r) = (*this)(r, c);
+        }
+        return result;
+    }
+
+    size_t rows() const
+    {
+        return m_size;
+    }
+
+    size_t cols() const
+    {
+        return m_size;
+    }
+
+    /** Number of stored elements, n(n+1)/2. */
+    size_t packedSize() const
+    {
+        return m_values.size();
+    }
+
+    std::span<const T> values() const
+    {
+        return m_values;
+    }
+
+    std::span<T> values()
+    {
+        return m_values;
+    }
+
+private:
+    size_t m_size;            ///< Number of rows and columns
+    std::vector<T> m_values;  ///< The lower triangle, row after row
+};
+
+/**
+ * @struct myBandMatrix
+ * @brief Square band matrix: element (r, c) is stored when r - lower <= c <= r + upper, every other element is zero.
+ * @tparam T Element type.
+ */
+template<typename T>
+struct myBandMatrix
+{
+    using value_type = T;
+
+    /**
+     * @brief Default constructor, an empty 0 x 0 matrix.
+     */
+    myBandMatrix() : m_size(0), m_lower(0), m_upper(0) {}
+
+    /**
+     * @brief Constructor of a size x size zero matrix.
+     * @param size Number of rows and columns.
+     * @param lower Number of stored diagonals below the main one.
+     * @param upper Number of stored diagonals above the main one.
+     */
+    myBandMatrix(size_t size, size_t lower, size_t upper)
+        : m_size(size), m_lower(lower), m_upper(upper), m_values(size * (lower + upper + 1), T(0)) {}
+
+    /**
+     * @brief Conversion from a dense matrix (myDynMatrix or a view), only the band is read.
+     * @throw std::invalid_argument if the matrix is not square.
+     */
+    myBandMatrix(myMatrixView<const T> dense, size_t lower, size_t upper) : myBandMatrix(dense.rows(), lower, upper)
+    {
+        if (dense.rows() != dense.cols())
+            throw std::invalid_argument("matrix must be square");
+
+        for (size_t r = 0; r < m_size; ++r)
+        {
+            for (size_t c = firstCol(r); c < lastCol(r); ++c)
+                (*this)(r, c) = dense(r, c);
+        }
+    }
+
+    /**
+     * @brief Conversion from a fixed-size matrix in any layout, only the band is read.
+     */
+    template<size_t N, typename layout>
+    myBandMatrix(const myMatrix<T, N, N, layout>& dense, size_t lower, size_t upper) : myBandMatrix(N, lower, upper)
+    {
+        for (size_t r = 0; r < N; ++r)
+        {
+            for (size_t c = firstCol(r); c < lastCol(r); ++c)
+                (*this)(r, c) = dense(r, c);
+        }
+    }
+
+    /**
+     * @brief Access a stored element without bounds checking, (row, col) must lie in the band.
+     */
+    T& operator()(size_t row, size_t col)
+    {
+        return m_values[row * width() + m_lower + col - row];
+    }
+
+    const T& operator()(size_t row, size_t col) const
+    {
+        return m_values[row * width() + m_lower + col - row];
+    }
+
+    /**
+     * @brief Value of any element, 0 outside of the band.
+     * @throw std::out_of_range if the position is outside of the matrix.
+     */
+    T getCell(size_t row, size_t col) const
+    {
+        if (row >= m_size || col >= m_size)
+            throw std::out_of_range("Out of Range");
+
+        return isStored(row, col) ? (*this)(row, col) : T(0);
+    }
+
+    bool isStored(size_t row, size_t col) const
+    {
+        return col + m_lower >= row && col <= row + m_upper;
+    }
+
+    /** First column of a row inside both the band and the matrix. */
+    size_t firstCol(size_t row) const
+    {
+        return row > m_lower ? row - m_lower : 0;
+    }
+
+    /** One past the last column of a row inside both the band and the matrix. */
+    size_t lastCol(size_t row) const
+    {
+        return std::min(m_size, row + m_upper + 1);
+    }
+
+    /** Number of stored elements per row, padding included. */
+    size_t width() const
+    {
+        return m_lower + m_upper + 1;
+    }
+
+    /**
+     * @brief Converts to a dense matrix.
+     */
+    myDynMatrix<T> toDense() const
+    {
+        myDynMatrix<T> result(m_size, m_size);
+        for (size_t r = 0; r < m_size; ++r)
+        {
+            for (size_t c = firstCol(r); c < lastCol(r); ++c)
+                result(r, c) = (*this)(r, c);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Converts to a fixed-size matrix.
+     * @throw std::invalid_argument if the matrix is not N x N.
+     */
+    template<size_t N, typename layout = glg::RowMajor>
+    myMatrix<T, N, N, layout> toMatrix() const
+    {
+        if (m_size != N)
+            throw std::invalid_argument("size must be equal");
+
+        myMatrix<T, N, N, layout> result;
+        for (size_t r = 0; r < N; ++r)
+        {
+            for (size_t c = firstCol(r); c < lastCol(r); ++c)
+                result(r, c) = (*this)(r, c);
+        }
+        return result;
+    }
+
+    size_t rows() const
+    {
+        return m_size;
+    }
+
+    size_t cols() const
+    {
+        return m_size;
+    }
+
+    size_t lowerBandwidth() const
+    {
+        return m_lower;
+    }
+
+    size_t upperBandwidth() const
+    {
+        return m_upper;
+    }
+
+    /** Number of stored elements, padding included. */
+    size_t packedSize() const
+    {
+        return m_values.size();
+    }
+
+    std::span<const T> values() const
+    {
+        return m_values;
+    }
+
+    std::span<T> values()
+    {
+        return m_values;
+    }
+
+private:
+    size_t m_size;            ///< Number of rows and columns
+    size_t m_lower;           ///< Number of diagonals below the main one
+    size_t m_upper;           ///< Number of diagonals above the main one
+    std::vector<T> m_values;  ///< size rows of lower + upper + 1 elements
+};
+
+namespace Math
+{
+    namespace detail
+    {
+        /** Products reading fewer stored elements than this run on the calling thread. */
+        constexpr size_t packedParallelThreshold = 1 << 16;
+
+        /**
+         * @brief Dot product of two contiguous ranges.
+         */
+        template<typename T>
+        T packedDot(const T* a, const T* b, size_t count)
+        {
+            size_t i = 0;
+            T result = T(0);
+#if GLG_HAS_AVX2 && GLG_HAS_FMA
+            if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+            {
+                using S = SimdTraits<T>;
+                constexpr size_t L = S::lanes;
+                typename S::reg acc0 = S::zero(), acc1 = S::zero();
+                for (; i + 2 * L <= count; i += 2 * L)
+                {
+                    acc0 = S::fmadd(S::loadu(a + i), S::loadu(b + i), acc0);
+                    acc1 = S::fmadd(S::loadu(a + i + L), S::loadu(b + i + L), acc1);
+                }
+                alignas(32) T lanes[L];
+                S::storeu(lanes, S::add(acc0, acc1));
+                for (size_t lane = 0; lane < L; ++lane)
+                    result += lanes[lane];
+            }
+#endif
+            for (; i < count; ++i)
+                result += a[i] * b[i];
+            return result;
+        }
+
+        /**
+         * @brief y[0, count) += alpha * x[0, count).
+         */
+        template<typename T>
+        void packedAxpy(T alpha, const T* x, T* y, size_t count)
+        {
+            size_t i = 0;
+#if GLG_HAS_AVX2 && GLG_HAS_FMA
+            if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+            {
+                using S = SimdTraits<T>;
+                constexpr size_t L = S::lanes;
+                const typename S::reg factor = S::set1(alpha);
+                for (; i + L <= count; i += L)
+                    S::storeu(y + i, S::fmadd(factor, S::loadu(x + i), S::loadu(y + i)));
+            }
+#endif
+            for (; i < count; ++i)
+                y[i] += alpha * x[i];
+        }
+
+        /**
+         * @brief Returns the dot product of row and x while adding alpha * row to y, all over [0, count).
+         * Row r of a packed symmetric matrix is read once for both its row and its column.
+         */
+        template<typename T>
+        T packedDotAxpy(const T* row, const T* x, T alpha, T* y, size_t count)
+        {
+            size_t i = 0;
+            T result = T(0);
+#if GLG_HAS_AVX2 && GLG_HAS_FMA
+            if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+            {
+                using S = SimdTraits<T>;
+                constexpr size_t L = S::lanes;
+                const typename S::reg factor = S::set1(alpha);
+                typename S::reg acc0 = S::zero(), acc1 = S::zero();
+                for (; i + 2 * L <= count; i += 2 * L)
+                {
+                    const typename S::reg a0 = S::loadu(row + i), a1 = S::loadu(row + i + L);
+                    acc0 = S::fmadd(a0, S::loadu(x + i), acc0);
+                    acc1 = S::fmadd(a1, S::loadu(x + i + L), acc1);
+                    S::storeu(y + i, S::fmadd(factor, a0, S::loadu(y + i)));
+                    S::storeu(y + i + L, S::fmadd(factor, a1, S::loadu(y + i + L)));
+                }
+                alignas(32) T lanes[L];
+                S::storeu(lanes, S::add(acc0, acc1));
+                for (size_t lane = 0; lane < L; ++lane)
+                    result += lanes[lane];
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                result += row[i] * x[i];
+                y[i] += alpha * row[i];
+            }
+            return result;
+        }
+
+        /**
+         * @brief Runs func(firstRow, lastRow) over the rows of a packed matrix, in parallel when it is large.
+         */
+        template<typename Func>
+        void forEachPackedRows(size_t rows, size_t packedSize, Func&& func)
+        {
+            if (packedSize < packedParallelThreshold || glg::ThreadPool::global().size() == 1)
+                func(size_t(0), rows);
+            else
+                glg::ThreadPool::global().parallelFor(0, rows, 64, func);
+        }
+
+        /**
+         * @brief Solves op(A) X = B in place for a packed triangular A, op being the identity or the transposition.
+         *
+         * Without transposition, each row of X is a dot product of a row of A
+         * with the rows of X already known. With it, the rows of A are columns
+         * of A^T: each solved row of X is subtracted from the rows still to
+         * solve, an AXPY along the row of A. Either way A is read by rows.
+         */
+        template<typename T, glg::Triangle triangle>
+        void triangularSolve(const myTriangularMatrix<T, triangle>& a, myMatrixView<T> b, bool transposed)
+        {
+            constexpr bool lower = triangle == glg::Triangle::Lower;
+            const size_t n = a.rows();
+            const size_t k = b.cols();
+            const T* values = a.values().data();
+            const bool vector = k == 1 && b.rowStride() == 1;
+            T* x = b.data();
+
+            // Lower without transposition and upper transposed go forward, the two others backward
+            const bool forward = lower != transposed;
+            for (size_t step = 0; step < n; ++step)
+            {
+                const size_t i = forward ? step : n - 1 - step;
+                const T* row = values + a.rowOffset(i);
+                const size_t first = a.firstCol(i);
+                const T diagonal = row[i - first];
+                if (diagonal == T(0))
+                    throw std::runtime_error("matrix is singular");
+
+                if (!transposed)
+                {
+                    // Columns of the row other than the diagonal are already solved
+                    const size_t begin = lower ? first : i + 1;
+                    const size_t end = lower ? i : a.lastCol(i);
+                    if (vector)
+                        x[i] = (x[i] - packedDot(row + begin - first, x + begin, end - begin)) / diagonal;
+                    else
+                    {
+                        for (size_t j = begin; j < end; ++j)
+                        {
+                            const T aij = row[j - first];
+                            for (size_t c = 0; c < k; ++c)
+                                b(i, c) -= aij * b(j, c);
+                        }
+                        for (size_t c = 0; c < k; ++c)
+                            b(i, c) /= diagonal;
+                    }
+                }
+                else
+                {
+                    // Row i of A is column i of A^T: x_i is final, it is removed from the rows left
+                    const size_t begin = lower ? first : i + 1;
+                    const size_t end = lower ? i : a.lastCol(i);
+                    if (vector)
+                    {
+                        x[i] /= diagonal;
+                        packedAxpy(T(-x[i]), row + begin - first, x + begin, end - begin);
+                    }
+                    else
+                    {
+                        for (size_t c = 0; c < k; ++c)
+                            b(i, c) /= diagonal;
+                        for (size_t j = begin; j < end; ++j)
+                        {
+                            const T aij = row[j - first];
+                            for (size_t c = 0; c < k; ++c)
+                                b(j, c) -= aij * b(i, c);
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Solves A X = B in place for a band A: LU with partial pivoting, on a copy with room for the fill-in.
+         *
+         * Swapping rows widens the upper band by lower diagonals, so the copy
+         * stores for every row r the columns [r - lower, r + lower + upper].
+         */
+        template<typename T>
+        void bandSolve(const myBandMatrix<T>& a, myMatrixView<T> b)
+        {
+            const size_t n = a.rows();
+            const size_t kl = a.lowerBandwidth();
+            const size_t ku = a.upperBandwidth() + kl;
+            const size_t width = kl + ku + 1;
+            const size_t k = b.cols();
+
+            std::vector<T> lu(n * width, T(0));
+            const auto at = [&](size_t row, size_t col) -> T& { return lu[row * width + kl + col - row]; };
+            for (size_t r = 0; r < n; ++r)
+            {
+                for (size_t c = a.firstCol(r); c < a.lastCol(r); ++c)
+                    at(r, c) = a(r, c);
+            }
+
+            for (size_t p = 0; p < n; ++p)
+            {
+                const size_t lastRow = std::min(n, p + kl + 1);
+                const size_t lastCol = std::min(n, p + ku + 1);
+
+                size_t pivot = p;
+                for (size_t r = p + 1; r < lastRow; ++r)
+                {
+                    if (std::abs(at(r, p)) > std::abs(at(pivot, p)))
+                        pivot = r;
+                }
+                if (at(pivot, p) == T(0))
+                    throw std::runtime_error("matrix is singular");
+
+                if (pivot != p)
+                {
+                    std::swap_ranges(&at(p, p), &at(p, p) + (lastCol - p), &at(pivot, p));
+                    for (size_t c = 0; c < k; ++c)
+                        std::swap(b(p, c), b(pivot, c));
+                }
+
+                const T* pivotRow = &at(p, p);
+                for (size_t r = p + 1; r < lastRow; ++r)
+                {
+                    const T factor = at(r, p) / pivotRow[0];
+                    if (factor == T(0))
+                        continue;
+                    packedAxpy(T(-factor), pivotRow + 1, &at(r, p + 1), lastCol - p - 1);
+                    for (size_t c = 0; c < k; ++c)
+                        b(r, c) -= factor * b(p, c);
+                }
+            }
+
+            // Back substitution on the upper band of width ku
+            for (size_t step = 0; step < n; ++step)
+            {
+                const size_t i = n - 1 - step;
+                const T* row = &at(i, i);
+                const size_t count = std::min(n, i + ku + 1) - i - 1;
+                if (k == 1 && b.rowStride() == 1)
+                {
+                    T* x = b.data();
+                    x[i] = (x[i] - packedDot(row + 1, x + i + 1, count)) / row[0];
+                }
+                else
+                {
+                    for (size_t j = 0; j < count; ++j)
+                    {
+                        for (size_t c = 0; c < k; ++c)
+                            b(i, c) -= row[j + 1] * b(i + 1 + j, c);
+                    }
+                    for (size_t c = 0; c < k; ++c)
+                        b(i, c) /= row[0];
+                }
+            }
+        }
+
+        template<typename M>
+        struct IsPacked : std::false_type {};
+
+        template<typename T, glg::Triangle triangle>
+        struct IsPacked<myTriangularMatrix<T, triangle>> : std::true_type {};
+
+        template<typename T>
+        struct IsPacked<mySymmetricMatrix<T>> : std::true_type {};
+
+        template<typename T>
+        struct IsPacked<myBandMatrix<T>> : std::true_type {};
+    }
+
+    /**
+     * @brief Matrix types of this header, accepted by the generic overloads.
+     */
+    template<typename M>
+    concept PackedMatrix = detail::IsPacked<std::remove_cvref_t<M>>::value;
+
+    /**
+     * @brief Triangular matrix-vector product y = A * x, a dot product per stored row.
+     *
+     * @param matrix The n x n matrix A.
+     * @param x The n input elements.
+     * @param y The n output elements, it must not overlap x.
+     */
+    template<typename T, glg::Triangle triangle>
+    void multiply(const myTriangularMatrix<T, triangle>& matrix, const T* x, T* y)
+    {
+        const T* values = matrix.values().data();
+        detail::forEachPackedRows(matrix.rows(), matrix.packedSize(), [&](size_t firstRow, size_t lastRow)
+        {
+            for (size_t r = firstRow; r < lastRow; ++r)
+            {
+                const size_t first = matrix.firstCol(r);
+                y[r] = detail::packedDot(values + matrix.rowOffset(r), x + first, matrix.lastCol(r) - first);
+            }
+        });
+    }
+
+    /**
+     * @brief Symmetric matrix-vector product y = A * x.
+     *
+     * Stored row r of the lower triangle is both row r and column r of A:
+     * it gives y[r] as a dot product and adds x[r] times the row to
+     * y[0, r), so every stored element is read once. Large products give
+     * each thread a private copy of y, summed at the end.
+     *
+     * @param matrix The n x n matrix A.
+     * @param x The n input elements.
+     * @param y The n output elements, it must not overlap x.
+     */
+    template<typename T>
+    void multiply(const mySymmetricMatrix<T>& matrix, const T* x, T* y)
+    {
+        const size_t n = matrix.rows();
+        const T* values = matrix.values().data();
+        const auto rows = [&](size_t firstRow, size_t lastRow, T* out)
+        {
+            for (size_t r = firstRow; r < lastRow; ++r)
+            {
+                const T* row = values + r * (r + 1) / 2;
+                out[r] += detail::packedDotAxpy(row, x, x[r], out, r) + row[r] * x[r];
+            }
+        };
+
+        std::fill(y, y + n, T(0));
+        glg::ThreadPool& pool = glg::ThreadPool::global();
+        if (matrix.packedSize() < detail::packedParallelThreshold || pool.size() == 1)
+        {
+            rows(0, n, y);
+            return;
+        }
+
+        // Rows are split so that every chunk holds about the same number of elements
+        const size_t chunks = pool.size();
+        std::vector<size_t> bounds(chunks + 1, n);
+        bounds[0] = 0;
+        for (size_t chunk = 1; chunk < chunks; ++chunk)
+            bounds[chunk] = std::max(bounds[chunk - 1], size_t(double(n) * std::sqrt(double(chunk) / double(chunks))));
+
+        std::vector<std::vector<T>> partial(chunks);
+        pool.run(chunks, [&](size_t chunk)
+        {
+            partial[chunk].assign(bounds[chunk + 1], T(0));
+            rows(bounds[chunk], bounds[chunk + 1], partial[chunk].data());
+        });
+        for (const std::vector<T>& part : partial)
+            detail::packedAxpy(T(1), part.data(), y, part.size());
+    }
+
+    /**
+     * @brief Band matrix-vector product y = A * x, a dot product of lower + upper + 1 elements per row.
+     *
+     * @param matrix The n x n matrix A.
+     * @param x The n input elements.
+     * @param y The n output elements, it must not overlap x.
+     */
+    template<typename T>
+    void multiply(const myBandMatrix<T>& matrix, const T* x, T* y)
+    {
+        detail::forEachPackedRows(matrix.rows(), matrix.packedSize(), [&](size_t firstRow, size_t lastRow)
+        {
+            for (size_t r = firstRow; r < lastRow; ++r)
+            {
+                const size_t first = matrix.firstCol(r);
+                y[r] = detail::packedDot(&matrix(r, first), x + first, matrix.lastCol(r) - first);
+            }
+        });
+    }
+
+    /**
+     * @brief Packed matrix-vector product with fixed-size vectors.
+     * @throw std::invalid_argument if the sizes do not match the matrix or y is x.
+     */
+    template<PackedMatrix M, typename T, size_t N>
+    void multiply(const M& matrix, const myVectorND<T, N>& x, myVectorND<T, N>& y)
+    {
+        if (matrix.rows() != N)
+            throw std::invalid_argument("size must be equal");
+        if (x.data() == y.data())
+            throw std::invalid_argument("result must not alias an operand");
+
+        multiply(matrix, x.data(), y.data());
+    }
+
+    /**
+     * @brief Packed matrix-dense matrix product C = A * B.
+     *
+     * Row r of C is the sum of the rows of B weighted by the row r of A, an
+     * AXPY per stored element. A symmetric A reads the part of row r above
+     * the diagonal from column r of the stored triangle. Rows of C are
+     * independent and split over the global pool.
+     *
+     * @param matrix The n x n packed matrix A.
+     * @param dense The n x cols matrix B.
+     * @param result The n x cols matrix C, it must not overlap B.
+     * @throw std::invalid_argument if the shapes do not match.
+     */
+    template<PackedMatrix M, typename T = typename M::value_type>
+    void multiply(const M& matrix, std::type_identity_t<myMatrixView<const T>> dense, std::type_identity_t<myMatrixView<T>> result)
+    {
+        if (matrix.cols() != dense.rows() || result.rows() != matrix.rows() || result.cols() != dense.cols())
+            throw std::invalid_argument("size must be equal");
+
+        const size_t n = matrix.rows();
+        const size_t cols = dense.cols();
+        const bool contiguous = dense.isRowContiguous() && result.isRowContiguous();
+        const auto addRow = [&](size_t r, T weight, size_t source)
+        {
+            if (contiguous)
+                detail::packedAxpy(weight, &dense(source, 0), &result(r, 0), cols);
+            else
+            {
+                for (size_t c = 0; c < cols; ++c)
+                    result(r, c) += weight * dense(source, c);
+            }
+        };
+
+        detail::forEachPackedRows(n, matrix.packedSize() * cols, [&](size_t firstRow, size_t lastRow)
+        {
+            for (size_t r = firstRow; r < lastRow; ++r)
+            {
+                for (size_t c = 0; c < cols; ++c)
+                    result(r, c) = T(0);
+
+                if constexpr (std::is_same_v<M, mySymmetricMatrix<T>>)
+                {
+                    for (size_t j = 0; j < n; ++j)
+                        addRow(r, matrix(r, j), j);
+                }
+                else
+                {
+                    for (size_t j = matrix.firstCol(r); j < matrix.lastCol(r); ++j)
+                        addRow(r, matrix(r, j), j);
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Solves A X = B in place, B holding one right-hand side per column.
+     * @throw std::invalid_argument if B does not have one row per row of A.
+     * @throw std::runtime_error if A is singular.
+     */
+    template<typename T, glg::Triangle triangle>
+    void solveInPlace(const myTriangularMatrix<T, triangle>& matrix, std::type_identity_t<myMatrixView<T>> b)
+    {
+        if (b.rows() != matrix.rows())
+            throw std::invalid_argument("size must be equal");
+
+        detail::triangularSolve(matrix, b, false);
+    }
+
+    /**
+     * @brief Solves A^T X = B in place, without transposing A.
+     * @throw std::invalid_argument if B does not have one row per row of A.
+     * @throw std::runtime_error if A is singular.
+     */
+    template<typename T, glg::Triangle triangle>
+    void solveTransposedInPlace(const myTriangularMatrix<T, triangle>& matrix, std::type_identity_t<myMatrixView<T>> b)
+    {
+        if (b.rows() != matrix.rows())
+            throw std::invalid_argument("size must be equal");
+
+        detail::triangularSolve(matrix, b, true);
+    }
+
+    /**
+     * @brief Solves A X = B in place for a symmetric positive definite A, through its packed Cholesky factor.
+     * Factor once with cholesky() to solve several systems with the same matrix.
+     * @throw std::invalid_argument if B does not have one row per row of A.
+     * @throw std::runtime_error if A is not positive definite.
+     */
+    template<typename T>
+    void solveInPlace(const mySymmetricMatrix<T>& matrix, std::type_identity_t<myMatrixView<T>> b)
+    {
+        if (b.rows() != matrix.rows())
+            throw std::invalid_argument("size must be equal");
+
+        const myTriangularMatrix<T> factor = matrix.cholesky();
+        detail::triangularSolve(factor, b, false);
+        detail::triangularSolve(factor, b, true);
+    }
+
+    /**
+     * @brief Solves A X = B in place for a band A, by LU with partial pivoting.
+     * @throw std::invalid_argument if B does not have one row per row of A.
+     * @throw std::runtime_error if A is singular.
+     */
+    template<typename T>
+    void solveInPlace(const myBandMatrix<T>& matrix, std::type_identity_t<myMatrixView<T>> b)
+    {
+        if (b.rows() != matrix.rows())
+            throw std::invalid_argument("size must be equal");
+
+        detail::bandSolve(matrix, b);
+    }
+
+    /**
+     * @brief Solves A x = b in place for a vector of values.
+     */
+    template<PackedMatrix M, typename T = typename M::value_type>
+    void solveInPlace(const M& matrix, std::span<T> b)
+    {
+        solveInPlace(matrix, myMatrixView<T>(b.data(), b.size(), 1, 1, 1));
+    }
+
+    /**
+     * @brief Solves A x = b.
+     * @return The solution x.
+     */
+    template<PackedMatrix M, typename T, size_t N>
+    myVectorND<T, N> solve(const M& matrix, const myVectorND<T, N>& b)
+    {
+        myVectorND<T, N> result(b);
+        solveInPlace(matrix, myMatrixView<T>(result.data(), N, 1, 1, 1));
+        return result;
+    }
+
+    /**
+     * @brief Solves A X = B, B holding one right-hand side per column.
+     * @return The solution X.
+     */
+    template<PackedMatrix M, typename T>
+    myDynMatrix<T> solve(const M& matrix, const myDynMatrix<T>& b)
+    {
+        myDynMatrix<T> result(b);
+        solveInPlace(matrix, result.view());
+        return result;
+    }
+};
+
+template<typename T>
+myTriangularMatrix<T, glg::Triangle::Lower> mySymmetricMatrix<T>::cholesky() const
+{
+    // Row-oriented Cholesky: L(r, c) is a dot product of the rows r and c of L, both already packed
+    myTriangularMatrix<T, glg::Triangle::Lower> factor(m_size);
+    T* l = factor.values().data();
+    for (size_t r = 0; r < m_size; ++r)
+    {
+        T* row = l + r * (r + 1) / 2;
+        for (size_t c = 0; c < r; ++c)
+        {
+            const T* other = l + c * (c + 1) / 2;
+            row[c] = ((*this)(r, c) - Math::detail::packedDot(row, other, c)) / other[c];
+        }
+
+        const T diagonal = (*this)(r, r) - Math::detail::packedDot(row, row, r);
+        if (!(diagonal > T(0)))
+            throw std::runtime_error("matrix is not positive definite");
+        row[r] = std::sqrt(diagonal);
+    }
+    return factor;
+}
+
+/**
+ * @brief Packed matrix-vector product.
+ * @throw std::invalid_argument if the matrix is not N x N.
+ */
+template<Math::PackedMatrix M, typename T, size_t N>
+myVectorND<T, N> operator*(const M& matrix, const myVectorND<T, N>& x)
+{
+    myVectorND<T, N> result(glg::uninitialized);
+    Math::multiply(matrix, x, result);
+    return result;
+}
+
+/**
+ * @brief Packed matrix-dense matrix product.
+ * @throw std::invalid_argument if the inner dimensions differ.
+ */
+template<Math::PackedMatrix M>
+myDynMatrix<typename M::value_type> operator*(const M& matrix, const myDynMatrix<typename M::value_type>& dense)
+{
+    myDynMatrix<typename M::value_type> result(matrix.rows(), dense.cols());
+    Math::multiply(matrix, dense.view(), result.view());
+    return result;
+}
+
+/**
+ * @brief Stream insertion operator for packed matrices, printed dense, one row per line.
+ */
+template<Math::PackedMatrix M>
+std::ostream& operator<<(std::ostream& os, const M& matrix)
+{
+    for (size_t i = 0; i < matrix.rows(); ++i)
+    {
+        os << "(";
+        for (size_t j = 0; j < matrix.cols(); ++j)
+        {
+            os << matrix.getCell(i, j);
+            if (j != matrix.cols() - 1)
+                os << ",";
+        }
+        os << ")" << std::endl;
+    }
+    return os;
+}
@@ -0,0 +1,342 @@
+/**
+ * @file myParallelSort.h
+ * @brief Implementation of glg::parallel_sort and glg::parallel_stable_sort, a task-parallel merge sort and a sample sort
+ * running on glg::ThreadPool.
+ * @author Guillaume
+ * @date 18/10/2026
+ *
+ * Up to a million elements, the range is sorted by a fork-join merge
+ * sort: both halves are sorted as two tasks of the pool, down to about four
+ * leaves per thread, then merged by all threads at once. Each part of a
+ * merge finds its inputs by co-ranking (a binary search for how many
+ * elements of each run precede a given output position), so the merges
+ * need no synchronisation. As in glg::FusionSort, the levels ping-pong
+ * between the range and one buffer allocated for the whole sort.
+ *
+ * Larger ranges are sorted by a sample sort, which moves the data three
+ * times instead of once per level. Splitters drawn from a random sample cut
+ * the range into a few buckets per thread, each thread scatters its block
+ * of the range to the buckets, then the buckets are sorted independently.
+ * Keys equal to a splitter get a bucket of their own that needs no sorting,
+ * so inputs with many duplicates stay balanced.
+ *
+ * parallel_stable_sort keeps equal elements in their original order, at
+ * the cost of merge sorts at the leaves instead of introsorts.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <vector>
+#include "helper.h"
+#include "myThreadPool.h"
+
+namespace glg
+{
+    namespace detail
+    {
+        /** Below this many elements a sort, or a branch of the merge sort, stays on one thread. */
+        constexpr std::ptrdiff_t parallelSortThreshold = std::ptrdiff_t(1) << 15;
+
+        /** From this many elements on, the sample sort replaces the merge sort. */
+        constexpr std::ptrdiff_t sampleSortThreshold = std::ptrdiff_t(1) << 20;
+
+        /** Minimum number of elements per task of a parallel copy or merge. */
+        constexpr std::ptrdiff_t parallelGrain = std::ptrdiff_t(1) << 14;
+
+        /** Sample elements drawn per splitter of the sample sort. */
+        constexpr std::ptrdiff_t oversampling = 16;
+
+        /**
+         * @brief Number of elements of a that precede output position rank in the stable merge of a and b.
+         * The other rank - result elements come from b.
+         */
+        template<typename Source, typename Compare>
+        std::ptrdiff_t coRank(std::ptrdiff_t rank, Source a, std::ptrdiff_t countA, Source b, std::ptrdiff_t countB, Compare comp)
+        {
+            std::ptrdiff_t low = std::max<std::ptrdiff_t>(0, rank - countB);
+            std::ptrdiff_t high = std::min(rank, countA);
+            while (low < high)
+            {
+                const std::ptrdiff_t i = low + (high - low) / 2;
+
+                // a[i] goes before b[rank - i - 1]: the first rank outputs take more of a
+                if (!comp(b[rank - i - 1], a[i]))
+                    low = i + 1;
+                else
+                    high = i;
+            }
+            return low;
+        }
+
+        /**
+         * @brief Stable merge of the sorted runs a and b into out, split into equal parts of the output merged in parallel.
+         */
+        template<typename Source, typename Destination, typename Compare>
+        void parallelMerge(ThreadPool& pool, Source a, std::ptrdiff_t countA, Source b, std::ptrdiff_t countB, Destination out, Compare comp)
+        {
+            const std::ptrdiff_t total = countA + countB;
+            const std::ptrdiff_t parts = std::clamp<std::ptrdiff_t>(total / parallelGrain, 1, 4 * std::ptrdiff_t(pool.size()));
+
+            // The splits are found before any element is moved out of a or b
+            std::vector<std::ptrdiff_t> splits(parts + 1);
+            for (std::ptrdiff_t part = 0; part <= parts; ++part)
+                splits[part] = coRank(total * part / parts, a, countA, b, countB, comp);
+
+            pool.run(size_t(parts), [&](size_t part)
+            {
+                const std::ptrdiff_t begin = total * std::ptrdiff_t(part) / parts;
+                const std::ptrdiff_t end = total * std::ptrdiff_t(part + 1) / parts;
+                const std::ptrdiff_t beginA = splits[part];
+                const std::ptrdiff_t endA = splits[part + 1];
+                mergeMove(a + beginA, a + endA, b + (begin - beginA), b + (end - endA), out + begin, comp);
+            });
+        }
+
+        /**
+         * @brief Sorts the count elements of dst, src holding the same elements and serving as scratch, like
+         * fusionSortInto(), the two halves being sorted as two tasks for depth levels.
+         */
+        template<typename Source, typename Destination, typename Compare>
+        void parallelFusionSortInto(ThreadPool& pool, Source src, Destination dst, std::ptrdiff_t count, int depth, bool stable, Compare comp)
+        {
+            if (depth == 0 || count < parallelSortThreshold)
+            {
+                if (stable)
+                    fusionSortInto(src, dst, count, comp);
+                else
+                    introsort(dst, dst + count, comp);
+                return;
+            }
+
+            const std::ptrdiff_t half = count / 2;
+            pool.run(2, [&](size_t task)
+            {
+                if (task == 0)
+                    parallelFusionSortInto(pool, dst, src, half, depth - 1, stable, comp);
+                else
+                    parallelFusionSortInto(pool, dst + half, src + half, count - half, depth - 1, stable, comp);
+            });
+            parallelMerge(pool, src, half, src + half, count - half, dst, comp);
+        }
+
+        /**
+         * @brief Sample sort of [first, first + count), buffer holding count elements of scratch.
+         *
+         * With s_0 < ... < s_m-1 the splitters, bucket 2j holds the elements
+         * between s_j-1 and s_j and bucket 2j + 1 the elements equal to s_j.
+         * The scatter keeps the order of the range within a bucket, so sorting
+         * the buckets stably makes the whole sort stable.
+         */
+        template<typename Iterator, typename Buffer, typename Compare>
+        void sampleSort(ThreadPool& pool, Iterator first, std::ptrdiff_t count, Buffer buffer, bool stable, Compare comp)
+        {
+            using ValueType = typename std::iterator_traits<Iterator>::value_type;
+            const std::ptrdiff_t threads = std::ptrdiff_t(pool.size());
+
+            // Every oversampling-th element of a sorted random sample, without duplicates
+            std::vector<ValueType> splitters;
+            {
+                const std::ptrdiff_t splitterCount = std::min<std::ptrdiff_t>(4 * threads - 1, 4095);
+                std::vector<ValueType> sample;
+                sample.reserve(splitterCount * oversampling);
+                std::mt19937_64 generator(count);
+                for (std::ptrdiff_t i = 0; i < splitterCount * oversampling; ++i)
+                    sample.push_back(first[std::ptrdiff_t(generator() % std::uint64_t(count))]);
+                introsort(sample.begin(), sample.end(), comp);
+
+                for (std::ptrdiff_t i = 1; i <= splitterCount; ++i)
+                {
+                    const ValueType& splitter = sample[i * oversampling - 1];
+                    if (splitters.empty() || comp(splitters.back(), splitter))
+                        splitters.push_back(splitter);
+                }
+            }
+
+            const std::ptrdiff_t bucketCount = 2 * std::ptrdiff_t(splitters.size()) + 1;
+            const std::ptrdiff_t blockCount = std::clamp<std::ptrdiff_t>(count / parallelGrain, 1, 4 * threads);
+            const std::ptrdiff_t blockSize = (count + blockCount - 1) / blockCount;
+            const auto bucketOf = std::make_unique_for_overwrite<std::uint16_t[]>(count);
+
+            // Classify each block, counting its elements per bucket
+            std::vector<std::ptrdiff_t> offsets(blockCount * bucketCount);
+            pool.run(size_t(blockCount), [&](size_t block)
+            {
+                std::ptrdiff_t* counts = offsets.data() + std::ptrdiff_t(block) * bucketCount;
+                const std::ptrdiff_t end = std::min(std::ptrdiff_t(block + 1) * blockSize, count);
+                for (std::ptrdiff_t i = std::ptrdiff_t(block) * blockSize; i < end; ++i)
+                {
+                    const ValueType& value = first[i];
+                    const std::ptrdiff_t j = std::lower_bound(splitters.begin(), splitters.end(), value, comp) - splitters.begin();
+                    const std::ptrdiff_t bucket = 2 * j + (j < std::ptrdiff_t(splitters.size()) && !comp(value, splitters[j]));
+                    bucketOf[i] = std::uint16_t(bucket);
+                    ++counts[bucket];
+                }
+            });
+
+            // Bucket b of block k starts after the smaller buckets of every block and after bucket b of the previous blocks
+            std::vector<std::ptrdiff_t> bucketStart(bucketCount + 1);
+            std::ptrdiff_t position = 0;
+            for (std::ptrdiff_t bucket = 0; bucket < bucketCount; ++bucket)
+            {
+                bucketStart[bucket] = position;
+                for (std::ptrdiff_t block = 0; block < blockCount; ++block)
+                {
+                    const std::ptrdiff_t size = offsets[block * bucketCount + bucket];
+                    offsets[block * bucketCount + bucket] = position;
+                    position += size;
+                }
+            }
+            bucketStart[bucketCount] = count;
+
+            pool.run(size_t(blockCount), [&](size_t block)
+            {
+                std::ptrdiff_t* next = offsets.data() + std::ptrdiff_t(block) * bucketCount;
+                const std::ptrdiff_t end = std::min(std::ptrdiff_t(block + 1) * blockSize, count);
+                for (std::ptrdiff_t i = std::ptrdiff_t(block) * blockSize; i < end; ++i)
+                    buffer[next[bucketOf[i]]++] = std::move(first[i]);
+            });
+
+            // Sort the buckets back into the range, the buckets of equal keys are already in order
+            pool.run(size_t(bucketCount), [&](size_t bucket)
+            {
+                const std::ptrdiff_t begin = bucketStart[bucket];
+                const std::ptrdiff_t size = bucketStart[bucket + 1] - begin;
+                if (bucket % 2 == 1 || size < 2)
+                    glg::move(buffer + begin, buffer + (begin + size), first + begin);
+                else if (stable)
+                {
+                    glg::copy(buffer + begin, buffer + (begin + size), first + begin);
+                    fusionSortInto(buffer + begin, first + begin, size, comp);
+                }
+                else
+                {
+                    glg::move(buffer + begin, buffer + (begin + size), first + begin);
+                    introsort(first + begin, first + (begin + size), comp);
+                }
+            });
+        }
+
+        /**
+         * @brief Sorts [first, last) on pool: serially when short, by merge sort up to sampleSortThreshold, by sample sort beyond.
+         */
+        template<typename Iterator, typename Compare>
+        void parallelSort(ThreadPool& pool, Iterator first, Iterator last, bool stable, Compare comp)
+        {
+            using ValueType = typename std::iterator_traits<Iterator>::value_type;
+            const std::ptrdiff_t count = last - first;
+
+            if (count < parallelSortThreshold || pool.size() == 1)
+            {
+                if (!stable)
+                    introsort(first, last, comp);
+                else if (count > 1)
+                {
+                    std::vector<ValueType> buffer(first, last);
+                    fusionSortInto(buffer.begin(), first, count, comp);
+                }
+                return;
+            }
+
+            const auto buffer = std::make_unique_for_overwrite<ValueType[]>(count);
+            if (count >= sampleSortThreshold)
+            {
+                sampleSort(pool, first, count, buffer.get(), stable, comp);
+                return;
+            }
+
+            pool.parallelFor(0, size_t(count), size_t(parallelGrain), [&](size_t begin, size_t end)
+            {
+                glg::copy(first + std::ptrdiff_t(begin), first + std::ptrdiff_t(end), buffer.get() + begin);
+            });
+
+            // About four leaves per thread
+            int depth = 2;
+            for (size_t threads = 1; threads < pool.size(); threads *= 2)
+                ++depth;
+            parallelFusionSortInto(pool, buffer.get(), first, count, depth, stable, comp);
+        }
+    }
+
+    /**
+     * @brief Sort a random-access range on the threads of pool.
+     *
+     * Merge sort with parallel merges up to 1M elements, sample sort beyond,
+     * introsort on the calling thread below 32K elements. The sort is not
+     * stable and allocates one buffer of distance(first, last) elements.
+     *
+     * @tparam Iterator Random-access iterator type.
+     * @tparam Compare Strict weak ordering of the projected elements.
+     * @tparam Projection Applied to each element before comparing.
+     * @param pool The threads sorting the range.
+     * @param first Iterator to the first element in the range.
+     * @param last Iterator to the last element in the range.
+     * @param comp The ordering, ascending by default.
+     * @param proj The projection, the element itself by default.
+     */
+    template<std::random_access_iterator Iterator, typename Compare = std::less<>, typename Projection = std::identity>
+    void parallel_sort(ThreadPool& pool, Iterator first, Iterator last, Compare comp = {}, Projection proj = {})
+    {
+        detail::parallelSort(pool, first, last, false, detail::projectedComparator(comp, proj));
+    }
+
+    /**
+     * @brief Sort a random-access range on the global pool.
+     *
+     * @tparam Iterator Random-access iterator type.
+     * @tparam Compare Strict weak ordering of the projected elements.
+     * @tparam Projection Applied to each element before comparing.
+     * @param first Iterator to the first element in the range.
+     * @param last Iterator to the last element in the range.
+     * @param comp The ordering, ascending by default.
+     * @param proj The projection, the element itself by default.
+     */
+    template<std::random_access_iterator Iterator, typename Compare = std::less<>, typename Projection = std::identity>
+    void parallel_sort(Iterator first, Iterator last, Compare comp = {}, Projection proj = {})
+    {
+        parallel_sort(ThreadPool::global(), first, last, comp, proj);
+    }
+
+    /**
+     * @brief Sort a random-access range on the threads of pool, keeping equal elements in their original order.
+     *
+     * Same algorithms as parallel_sort(), with merge sorts instead of
+     * introsorts for the pieces sorted by a single thread.
+     *
+     * @tparam Iterator Random-access iterator type.
+     * @tparam Compare Strict weak ordering of the projected elements.
+     * @tparam Projection Applied to each element before comparing.
+     * @param pool The threads sorting the range.
+     * @param first Iterator to the first element in the range.
+     * @param last Iterator to the last element in the range.
+     * @param comp The ordering, ascending by default.
+     * @param proj The projection, the element itself by default.
+     */
+    template<std::random_access_iterator Iterator, typename Compare = std::less<>, typename Projection = std::identity>
+    void parallel_stable_sort(ThreadPool& pool, Iterator first, Iterator last, Compare comp = {}, Projection proj = {})
+    {
+        detail::parallelSort(pool, first, last, true, detail::projectedComparator(comp, proj));
+    }
+
+    /**
+     * @brief Sort a random-access range on the global pool, keeping equal elements in their original order.
+     *
+     * @tparam Iterator Random-access iterator type.
+     * @tparam Compare Strict weak ordering of the projected elements.
+     * @tparam Projection Applied to each element before comparing.
+     * @param first Iterator to the first element in the range.
+     * @param last Iterator to the last element in the range.
+     * @param comp The ordering, ascending by default.
+     * @param proj The projection, the element itself by default.
+     */
+    template<std::random_access_iterator Iterator, typename Compare = std::less<>, typename Projection = std::identity>
+    void parallel_stable_sort(Iterator first, Iterator last, Compare comp = {}, Projection proj = {})
+    {
+        parallel_stable_sort(ThreadPool::global(), first, last, comp, proj);
+    }
+};
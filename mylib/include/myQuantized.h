@@ -0,0 +1,500 @@
+/**
+ * @file myQuantized.h
+ * @brief Implementation of int8 quantized matrices, with their products accumulated in int32.
+ * @author Guillaume
+ * @date 18/10/2026
+ *
+ * Every row of a myQuantizedMatrix is stored as int8 values q with its own
+ * scale and zero point, the real value being scale * (q - zeroPoint). The
+ * range of a row is mapped on [-127, 127] and always holds 0, which stays
+ * exact. A quarter of the bytes of a float matrix are read by the products,
+ * which are memory bound for matrix-vector products.
+ *
+ * The products multiply rows by rows, as a dense layer does: with the
+ * weights W (outputs x inputs) and a batch of activations A (samples x
+ * inputs), the result is A * W^T. The dot products of two int8 rows are
+ * accumulated exactly in int32, the zero points are then removed with the
+ * sums of the rows and the scales applied once per result:
+ *
+ *   sum (qa - za)(qw - zw) = sum qa qw - zw sum qa - za sum qw + inputs * za * zw
+ *
+ * With AVX2 the int8 products go through pmaddubsw, which multiplies an
+ * unsigned byte by a signed one: the left operand is made positive and its
+ * sign moved to the right one, and as no value is -128 the pairs summed in
+ * 16 bits cannot saturate. With VNNI, vpdpbusd does the products and the
+ * sums into int32 in one instruction.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+#include "myArray.h"
+#include "myGemm.h"
+#include "myLayout.h"
+#include "myMatrix.h"
+#include "myThreadPool.h"
+#include "myVectorND.h"
+#include "simdConfig.h"
+
+namespace glg
+{
+    /**
+     * @struct QuantizedRow
+     * @brief Quantization parameters of a row, its real values are scale * (q - zeroPoint).
+     */
+    struct QuantizedRow
+    {
+        float scale = 1.f;            ///< Real value of one quantization step
+        std::int32_t zeroPoint = 0;   ///< Quantized value of 0
+        std::int32_t sum = 0;         ///< Sum of the quantized values, used to remove the zero points of the products
+    };
+
+    /** Largest quantized magnitude: -128 is never used, so that the AVX2 products cannot saturate. */
+    constexpr std::int32_t quantizedMax = 127;
+
+    /**
+     * @brief Quantizes a range of floats to int8 with an affine mapping of [min, max] (widened to hold 0) on [-127, 127].
+     * @param src First float to quantize.
+     * @param dst First int8 to write.
+     * @param count Number of elements.
+     * @return The parameters of the quantized range.
+     */
+    inline QuantizedRow quantize(const float* src, std::int8_t* dst, size_t count)
+    {
+        float low = 0.f;
+        float high = 0.f;
+        for (size_t i = 0; i < count; ++i)
+        {
+            low = std::min(low, src[i]);
+            high = std::max(high, src[i]);
+        }
+
+        QuantizedRow row;
+        if (high > low)
+        {
+            row.scale = (high - low) / float(2 * quantizedMax);
+            row.zeroPoint = std::clamp(std::int32_t(std::nearbyint(-float(quantizedMax) - low / row.scale)), -quantizedMax, quantizedMax);
+        }
+
+        const float inverse = 1.f / row.scale;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const std::int32_t value = std::clamp(std::int32_t(std::nearbyint(src[i] * inverse)) + row.zeroPoint, -quantizedMax, quantizedMax);
+            dst[i] = std::int8_t(value);
+            row.sum += value;
+        }
+        return row;
+    }
+
+    /**
+     * @brief Converts a range of quantized values back to floats.
+     * @param src First int8 to convert.
+     * @param row Quantization parameters of the range.
+     * @param dst First float to write.
+     * @param count Number of elements.
+     */
+    inline void dequantize(const std::int8_t* src, const QuantizedRow& row, float* dst, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            dst[i] = row.scale * float(std::int32_t(src[i]) - row.zeroPoint);
+    }
+
+#if GLG_HAS_AVX2
+    /**
+     * @brief acc += the products of the 32 int8 of a and b, summed by groups of four into the 8 int32 lanes.
+     * a must not hold -128.
+     */
+    inline __m256i dotAccumulate(__m256i acc, __m256i a, __m256i b)
+    {
+        const __m256i magnitude = _mm256_sign_epi8(a, a);
+        const __m256i signedB = _mm256_sign_epi8(b, a);
+#if GLG_HAS_VNNI
+    #if defined(__AVX512VNNI__) && defined(__AVX512VL__)
+        return _mm256_dpbusd_epi32(acc, magnitude, signedB);
+    #else
+        return _mm256_dpbusd_avx_epi32(acc, magnitude, signedB);
+    #endif
+#else
+        const __m256i pairs = _mm256_maddubs_epi16(magnitude, signedB);
+        return _mm256_add_epi32(acc, _mm256_madd_epi16(pairs, _mm256_set1_epi16(1)));
+#endif
+    }
+
+    /**
+     * @brief Sum of the 8 int32 lanes.
+     */
+    inline std::int32_t horizontalSum(__m256i v)
+    {
+        __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4e));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xb1));
+        return _mm_cvtsi128_si32(sum);
+    }
+#endif
+
+    /**
+     * @brief Dot product of two int8 ranges, exact in int32.
+     * Neither range may hold -128, and count must stay below 2^31 / 127^2.
+     */
+    inline std::int32_t dot(const std::int8_t* lhs, const std::int8_t* rhs, size_t count)
+    {
+        size_t i = 0;
+        std::int32_t result = 0;
+#if GLG_HAS_AVX2
+        __m256i acc = _mm256_setzero_si256();
+        for (; i + 32 <= count; i += 32)
+        {
+            acc = dotAccumulate(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i)),
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i)));
+        }
+        result = horizontalSum(acc);
+#endif
+        for (; i < count; ++i)
+            result += std::int32_t(lhs[i]) * std::int32_t(rhs[i]);
+        return result;
+    }
+};
+
+/**
+ * @struct myQuantizedMatrix
+ * @brief height x width matrix of int8 values, quantized row by row.
+ * @tparam height Number of rows.
+ * @tparam width Number of columns, the length of the dot products.
+ */
+template<size_t height, size_t width>
+struct myQuantizedMatrix
+{
+    static_assert(width < (size_t(1) << 31) / (glg::quantizedMax * glg::quantizedMax), "rows too long for int32 accumulation");
+
+    using value_type = std::int8_t;
+
+    /**
+     * @brief Default constructor, a zero matrix.
+     */
+    myQuantizedMatrix() = default;
+
+    /**
+     * @brief Quantizes a float matrix in any layout, row by row.
+     * @param matrix The matrix to quantize.
+     */
+    template<typename layout>
+    explicit myQuantizedMatrix(const myMatrix<float, height, width, layout>& matrix)
+    {
+        if constexpr (glg::sameOrder<layout, glg::RowMajor, height, width>)
+            quantizeRows(matrix.data());
+        else
+            quantizeRows(myMatrix<float, height, width>(matrix).data());
+    }
+
+    /**
+     * @brief Quantizes row-major floats, row by row.
+     * @param src height * width floats, row after row.
+     */
+    explicit myQuantizedMatrix(const float* src)
+    {
+        quantizeRows(src);
+    }
+
+    /**
+     * @brief Dequantized value of an element.
+     * @throw std::out_of_range if the position is outside of the matrix.
+     */
+    float getCell(size_t row, size_t col) const
+    {
+        const std::int8_t value = m_values.getCell(row, col);
+        return m_rows[row].scale * float(std::int32_t(value) - m_rows[row].zeroPoint);
+    }
+
+    /**
+     * @brief Converts back to a float matrix.
+     */
+    template<typename layout = glg::RowMajor>
+    myMatrix<float, height, width, layout> toMatrix() const
+    {
+        myMatrix<float, height, width> result(glg::uninitialized);
+        for (size_t r = 0; r < height; ++r)
+            glg::dequantize(rowData(r), m_rows[r], result.data() + r * width, width);
+
+        if constexpr (std::is_same_v<layout, glg::RowMajor>)
+            return result;
+        else
+            return myMatrix<float, height, width, layout>(result);
+    }
+
+    /** The int8 values, row-major. */
+    const myMatrix<std::int8_t, height, width>& values() const
+    {
+        return m_values;
+    }
+
+    /** Quantization parameters of a row. */
+    const glg::QuantizedRow& rowParameters(size_t row) const
+    {
+        return m_rows[row];
+    }
+
+    const std::int8_t* rowData(size_t row) const
+    {
+        return m_values.data() + row * width;
+    }
+
+    static constexpr size_t rows()
+    {
+        return height;
+    }
+
+    static constexpr size_t cols()
+    {
+        return width;
+    }
+
+private:
+    void quantizeRows(const float* src)
+    {
+        for (size_t r = 0; r < height; ++r)
+            m_rows[r] = glg::quantize(src + r * width, m_values.data() + r * width, width);
+    }
+
+    myMatrix<std::int8_t, height, width> m_values;  ///< Quantized values, row-major
+    myArray<glg::QuantizedRow, height> m_rows;       ///< Quantization parameters of every row
+};
+
+namespace Math
+{
+    namespace detail
+    {
+        /** Products with fewer multiply-adds than this run on the calling thread. */
+        constexpr size_t quantizedParallelThreshold = 1 << 20;
+
+        /**
+         * @struct QuantizedOperand
+         * @brief Rows of int8 values with their quantization parameters.
+         */
+        struct QuantizedOperand
+        {
+            const std::int8_t* values;
+            const glg::QuantizedRow* rows;
+            size_t stride;
+        };
+
+        /**
+         * @brief Real value of an int32 product of two quantized rows of length count.
+         */
+        inline float dequantizeProduct(std::int32_t product, const glg::QuantizedRow& a, const glg::QuantizedRow& w, size_t count)
+        {
+            const std::int64_t exact = std::int64_t(product) - std::int64_t(w.zeroPoint) * a.sum - std::int64_t(a.zeroPoint) * w.sum
+                + std::int64_t(count) * a.zeroPoint * w.zeroPoint;
+            return a.scale * w.scale * float(exact);
+        }
+
+#if GLG_HAS_AVX2
+        /**
+         * @brief Products of R rows of A (1 or 2) with 4 rows of W, each 32-byte load feeding several products.
+         * The accumulators are named registers, as an array of them is not always kept out of memory.
+         */
+        template<size_t R>
+        inline void quantizedTile(const std::int8_t* a0, const std::int8_t* a1, const std::int8_t* w0, size_t strideW, size_t count,
+            std::int32_t (&out)[2][4])
+        {
+            const std::int8_t* w1 = w0 + strideW;
+            const std::int8_t* w2 = w1 + strideW;
+            const std::int8_t* w3 = w2 + strideW;
+
+            __m256i c00 = _mm256_setzero_si256(), c01 = _mm256_setzero_si256(), c02 = _mm256_setzero_si256(), c03 = _mm256_setzero_si256();
+            __m256i c10 = _mm256_setzero_si256(), c11 = _mm256_setzero_si256(), c12 = _mm256_setzero_si256(), c13 = _mm256_setzero_si256();
+            size_t k = 0;
+            for (; k + 32 <= count; k += 32)
+            {
+                const __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w0 + k));
+                const __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w1 + k));
+                const __m256i b2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w2 + k));
+                const __m256i b3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w3 + k));
+                const __m256i x0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a0 + k));
+                c00 = glg::dotAccumulate(c00, x0, b0);
+                c01 = glg::dotAccumulate(c01, x0, b1);
+                c02 = glg::dotAccumulate(c02, x0, b2);
+                c03 = glg::dotAccumulate(c03, x0, b3);
+                if constexpr (R == 2)
+                {
+                    const __m256i x1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a1 + k));
+                    c10 = glg::dotAccumulate(c10, x1, b0);
+                    c11 = glg::dotAccumulate(c11, x1, b1);
+                    c12 = glg::dotAccumulate(c12, x1, b2);
+                    c13 = glg::dotAccumulate(c13, x1, b3);
+                }
+            }
+
+            const std::int8_t* w[4] = { w0, w1, w2, w3 };
+            const std::int32_t sums[2][4] = {
+                { glg::horizontalSum(c00), glg::horizontalSum(c01), glg::horizontalSum(c02), glg::horizontalSum(c03) },
+                { glg::horizontalSum(c10), glg::horizontalSum(c11), glg::horizontalSum(c12), glg::horizontalSum(c13) } };
+            for (size_t i = 0; i < R; ++i)
+            {
+                const std::int8_t* a = i == 0 ? a0 : a1;
+                for (size_t j = 0; j < 4; ++j)
+                {
+                    std::int32_t sum = sums[i][j];
+                    for (size_t tail = k; tail < count; ++tail)
+                        sum += std::int32_t(a[tail]) * std::int32_t(w[j][tail]);
+                    out[i][j] = sum;
+                }
+            }
+        }
+#endif
+
+        /**
+         * @brief c(i, j) = row i of A . row j of W for the rows [firstW, lastW) of W, c being written through store(i, j, value).
+         */
+        template<typename Store>
+        void quantizedRange(const QuantizedOperand& a, size_t rowsA, const QuantizedOperand& w, size_t firstW, size_t lastW, size_t count,
+            Store&& store)
+        {
+            size_t j = firstW;
+#if GLG_HAS_AVX2
+            std::int32_t tile[2][4];
+            for (; j + 4 <= lastW; j += 4)
+            {
+                const std::int8_t* wj = w.values + j * w.stride;
+                for (size_t i = 0; i < rowsA; i += 2)
+                {
+                    const std::int8_t* ai = a.values + i * a.stride;
+                    const size_t tileRows = i + 2 <= rowsA ? 2 : 1;
+                    if (tileRows == 2)
+                        quantizedTile<2>(ai, ai + a.stride, wj, w.stride, count, tile);
+                    else
+                        quantizedTile<1>(ai, ai, wj, w.stride, count, tile);
+
+                    for (size_t r = 0; r < tileRows; ++r)
+                    {
+                        for (size_t c = 0; c < 4; ++c)
+                            store(i + r, j + c, dequantizeProduct(tile[r][c], a.rows[i + r], w.rows[j + c], count));
+                    }
+                }
+            }
+#endif
+            for (; j < lastW; ++j)
+            {
+                for (size_t i = 0; i < rowsA; ++i)
+                {
+                    const std::int32_t product = glg::dot(a.values + i * a.stride, w.values + j * w.stride, count);
+                    store(i, j, dequantizeProduct(product, a.rows[i], w.rows[j], count));
+                }
+            }
+        }
+
+        /**
+         * @brief All the products of the rows of A with the rows of W, split over the rows of W on the global pool when large.
+         */
+        template<typename Store>
+        void quantizedProduct(const QuantizedOperand& a, size_t rowsA, const QuantizedOperand& w, size_t rowsW, size_t count, Store&& store)
+        {
+            if (rowsA * rowsW * count < quantizedParallelThreshold || glg::ThreadPool::global().size() == 1)
+                quantizedRange(a, rowsA, w, 0, rowsW, count, store);
+            else
+            {
+                // Chunks of 4 rows of W keep the tiles whole
+                const size_t grain = std::max<size_t>(1, (1 << 16) / (4 * rowsA * count));
+                glg::ThreadPool::global().parallelFor(0, (rowsW + 3) / 4, grain, [&](size_t first, size_t last)
+                {
+                    quantizedRange(a, rowsA, w, first * 4, std::min(last * 4, rowsW), count, store);
+                });
+            }
+        }
+
+        template<size_t height, size_t width>
+        QuantizedOperand operandOf(const myQuantizedMatrix<height, width>& matrix)
+        {
+            return { matrix.values().data(), &matrix.rowParameters(0), width };
+        }
+    }
+
+    /**
+     * @brief Quantizes a float matrix row by row.
+     */
+    template<size_t height, size_t width, typename layout>
+    myQuantizedMatrix<height, width> quantize(const myMatrix<float, height, width, layout>& matrix)
+    {
+        return myQuantizedMatrix<height, width>(matrix);
+    }
+
+    /**
+     * @brief Converts a quantized matrix back to a float matrix.
+     */
+    template<size_t height, size_t width>
+    myMatrix<float, height, width> dequantize(const myQuantizedMatrix<height, width>& matrix)
+    {
+        return matrix.toMatrix();
+    }
+
+    /**
+     * @brief Quantized product C = A * W^T, the layer W (outputs x inputs) applied to every row of A (samples x inputs).
+     *
+     * The rows are multiplied in int8 and accumulated in int32, C receives the dequantized results.
+     *
+     * @param a The quantized activations.
+     * @param w The quantized weights, one row per output.
+     * @param c The samples x outputs result, in any layout.
+     */
+    template<size_t samples, size_t outputs, size_t inputs, typename layout>
+    void multiplyTransposed(const myQuantizedMatrix<samples, inputs>& a, const myQuantizedMatrix<outputs, inputs>& w,
+        myMatrix<float, samples, outputs, layout>& c)
+    {
+        detail::quantizedProduct(detail::operandOf(a), samples, detail::operandOf(w), outputs, inputs,
+            [&](size_t i, size_t j, float value) { c(i, j) = value; });
+    }
+
+    /**
+     * @brief Quantized matrix-vector product y = W * x, x being quantized on the fly.
+     *
+     * @param w The quantized weights, one row per output.
+     * @param x The inputs.
+     * @param y The outputs.
+     */
+    template<size_t outputs, size_t inputs>
+    void multiply(const myQuantizedMatrix<outputs, inputs>& w, const myVectorND<float, inputs>& x, myVectorND<float, outputs>& y)
+    {
+        // Local to the call: the product reads it from the pool, whose tasks may run another multiply on this thread
+        detail::AlignedBuffer<std::int8_t> buffer;
+        std::int8_t* quantized = buffer.get(inputs);
+        const glg::QuantizedRow row = glg::quantize(x.data(), quantized, inputs);
+
+        float* out = y.data();
+        detail::quantizedProduct({ quantized, &row, inputs }, 1, detail::operandOf(w), outputs, inputs,
+            [&](size_t, size_t j, float value) { out[j] = value; });
+    }
+};
+
+/**
+ * @brief Quantized matrix-vector product.
+ */
+template<size_t outputs, size_t inputs>
+myVectorND<float, outputs> operator*(const myQuantizedMatrix<outputs, inputs>& w, const myVectorND<float, inputs>& x)
+{
+    myVectorND<float, outputs> result(glg::uninitialized);
+    Math::multiply(w, x, result);
+    return result;
+}
+
+/**
+ * @brief Stream insertion operator, prints the dequantized values, one row per line.
+ */
+template<size_t height, size_t width>
+std::ostream& operator<<(std::ostream& os, const myQuantizedMatrix<height, width>& matrix)
+{
+    for (size_t i = 0; i < height; ++i)
+    {
+        os << "(";
+        for (size_t j = 0; j < width; ++j)
+        {
+            os << matrix.getCell(i, j);
+            if (j != width - 1)
+                os << ",";
+        }
+        os << ")" << std::endl;
+    }
+    return os;
+}
@@ -0,0 +1,340 @@
+/**
+ * @file myRadixSort.h
+ * @brief Implementation of glg::radix_sort, for integral and floating-point keys.
+ * @author Guillaume
+ * @date 18/10/2026
+ *
+ * Keys are mapped to unsigned integers of the same size whose order is the
+ * order of the keys: the sign bit of signed integers is flipped, negative
+ * floats have all their bits flipped and positive ones their sign bit set.
+ * The sort then never compares two keys.
+ *
+ * A first read of the range finds the bits that differ between the keys,
+ * and returns early when the range is already sorted (or reverses it when
+ * strictly descending). Keys of up to 4 bytes are then sorted least
+ * significant digit first, with 8-bit digits, 11-bit digits for 32-bit keys
+ * from 64K elements on, and 16-bit digits for 16-bit keys. The histograms
+ * of every digit come from a single read of the range, and a digit shared
+ * by all the keys (a bucket holding everything) costs no pass. 8-byte keys
+ * are sorted most significant digit first, from the highest bit that
+ * differs: two or three levels of 8-bit digits usually leave buckets small
+ * enough for insertion sort, where LSD would need six passes, and each
+ * bucket skips the digits its keys share. When 64-bit keys differ in their
+ * low 33 bits only, three 11-bit LSD passes are cheaper.
+ *
+ * Both variants are stable, so structs can be sorted on several fields by
+ * successive sorts, and both use one buffer as large as the range. NaNs go
+ * to the ends: after +inf when positive, before -inf when negative.
+ */
+
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace glg
+{
+    /**
+     * @brief Key types radix_sort handles: integers other than bool, float and double.
+     */
+    template<typename T>
+    concept RadixKey = (std::is_integral_v<T> && !std::is_same_v<T, bool>) || std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+    namespace detail
+    {
+        /** Ranges shorter than this are sorted by insertion, by radix_sort and by each bucket of the MSD sort. */
+        constexpr std::ptrdiff_t radixInsertionThreshold = 32;
+
+        template<size_t bytes> struct UnsignedOfSize;
+        template<> struct UnsignedOfSize<1> { using type = std::uint8_t; };
+        template<> struct UnsignedOfSize<2> { using type = std::uint16_t; };
+        template<> struct UnsignedOfSize<4> { using type = std::uint32_t; };
+        template<> struct UnsignedOfSize<8> { using type = std::uint64_t; };
+
+        /** Unsigned integer the radix sort works on for keys of type T. */
+        template<RadixKey T>
+        using RadixBits = typename UnsignedOfSize<sizeof(T)>::type;
+
+        /**
+         * @brief Maps a key to an unsigned integer, a < b exactly when radixBits(a) < radixBits(b) (up to NaNs and signed zeros).
+         */
+        template<RadixKey T>
+        constexpr RadixBits<T> radixBits(T key)
+        {
+            using U = RadixBits<T>;
+            constexpr U sign = U(U(1) << (8 * sizeof(U) - 1));
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                const U bits = std::bit_cast<U>(key);
+                return (bits & sign) ? U(~bits) : U(bits | sign);
+            }
+            else if constexpr (std::is_signed_v<T>)
+                return U(U(key) ^ sign);
+            else
+                return U(key);
+        }
+
+        /**
+         * @brief Stable insertion sort of [first, first + count) on the radix bits of the keys.
+         */
+        template<typename Iterator, typename Key>
+        void radixInsertionSort(Iterator first, std::ptrdiff_t count, Key& key)
+        {
+            for (std::ptrdiff_t i = 1; i < count; ++i)
+            {
+                const auto bits = radixBits(std::invoke(key, first[i]));
+                if (!(bits < radixBits(std::invoke(key, first[i - 1]))))
+                    continue;
+
+                auto value = std::move(first[i]);
+                std::ptrdiff_t hole = i;
+                do
+                {
+                    first[hole] = std::move(first[hole - 1]);
+                    --hole;
+                } while (hole > 0 && bits < radixBits(std::invoke(key, first[hole - 1])));
+                first[hole] = std::move(value);
+            }
+        }
+
+        /**
+         * @brief Moves src to dst in the order of one digit, offsets holding the start of each bucket.
+         */
+        template<typename Source, typename Destination, typename Key>
+        void radixScatter(Source src, Destination dst, std::ptrdiff_t count, Key& key, int shift, size_t mask, size_t* offsets)
+        {
+            for (std::ptrdiff_t i = 0; i < count; ++i)
+            {
+                const size_t digit = size_t(radixBits(std::invoke(key, src[i])) >> shift) & mask;
+                dst[offsets[digit]++] = std::move(src[i]);
+            }
+        }
+
+        /**
+         * @brief LSD radix sort of [first, first + count) with digits of digitBits bits, buffer holding count elements of scratch.
+         * @tparam passes Number of digits to sort on, the keys must not differ above them.
+         */
+        template<int digitBits, int passes, typename Iterator, typename Buffer, typename Key>
+        void lsdRadixSort(Iterator first, Buffer buffer, std::ptrdiff_t count, Key& key)
+        {
+            using U = decltype(radixBits(std::invoke(key, *first)));
+            constexpr size_t radix = size_t(1) << digitBits;
+            constexpr size_t mask = radix - 1;
+
+            // Every histogram in one read of the range
+            std::vector<size_t> histograms(passes * radix);
+            for (std::ptrdiff_t i = 0; i < count; ++i)
+            {
+                const U bits = radixBits(std::invoke(key, first[i]));
+                for (int pass = 0; pass < passes; ++pass)
+                    ++histograms[pass * radix + (size_t(bits >> (pass * digitBits)) & mask)];
+            }
+
+            bool inBuffer = false;
+            for (int pass = 0; pass < passes; ++pass)
+            {
+                const int shift = pass * digitBits;
+                size_t* offsets = histograms.data() + pass * radix;
+
+                // A digit shared by every key leaves the order unchanged
+                const size_t firstDigit = inBuffer ? size_t(radixBits(std::invoke(key, buffer[0])) >> shift) & mask : size_t(radixBits(std::invoke(key, first[0])) >> shift) & mask;
+                if (offsets[firstDigit] == size_t(count))
+                    continue;
+
+                size_t position = 0;
+                for (size_t digit = 0; digit < radix; ++digit)
+                {
+                    const size_t size = offsets[digit];
+                    offsets[digit] = position;
+                    position += size;
+                }
+
+                if (inBuffer)
+                    radixScatter(buffer, first, count, key, shift, mask, offsets);
+                else
+                    radixScatter(first, buffer, count, key, shift, mask, offsets);
+                inBuffer = !inBuffer;
+            }
+
+            if (inBuffer)
+            {
+                for (std::ptrdiff_t i = 0; i < count; ++i)
+                    first[i] = std::move(buffer[i]);
+            }
+        }
+
+        /**
+         * @brief MSD radix sort of [first, first + count) from the 8-bit digit at shift, buffer holding count elements of scratch.
+         * The keys must not differ above that digit.
+         */
+        template<typename Iterator, typename Buffer, typename Key>
+        void msdRadixSort(Iterator first, Buffer buffer, std::ptrdiff_t count, Key& key, int shift)
+        {
+            using U = decltype(radixBits(std::invoke(key, *first)));
+            if (count < radixInsertionThreshold)
+            {
+                radixInsertionSort(first, count, key);
+                return;
+            }
+
+            size_t offsets[257] = {};
+            for (std::ptrdiff_t i = 0; i < count; ++i)
+                ++offsets[(size_t(radixBits(std::invoke(key, first[i])) >> shift) & 0xff) + 1];
+            for (size_t digit = 1; digit <= 256; ++digit)
+                offsets[digit] += offsets[digit - 1];
+
+            // The bits set in some and clear in other keys of a bucket tell the digit its own sort starts at
+            size_t next[256];
+            U someSet[256];
+            U allSet[256];
+            for (size_t digit = 0; digit < 256; ++digit)
+            {
+                next[digit] = offsets[digit];
+                someSet[digit] = 0;
+                allSet[digit] = U(~U(0));
+            }
+            for (std::ptrdiff_t i = 0; i < count; ++i)
+            {
+                const U bits = radixBits(std::invoke(key, first[i]));
+                const size_t digit = size_t(bits >> shift) & 0xff;
+                someSet[digit] |= bits;
+                allSet[digit] &= bits;
+                buffer[next[digit]++] = std::move(first[i]);
+            }
+            for (std::ptrdiff_t i = 0; i < count; ++i)
+                first[i] = std::move(buffer[i]);
+
+            for (size_t digit = 0; digit < 256; ++digit)
+            {
+                const U differences = U(someSet[digit] ^ allSet[digit]);
+                const std::ptrdiff_t begin = std::ptrdiff_t(offsets[digit]);
+                const std::ptrdiff_t size = std::ptrdiff_t(offsets[digit + 1]) - begin;
+                if (size > 1 && differences != 0)
+                    msdRadixSort(first + begin, buffer + begin, size, key, (int(std::bit_width(differences)) - 1) / 8 * 8);
+            }
+        }
+
+        /**
+         * @brief Picks the LSD digits, or MSD, for count elements whose keys differ in their differingBits low bits.
+         */
+        template<typename Iterator, typename Buffer, typename Key>
+        void radixSortWithBuffer(Iterator first, Buffer buffer, std::ptrdiff_t count, Key& key, int differingBits)
+        {
+            using U = decltype(radixBits(std::invoke(key, *first)));
+
+            // The widest digits whose histograms stay in L1, as long as there are enough elements to fill them
+            const bool wideDigits = count >= (std::ptrdiff_t(1) << 16);
+            if constexpr (sizeof(U) == 1)
+                lsdRadixSort<8, 1>(first, buffer, count, key);
+            else if constexpr (sizeof(U) == 2)
+            {
+                if (wideDigits)
+                    lsdRadixSort<16, 1>(first, buffer, count, key);
+                else
+                    lsdRadixSort<8, 2>(first, buffer, count, key);
+            }
+            else if constexpr (sizeof(U) == 4)
+            {
+                if (wideDigits)
+                    lsdRadixSort<11, 3>(first, buffer, count, key);
+                else
+                    lsdRadixSort<8, 4>(first, buffer, count, key);
+            }
+            else if (wideDigits && differingBits <= 33)
+                lsdRadixSort<11, 3>(first, buffer, count, key);
+            else
+                msdRadixSort(first, buffer, count, key, (differingBits - 1) / 8 * 8);
+        }
+
+        /**
+         * @brief Radix sort of [first, last) on key(element).
+         */
+        template<typename Iterator, typename Key>
+        void radixSort(Iterator first, Iterator last, Key& key)
+        {
+            using ValueType = typename std::iterator_traits<Iterator>::value_type;
+            using U = decltype(radixBits(std::invoke(key, *first)));
+            const std::ptrdiff_t count = last - first;
+            if (count < radixInsertionThreshold)
+            {
+                radixInsertionSort(first, count, key);
+                return;
+            }
+
+            // Only the bits below the highest one that differs between two keys matter. The same read finds the
+            // ranges already sorted, and the strictly descending ones that only need reversing
+            const U reference = radixBits(std::invoke(key, first[0]));
+            U differences = 0;
+            U previous = reference;
+            bool ascending = true;
+            bool descending = true;
+            for (std::ptrdiff_t i = 1; i < count; ++i)
+            {
+                const U bits = radixBits(std::invoke(key, first[i]));
+                differences |= U(bits ^ reference);
+                ascending &= !(bits < previous);
+                descending &= bits < previous;
+                previous = bits;
+            }
+            if (ascending)
+                return;
+            if (descending)
+            {
+                for (std::ptrdiff_t low = 0, high = count - 1; low < high; ++low, --high)
+                    std::swap(first[low], first[high]);
+                return;
+            }
+            const int differingBits = int(std::bit_width(differences));
+
+            if constexpr (std::is_trivially_default_constructible_v<ValueType>)
+            {
+                const auto buffer = std::make_unique_for_overwrite<ValueType[]>(count);
+                radixSortWithBuffer(first, buffer.get(), count, key, differingBits);
+            }
+            else
+            {
+                std::vector<ValueType> buffer(first, last);
+                radixSortWithBuffer(first, buffer.begin(), count, key, differingBits);
+            }
+        }
+    }
+
+    /**
+     * @brief Sort a random-access range of integers or floating-point numbers using a radix sort.
+     *
+     * @tparam Iterator Random-access iterator to RadixKey elements.
+     * @param first Iterator to the first element in the range.
+     * @param last Iterator to the last element in the range.
+     */
+    template<std::random_access_iterator Iterator>
+        requires RadixKey<typename std::iterator_traits<Iterator>::value_type>
+    void radix_sort(Iterator first, Iterator last)
+    {
+        auto key = [](const auto& value) { return value; };
+        detail::radixSort(first, last, key);
+    }
+
+    /**
+     * @brief Sort a random-access range on a numeric key extracted from each element, using a radix sort.
+     *
+     * The sort is stable. For instance radix_sort(first, last, [](const Particle& p) { return p.depth; }).
+     *
+     * @tparam Iterator Random-access iterator type.
+     * @tparam Key Callable returning the RadixKey of an element.
+     * @param first Iterator to the first element in the range.
+     * @param last Iterator to the last element in the range.
+     * @param key The key of each element, called a few times per element.
+     */
+    template<std::random_access_iterator Iterator, typename Key>
+        requires RadixKey<std::remove_cvref_t<std::invoke_result_t<Key&, const typename std::iterator_traits<Iterator>::value_type&>>>
+    void radix_sort(Iterator first, Iterator last, Key key)
+    {
+        detail::radixSort(first, last, key);
+    }
+};
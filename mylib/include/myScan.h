@@ -0,0 +1,377 @@
+/**
+ * @file myScan.h
+ * @brief Implementation of glg::inclusive_scan and glg::exclusive_scan: serial, with an AVX2 in-register scan for sums of
+ * integers, and in two passes over blocks under the parallel execution policies.
+ * @author Guillaume
+ * @date 18/10/2026
+ *
+ * A sum of 32 or 64-bit integers between contiguous ranges is scanned one
+ * register at a time: two shifted additions scan each 128-bit half, the
+ * last element of the low half is added to the high half, and the total of
+ * the previous registers is added to every lane. The exclusive scan is the
+ * inclusive one minus the element itself, exact since integer sums wrap.
+ * The carry stays in a register from one step to the next, and outputs
+ * larger than the last level cache are streamed past it, so the scan runs at
+ * the bandwidth of a copy.
+ *
+ * Under glg::execution::par and par_unseq the range is split into the
+ * cache-line aligned blocks of myExecution.h. A first pass combines the
+ * elements of every block but the last, the calling thread scans these
+ * totals in order, and a second pass scans every block from its offset. The
+ * operation only has to be associative: the elements are never reordered.
+ * Both passes read the input, so the parallel scan moves three words per
+ * element instead of two, which the extra threads make up for once the
+ * range no longer fits in the cache of one core.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "myExecution.h"
+#include "simdConfig.h"
+
+namespace glg
+{
+    namespace detail
+    {
+        /**
+         * @brief Whether scanning a range of Input into Output with Op and an accumulator of T runs on the
+         * in-register scan: a sum of 32 or 64-bit integers between contiguous ranges of T.
+         */
+        template<typename Input, typename Output, typename T, typename Op>
+        concept SimdScan = ContiguousIterator<Input> && ContiguousIterator<Output>
+            && std::is_same_v<std::iter_value_t<Input>, T> && std::is_same_v<std::iter_value_t<Output>, T>
+            && !std::is_const_v<std::remove_reference_t<std::iter_reference_t<Output>>>
+            && std::is_integral_v<T> && !std::is_same_v<T, bool> && (sizeof(T) == 4 || sizeof(T) == 8)
+            && (std::is_same_v<Op, std::plus<>> || std::is_same_v<Op, std::plus<T>>);
+
+#if GLG_HAS_AVX2
+        /**
+         * @brief Inclusive prefix sums of the lanes of x, in 32 or 64-bit lanes.
+         */
+        template<size_t Size>
+        inline __m256i registerScan(__m256i x)
+        {
+            if constexpr (Size == 4)
+            {
+                x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+                x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+
+                // Last lane of the low half, added to every lane of the high half
+                const __m256i last = _mm256_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+                return _mm256_add_epi32(x, _mm256_permute2x128_si256(last, last, 0x08));
+            }
+            else
+            {
+                x = _mm256_add_epi64(x, _mm256_slli_si256(x, 8));
+                const __m256i last = _mm256_shuffle_epi32(x, _MM_SHUFFLE(3, 2, 3, 2));
+                return _mm256_add_epi64(x, _mm256_permute2x128_si256(last, last, 0x08));
+            }
+        }
+#endif
+
+        /**
+         * @brief Scans the count integers of src into dst, which may be src itself, starting from carry.
+         * Outputs larger than the last level cache are written with non-temporal stores, as in glg::copy.
+         * @return The sum of carry and every element.
+         */
+        template<bool Inclusive, typename T>
+        T simdScan(const T* src, T* dst, size_t count, T carry)
+        {
+            // Unsigned sums wrap instead of overflowing, as the vector additions do
+            using Unsigned = std::make_unsigned_t<T>;
+            size_t i = 0;
+            const auto scalarScan = [&](size_t end)
+            {
+                for (; i < end; ++i)
+                {
+                    const T value = src[i];
+                    const T sum = T(Unsigned(carry) + Unsigned(value));
+                    dst[i] = Inclusive ? sum : carry;
+                    carry = sum;
+                }
+            };
+
+#if GLG_HAS_AVX2
+            constexpr size_t lanes = 32 / sizeof(T);
+            const bool streaming = count * sizeof(T) >= streamingThreshold() && src != dst;
+            if (streaming)
+            {
+                const size_t head = (32 - std::uintptr_t(dst) % 32) % 32 / sizeof(T);
+                scalarScan(head < count ? head : count);
+            }
+
+            if (count - i >= lanes)
+            {
+                const auto add = [](__m256i a, __m256i b) { return sizeof(T) == 4 ? _mm256_add_epi32(a, b) : _mm256_add_epi64(a, b); };
+                const auto sub = [](__m256i a, __m256i b) { return sizeof(T) == 4 ? _mm256_sub_epi32(a, b) : _mm256_sub_epi64(a, b); };
+                const __m256i broadcastLast = _mm256_set1_epi32(7);
+
+                __m256i running = sizeof(T) == 4 ? _mm256_set1_epi32(std::int32_t(carry)) : _mm256_set1_epi64x(std::int64_t(carry));
+                for (; i + lanes <= count; i += lanes)
+                {
+                    const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+                    const __m256i sums = add(registerScan<sizeof(T)>(x), running);
+                    const __m256i result = Inclusive ? sums : sub(sums, x);
+                    if (streaming)
+                        _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i), result);
+                    else
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), result);
+
+                    // The last lane, 32 or 64 bits wide, becomes the carry of every lane
+                    running = sizeof(T) == 4 ? _mm256_permutevar8x32_epi32(sums, broadcastLast) : _mm256_permute4x64_epi64(sums, 0xFF);
+                }
+                carry = T(sizeof(T) == 4 ? T(_mm256_extract_epi32(running, 0)) : T(_mm256_extract_epi64(running, 0)));
+
+                if (streaming)
+                    _mm_sfence();
+            }
+#endif
+            scalarScan(count);
+            return carry;
+        }
+
+        /**
+         * @brief Scans [first, last) into out, carry holding the combination of the elements before first
+         * (empty if none, only for an inclusive scan) and, on return, of every element up to last.
+         * @return Output Iterator to the element past the last element written.
+         */
+        template<bool Inclusive, typename Input, typename Output, typename T, typename Op>
+        Output scanInto(Input first, Input last, Output out, std::optional<T>& carry, Op& op)
+        {
+            if constexpr (SimdScan<Input, Output, T, Op>)
+            {
+                const size_t count = size_t(last - first);
+                carry = simdScan<Inclusive>(std::to_address(first), std::to_address(out), count, carry ? *carry : T());
+                return out + std::ptrdiff_t(count);
+            }
+            else
+            {
+                for (; first != last; ++first, ++out)
+                {
+                    if constexpr (Inclusive)
+                    {
+                        if (carry)
+                            carry = op(std::move(*carry), *first);
+                        else
+                            carry.emplace(*first);
+                        *out = *carry;
+                    }
+                    else
+                    {
+                        // Read before writing, out may be first
+                        T value = *first;
+                        *out = *carry;
+                        carry = op(std::move(*carry), std::move(value));
+                    }
+                }
+                return out;
+            }
+        }
+
+        /**
+         * @brief Scan of [first, last) into out under policy, starting from carry.
+         */
+        template<bool Inclusive, typename Policy, typename Input, typename Output, typename T, typename Op>
+        Output policyScan(const Policy& policy, Input first, Input last, Output out, std::optional<T> carry, Op& op)
+        {
+            if constexpr (BlockAlgorithm<Policy, Input, Output>)
+            {
+                const size_t count = size_t(last - first);
+                if (runsInBlocks(policy, count))
+                {
+                    // One total per block, alone on its cache line, then the carry into the block
+                    struct alignas(executionLine) Partial
+                    {
+                        std::optional<T> value;
+                    };
+
+                    // Integer sums wrap, as in the in-register scan
+                    auto combine = [&](T a, T b) -> T
+                    {
+                        if constexpr (SimdScan<Input, Output, T, Op>)
+                            return T(std::make_unsigned_t<T>(a) + std::make_unsigned_t<T>(b));
+                        else
+                            return op(std::move(a), std::move(b));
+                    };
+
+                    ThreadPool& pool = policyPool(policy);
+                    const BlockPartition partition = partitionBlocks(pool, out, count);
+                    const auto partials = std::make_unique<Partial[]>(partition.blocks);
+
+                    pool.run(partition.blocks - 1, [&](size_t block)
+                    {
+                        const size_t begin = partition.begin(block);
+                        const size_t end = partition.end(block);
+                        auto read = [&](size_t i) -> T { return first[std::ptrdiff_t(i)]; };
+
+                        // Integer sums may be regrouped freely, other operations keep the order of the elements
+                        T total = read(begin);
+                        if constexpr (SimdScan<Input, Output, T, Op>)
+                            total = unsequencedReduce(begin + 1, end, std::move(total), combine, read);
+                        else
+                            for (size_t i = begin + 1; i < end; ++i)
+                                total = combine(std::move(total), read(i));
+                        partials[block].value.emplace(std::move(total));
+                    });
+
+                    for (size_t block = 0; block < partition.blocks; ++block)
+                    {
+                        std::optional<T> total = std::move(partials[block].value);
+                        partials[block].value = carry;
+                        if (!total)
+                            continue;
+                        if (carry)
+                            carry = combine(std::move(*carry), std::move(*total));
+                        else
+                            carry = std::move(total);
+                    }
+
+                    pool.run(partition.blocks, [&](size_t block)
+                    {
+                        const std::ptrdiff_t begin = std::ptrdiff_t(partition.begin(block));
+                        const std::ptrdiff_t end = std::ptrdiff_t(partition.end(block));
+                        scanInto<Inclusive>(first + begin, first + end, out + begin, partials[block].value, op);
+                    });
+                    return out + std::ptrdiff_t(count);
+                }
+            }
+
+            return scanInto<Inclusive>(first, last, out, carry, op);
+        }
+    };
+
+    /**
+     * @brief Write to out the combination of every element of [first, last) up to and including the current one.
+     *
+     * @tparam Input Input iterator type.
+     * @tparam Output Output iterator type.
+     * @tparam Op Associative binary operation type.
+     * @param first Iterator to the first element in the range.
+     * @param last Iterator to the last element in the range.
+     * @param out Iterator to the first element in the output range, which may be first.
+     * @param op Binary operation, addition by default.
+     * @return Output Iterator to the element past the last element written.
+     */
+    template<typename Input, typename Output, typename Op = std::plus<>>
+    Output inclusive_scan(Input first, Input last, Output out, Op op = {})
+    {
+        std::optional<typename std::iterator_traits<Input>::value_type> carry;
+        return detail::scanInto<true>(first, last, out, carry, op);
+    }
+
+    /**
+     * @brief Write to out the combination of init and every element of [first, last) up to and including the current one.
+     *
+     * @tparam Input Input iterator type.
+     * @tparam Output Output iterator type.
+     * @tparam Op Associative binary operation type.
+     * @tparam T Type of the accumulator.
+     * @param first Iterator to the first element in the range.
+     * @param last Iterator to the last element in the range.
+     * @param out Iterator to the first element in the output range, which may be first.
+     * @param op Binary operation.
+     * @param init Value combined before the first element.
+     * @return Output Iterator to the element past the last element written.
+     */
+    template<typename Input, typename Output, typename Op, typename T>
+    Output inclusive_scan(Input first, Input last, Output out, Op op, T init)
+    {
+        std::optional<T> carry(std::move(init));
+        return detail::scanInto<true>(first, last, out, carry, op);
+    }
+
+    /**
+     * @brief Write to out the combination of init and every element of [first, last) before the current one.
+     *
+     * @tparam Input Input iterator type.
+     * @tparam Output Output iterator type.
+     * @tparam T Type of the accumulator.
+     * @tparam Op Associative binary operation type.
+     * @param first Iterator to the first element in the range.
+     * @param last Iterator to the last element in the range.
+     * @param out Iterator to the first element in the output range, which may be first.
+     * @param init Value written first, and combined before the first element.
+     * @param op Binary operation, addition by default.
+     * @return Output Iterator to the element past the last element written.
+     */
+    template<typename Input, typename Output, typename T, typename Op = std::plus<>>
+    Output exclusive_scan(Input first, Input last, Output out, T init, Op op = {})
+    {
+        std::optional<T> carry(std::move(init));
+        return detail::scanInto<false>(first, last, out, carry, op);
+    }
+
+    /**
+     * @brief Inclusive scan under an execution policy.
+     * Under par and par_unseq, op may be called from several threads at once and must be associative.
+     *
+     * @tparam Policy One of the glg::execution policies.
+     * @tparam Input Input iterator type.
+     * @tparam Output Output iterator type.
+     * @tparam Op Associative binary operation type.
+     * @param policy How the elements are distributed over threads.
+     * @param first Iterator to the first element in the range.
+     * @param last Iterator to the last element in the range.
+     * @param out Iterator to the first element in the output range, which may be first.
+     * @param op Binary operation, addition by default.
+     * @return Output Iterator to the element past the last element written.
+     */
+    template<detail::ExecutionPolicy Policy, typename Input, typename Output, typename Op = std::plus<>>
+    Output inclusive_scan(Policy&& policy, Input first, Input last, Output out, Op op = {})
+    {
+        return detail::policyScan<true>(policy, first, last, out, std::optional<typename std::iterator_traits<Input>::value_type>(), op);
+    }
+
+    /**
+     * @brief Inclusive scan from init under an execution policy.
+     * Under par and par_unseq, op may be called from several threads at once and must be associative.
+     *
+     * @tparam Policy One of the glg::execution policies.
+     * @tparam Input Input iterator type.
+     * @tparam Output Output iterator type.
+     * @tparam Op Associative binary operation type.
+     * @tparam T Type of the accumulator.
+     * @param policy How the elements are distributed over threads.
+     * @param first Iterator to the first element in the range.
+     * @param last Iterator to the last element in the range.
+     * @param out Iterator to the first element in the output range, which may be first.
+     * @param op Binary operation.
+     * @param init Value combined before the first element.
+     * @return Output Iterator to the element past the last element written.
+     */
+    template<detail::ExecutionPolicy Policy, typename Input, typename Output, typename Op, typename T>
+    Output inclusive_scan(Policy&& policy, Input first, Input last, Output out, Op op, T init)
+    {
+        return detail::policyScan<true>(policy, first, last, out, std::optional<T>(std::move(init)), op);
+    }
+
+    /**
+     * @brief Exclusive scan under an execution policy.
+     * Under par and par_unseq, op may be called from several threads at once and must be associative.
+     *
+     * @tparam Policy One of the glg::execution policies.
+     * @tparam Input Input iterator type.
+     * @tparam Output Output iterator type.
+     * @tparam T Type of the accumulator.
+     * @tparam Op Associative binary operation type.
+     * @param policy How the elements are distributed over threads.
+     * @param first Iterator to the first element in the range.
+     * @param last Iterator to the last element in the range.
+     * @param out Iterator to the first element in the output range, which may be first.
+     * @param init Value written first, and combined before the first element.
+     * @param op Binary operation, addition by default.
+     * @return Output Iterator to the element past the last element written.
+     */
+    template<detail::ExecutionPolicy Policy, typename Input, typename Output, typename T, typename Op = std::plus<>>
+    Output exclusive_scan(Policy&& policy, Input first, Input last, Output out, T init, Op op = {})
+    {
+        return detail::policyScan<false>(policy, first, last, out, std::optional<T>(std::move(init)), op);
+    }
+};
@@ -0,0 +1,617 @@
+/**
+ * @file mySparseMatrix.h
+ * @brief Implementation of a sparse matrix in compressed sparse row (CSR) format.
+ * @author Guillaume
+ * @date 18/10/2026
+ *
+ * Only the non-zero elements are stored, row after row: the values and
+ * their column indices are contiguous, and rowPointers()[r] is the position
+ * of the first element of row r. Matrices are built from coordinates (COO),
+ * from compressed columns (CSC) or from a dense matrix.
+ *
+ * The products with a dense vector (SpMV) or a dense matrix (SpMM) are
+ * spread over the global glg::ThreadPool. The rows are split so that every
+ * chunk holds about the same number of non-zeros, which keeps the threads
+ * busy on matrices where a few rows are much denser than the others.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "myDynMatrix.h"
+#include "myMatrixView.h"
+#include "myThreadPool.h"
+#include "myVector.h"
+#include "myVectorND.h"
+#include "simdConfig.h"
+
+/**
+ * @struct mySparseMatrix
+ * @brief rows x cols matrix storing only its non-zero elements, in CSR format.
+ * @tparam T Element type.
+ */
+template<typename T>
+struct mySparseMatrix
+{
+    using value_type = T;
+    /** Column indices are 32-bit to save memory bandwidth, this limits the width to 2^31 - 1 columns. */
+    using index_type = std::uint32_t;
+
+    /**
+     * @class CooBuilder
+     * @brief Collects (row, col, value) entries in any order, then builds the CSR matrix.
+     */
+    class CooBuilder
+    {
+    public:
+        CooBuilder(size_t rows, size_t cols) : m_rows(rows), m_cols(cols) {}
+
+        void reserve(size_t count)
+        {
+            m_rowIndices.reserve(count);
+            m_colIndices.reserve(count);
+            m_values.reserve(count);
+        }
+
+        /**
+         * @brief Adds an entry, entries added twice at the same position are summed.
+         * @throw std::out_of_range if the position is outside of the matrix.
+         */
+        void add(size_t row, size_t col, const T& value)
+        {
+            if (row >= m_rows || col >= m_cols)
+                throw std::out_of_range("Out of Range");
+
+            m_rowIndices.push_back(row);
+            m_colIndices.push_back(col);
+            m_values.push_back(value);
+        }
+
+        size_t size() const
+        {
+            return m_values.size();
+        }
+
+        mySparseMatrix build() const
+        {
+            return mySparseMatrix::fromCoo(m_rows, m_cols, m_rowIndices, m_colIndices, m_values);
+        }
+
+    private:
+        size_t m_rows;
+        size_t m_cols;
+        std::vector<size_t> m_rowIndices;
+        std::vector<size_t> m_colIndices;
+        std::vector<T> m_values;
+    };
+
+    /**
+     * @brief Default constructor, an empty 0 x 0 matrix.
+     */
+    mySparseMatrix() : m_rows(0), m_cols(0), m_rowPointers(1, 0) {}
+
+    /**
+     * @brief Constructor of a rows x cols matrix without any non-zero.
+     * @throw std::length_error if cols does not fit the column index type.
+     */
+    mySparseMatrix(size_t rows, size_t cols) : m_rows(rows), m_cols(cols), m_rowPointers(rows + 1, 0)
+    {
+        checkWidth(cols);
+    }
+
+    /**
+     * @brief Constructor from raw CSR arrays.
+     * @param rows Number of rows.
+     * @param cols Number of columns.
+     * @param rowPointers rows + 1 offsets, row r holds the elements [rowPointers[r], rowPointers[r + 1]).
+     * @param colIndices Column of every element, increasing within a row.
+     * @param values Value of every element.
+     * @throw std::invalid_argument if the arrays do not describe a valid rows x cols CSR matrix.
+     */
+    mySparseMatrix(size_t rows, size_t cols, std::vector<size_t> rowPointers, std::vector<index_type> colIndices, std::vector<T> values)
+        : m_rows(rows), m_cols(cols), m_rowPointers(std::move(rowPointers)), m_colIndices(std::move(colIndices)), m_values(std::move(values))
+    {
+        checkWidth(cols);
+        if (m_rowPointers.size() != rows + 1 || m_rowPointers.front() != 0 || m_rowPointers.back() != m_values.size()
+            || m_colIndices.size() != m_values.size())
+            throw std::invalid_argument("invalid CSR arrays");
+
+        for (size_t r = 0; r < rows; ++r)
+        {
+            if (m_rowPointers[r] > m_rowPointers[r + 1])
+                throw std::invalid_argument("invalid CSR arrays");
+
+            for (size_t k = m_rowPointers[r]; k < m_rowPointers[r + 1]; ++k)
+            {
+                if (m_colIndices[k] >= cols || (k > m_rowPointers[r] && m_colIndices[k] <= m_colIndices[k - 1]))
+                    throw std::invalid_argument("invalid CSR arrays");
+            }
+        }
+    }
+
+    /**
+     * @brief Conversion from a dense matrix (myMatrix, myDynMatrix or a view), elements with |value| <= tolerance are dropped.
+     * @param dense The dense matrix.
+     * @param tolerance Largest magnitude treated as zero.
+     */
+    explicit mySparseMatrix(myMatrixView<const T> dense, const T& tolerance = T(0))
+        : mySparseMatrix(dense.rows(), dense.cols())
+    {
+        for (size_t r = 0; r < m_rows; ++r)
+        {
+            for (size_t c = 0; c < m_cols; ++c)
+            {
+                const T value = dense(r, c);
+                if (value > tolerance || value < -tolerance)
+                {
+                    m_colIndices.push_back(static_cast<index_type>(c));
+                    m_values.push_back(value);
+                }
+            }
+            m_rowPointers[r + 1] = m_values.size();
+        }
+    }
+
+    template<size_t height, size_t width>
+    explicit mySparseMatrix(const myMatrix<T, height, width>& dense, const T& tolerance = T(0))
+        : mySparseMatrix(myMatrixView<const T>(dense), tolerance) {}
+
+    /**
+     * @brief Builds a matrix from coordinates, in any order. Duplicated positions are summed.
+     * @param rows Number of rows.
+     * @param cols Number of columns.
+     * @param rowIndices Row of every entry.
+     * @param colIndices Column of every entry.
+     * @param values Value of every entry.
+     * @return The CSR matrix.
+     * @throw std::invalid_argument if the three arrays differ in size.
+     * @throw std::out_of_range if an entry lies outside of the matrix.
+     */
+    static mySparseMatrix fromCoo(size_t rows, size_t cols, std::span<const size_t> rowIndices, std::span<const size_t> colIndices, std::span<const T> values)
+    {
+        if (rowIndices.size() != values.size() || colIndices.size() != values.size())
+            throw std::invalid_argument("size must be equal");
+
+        mySparseMatrix result(rows, cols);
+        for (size_t k = 0; k < values.size(); ++k)
+        {
+            if (rowIndices[k] >= rows || colIndices[k] >= cols)
+                throw std::out_of_range("Out of Range");
+            ++result.m_rowPointers[rowIndices[k] + 1];
+        }
+        for (size_t r = 0; r < rows; ++r)
+            result.m_rowPointers[r + 1] += result.m_rowPointers[r];
+
+        // Counting sort by row, then every row is sorted by column and its duplicates merged
+        std::vector<size_t> next(result.m_rowPointers.begin(), result.m_rowPointers.end() - 1);
+        std::vector<std::pair<index_type, T>> entries(values.size());
+        for (size_t k = 0; k < values.size(); ++k)
+            entries[next[rowIndices[k]]++] = { static_cast<index_type>(colIndices[k]), values[k] };
+
+        result.m_colIndices.reserve(values.size());
+        result.m_values.reserve(values.size());
+        size_t begin = 0;
+        for (size_t r = 0; r < rows; ++r)
+        {
+            const size_t end = result.m_rowPointers[r + 1];
+            std::sort(entries.begin() + begin, entries.begin() + end,
+                [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+            for (size_t k = begin; k < end; ++k)
+            {
+                if (k > begin && entries[k].first == entries[k - 1].first)
+                    result.m_values.back() += entries[k].second;
+                else
+                {
+                    result.m_colIndices.push_back(entries[k].first);
+                    result.m_values.push_back(entries[k].second);
+                }
+            }
+            begin = end;
+            result.m_rowPointers[r + 1] = result.m_values.size();
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Builds a matrix from compressed sparse columns (CSC).
+     * @param rows Number of rows.
+     * @param cols Number of columns.
+     * @param colPointers cols + 1 offsets, column c holds the elements [colPointers[c], colPointers[c + 1]).
+     * @param rowIndices Row of every element, increasing within a column.
+     * @param values Value of every element.
+     * @return The CSR matrix.
+     * @throw std::invalid_argument if the arrays do not describe a valid CSC matrix.
+     */
+    static mySparseMatrix fromCsc(size_t rows, size_t cols, std::span<const size_t> colPointers, std::span<const size_t> rowIndices, std::span<const T> values)
+    {
+        if (colPointers.size() != cols + 1 || colPointers[cols] != values.size() || rowIndices.size() != values.size())
+            throw std::invalid_argument("invalid CSC arrays");
+
+        mySparseMatrix result(rows, cols);
+        for (size_t k = 0; k < values.size(); ++k)
+        {
+            if (rowIndices[k] >= rows)
+                throw std::invalid_argument("invalid CSC arrays");
+            ++result.m_rowPointers[rowIndices[k] + 1];
+        }
+        for (size_t r = 0; r < rows; ++r)
+            result.m_rowPointers[r + 1] += result.m_rowPointers[r];
+
+        // Walking the columns in order leaves every row sorted by column
+        std::vector<size_t> next(result.m_rowPointers.begin(), result.m_rowPointers.end() - 1);
+        result.m_colIndices.resize(values.size());
+        result.m_values.resize(values.size());
+        for (size_t c = 0; c < cols; ++c)
+        {
+            for (size_t k = colPointers[c]; k < colPointers[c + 1]; ++k)
+            {
+                const size_t position = next[rowIndices[k]]++;
+                result.m_colIndices[position] = static_cast<index_type>(c);
+                result.m_values[position] = values[k];
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Value of an element, 0 if it is not stored.
+     * @throw std::out_of_range if the position is outside of the matrix.
+     */
+    T getCell(size_t row, size_t col) const
+    {
+        if (row >= m_rows || col >= m_cols)
+            throw std::out_of_range("Out of Range");
+
+        const auto first = m_colIndices.begin() + m_rowPointers[row];
+        const auto last = m_colIndices.begin() + m_rowPointers[row + 1];
+        const auto it = std::lower_bound(first, last, static_cast<index_type>(col));
+        return it != last && *it == col ? m_values[it - m_colIndices.begin()] : T(0);
+    }
+
+    /**
+     * @brief Returns the transpose, which is also the CSC form of this matrix.
+     */
+    mySparseMatrix transpose() const
+    {
+        // The CSR arrays of a matrix are the CSC arrays of its transpose
+        const std::vector<size_t> rowIndices(m_colIndices.begin(), m_colIndices.end());
+        return fromCsc(m_cols, m_rows, m_rowPointers, rowIndices, m_values);
+    }
+
+    /**
+     * @brief Converts to a dense matrix.
+     */
+    myDynMatrix<T> toDense() const
+    {
+        myDynMatrix<T> result(m_rows, m_cols);
+        for (size_t r = 0; r < m_rows; ++r)
+        {
+            for (size_t k = m_rowPointers[r]; k < m_rowPointers[r + 1]; ++k)
+                result(r, m_colIndices[k]) = m_values[k];
+        }
+        return result;
+    }
+
+    size_t rows() const
+    {
+        return m_rows;
+    }
+
+    size_t cols() const
+    {
+        return m_cols;
+    }
+
+    size_t nonZeros() const
+    {
+        return m_values.size();
+    }
+
+    std::span<const size_t> rowPointers() const
+    {
+        return m_rowPointers;
+    }
+
+    std::span<const index_type> colIndices() const
+    {
+        return m_colIndices;
+    }
+
+    std::span<const T> values() const
+    {
+        return m_values;
+    }
+
+    /**
+     * @brief Stored values, to update them without changing the sparsity pattern.
+     */
+    std::span<T> values()
+    {
+        return m_values;
+    }
+
+private:
+    static void checkWidth(size_t cols)
+    {
+        if (cols > 0x7fffffffu)
+            throw std::length_error("too many columns for a sparse matrix");
+    }
+
+    size_t m_rows;                        ///< Number of rows
+    size_t m_cols;                        ///< Number of columns
+    std::vector<size_t> m_rowPointers;    ///< rows + 1 offsets into m_colIndices and m_values
+    std::vector<index_type> m_colIndices; ///< Column of every stored element
+    std::vector<T> m_values;              ///< Value of every stored element
+};
+
+template<typename T>
+std::ostream& operator<<(std::ostream& os, const mySparseMatrix<T>& matrix)
+{
+    for (size_t r = 0; r < matrix.rows(); ++r)
+    {
+        for (size_t k = matrix.rowPointers()[r]; k < matrix.rowPointers()[r + 1]; ++k)
+            os << "(" << r << "," << matrix.colIndices()[k] << ") " << matrix.values()[k] << std::endl;
+    }
+    return os;
+}
+
+namespace Math
+{
+    namespace detail
+    {
+        /** Products with fewer non-zeros than this run on the calling thread. */
+        constexpr size_t sparseParallelThreshold = 1 << 15;
+
+        /**
+         * @brief Splits the rows into chunks holding about the same number of non-zeros.
+         * @return chunks + 1 row bounds.
+         */
+        inline std::vector<size_t> balancedRowSplit(std::span<const size_t> rowPointers, size_t chunks)
+        {
+            const size_t rows = rowPointers.size() - 1;
+            const size_t nonZeros = rowPointers[rows];
+            std::vector<size_t> bounds(chunks + 1, rows);
+            bounds[0] = 0;
+            for (size_t chunk = 1; chunk < chunks; ++chunk)
+            {
+                const size_t target = nonZeros / chunks * chunk + nonZeros % chunks * chunk / chunks;
+                const size_t row = std::lower_bound(rowPointers.begin(), rowPointers.end() - 1, target) - rowPointers.begin();
+                bounds[chunk] = std::max(bounds[chunk - 1], row);
+            }
+            return bounds;
+        }
+
+        /**
+         * @brief Runs func(firstRow, lastRow) over nnz-balanced chunks of rows, in parallel for large matrices.
+         */
+        template<typename T, typename Func>
+        void forEachRowChunk(const mySparseMatrix<T>& matrix, size_t workPerNonZero, Func&& func)
+        {
+            glg::ThreadPool& pool = glg::ThreadPool::global();
+            if (pool.size() == 1 || matrix.nonZeros() * workPerNonZero < sparseParallelThreshold)
+            {
+                func(size_t(0), matrix.rows());
+                return;
+            }
+
+            const std::vector<size_t> bounds = balancedRowSplit(matrix.rowPointers(), 4 * pool.size());
+            pool.run(bounds.size() - 1, [&](size_t chunk) { func(bounds[chunk], bounds[chunk + 1]); });
+        }
+
+        /**
+         * @brief Dot product of one sparse row with a dense vector.
+         */
+        template<typename T>
+        T sparseRowDot(const T* values, const std::uint32_t* cols, size_t count, const T* x)
+        {
+            size_t k = 0;
+            T result = T(0);
+#if GLG_HAS_AVX2 && GLG_HAS_FMA
+            if constexpr (std::is_same_v<T, float>)
+            {
+                // Two gathers in flight hide part of their latency. The masked form with
+                // a zero source is the same instruction, without an undefined register
+                const __m256 all = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+                __m256 acc0 = _mm256_setzero_ps();
+                __m256 acc1 = _mm256_setzero_ps();
+                for (; k + 16 <= count; k += 16)
+                {
+                    const __m256i index0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cols + k));
+                    const __m256i index1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cols + k + 8));
+                    acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(values + k), _mm256_mask_i32gather_ps(_mm256_setzero_ps(), x, index0, all, 4), acc0);
+                    acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(values + k + 8), _mm256_mask_i32gather_ps(_mm256_setzero_ps(), x, index1, all, 4), acc1);
+                }
+                const __m256 acc = _mm256_add_ps(acc0, acc1);
+                __m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+                sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+                sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+                result = _mm_cvtss_f32(sum);
+            }
+            else if constexpr (std::is_same_v<T, double>)
+            {
+                const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+                __m256d acc0 = _mm256_setzero_pd();
+                __m256d acc1 = _mm256_setzero_pd();
+                for (; k + 8 <= count; k += 8)
+                {
+                    const __m128i index0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cols + k));
+                    const __m128i index1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cols + k + 4));
+                    acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(values + k), _mm256_mask_i32gather_pd(_mm256_setzero_pd(), x, index0, all, 8), acc0);
+                    acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(values + k + 4), _mm256_mask_i32gather_pd(_mm256_setzero_pd(), x, index1, all, 8), acc1);
+                }
+                const __m256d acc = _mm256_add_pd(acc0, acc1);
+                const __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(acc), _mm256_extractf128_pd(acc, 1));
+                result = _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+            }
+#endif
+            for (; k < count; ++k)
+                result += values[k] * x[cols[k]];
+
+            return result;
+        }
+    }
+
+    /**
+     * @brief Sparse matrix-vector product y = A * x (SpMV).
+     *
+     * @tparam T The type of elements.
+     * @param matrix The rows x cols sparse matrix A.
+     * @param x The cols input elements.
+     * @param y The rows output elements, it must not overlap x.
+     */
+    template<typename T>
+    void multiply(const mySparseMatrix<T>& matrix, const T* x, T* y)
+    {
+        const size_t* rowPointers = matrix.rowPointers().data();
+        const std::uint32_t* colIndices = matrix.colIndices().data();
+        const T* values = matrix.values().data();
+
+        detail::forEachRowChunk(matrix, 1, [&](size_t firstRow, size_t lastRow)
+        {
+            for (size_t r = firstRow; r < lastRow; ++r)
+            {
+                const size_t begin = rowPointers[r];
+                y[r] = detail::sparseRowDot(values + begin, colIndices + begin, rowPointers[r + 1] - begin, x);
+            }
+        });
+    }
+
+    /**
+     * @brief Sparse matrix-vector product with fixed-size vectors.
+     * @throw std::invalid_argument if the sizes do not match the matrix.
+     */
+    template<typename T, size_t N, size_t M>
+    void multiply(const mySparseMatrix<T>& matrix, const myVectorND<T, N>& x, myVectorND<T, M>& y)
+    {
+        if (matrix.cols() != N || matrix.rows() != M)
+            throw std::invalid_argument("size must be equal");
+        if (static_cast<const void*>(x.data()) == static_cast<const void*>(y.data()))
+            throw std::invalid_argument("result must not alias an operand");
+
+        multiply(matrix, x.data(), y.data());
+    }
+
+    /**
+     * @brief Sparse matrix-vector product with myVector, y is resized to the number of rows.
+     * @throw std::invalid_argument if x does not have one element per column.
+     */
+    template<typename T, size_t N, size_t M>
+    void multiply(const mySparseMatrix<T>& matrix, const myVector<T, N>& x, myVector<T, M>& y)
+    {
+        if (matrix.cols() != x.size())
+            throw std::invalid_argument("size must be equal");
+        if (static_cast<const void*>(&x) == static_cast<const void*>(&y))
+            throw std::invalid_argument("result must not alias an operand");
+
+        y.resize(matrix.rows());
+        multiply(matrix, x.data(), y.data());
+    }
+
+    /**
+     * @brief Sparse matrix-dense matrix product C = A * B (SpMM).
+     *
+     * Every non-zero a(r, k) adds a(r, k) * B(k, :) to C(r, :), so the rows of
+     * B and C are streamed contiguously when their column stride is 1.
+     *
+     * @tparam T The type of elements.
+     * @param matrix The rows x inner sparse matrix A.
+     * @param dense The inner x cols matrix B.
+     * @param result The rows x cols matrix C, it must not overlap B.
+     * @throw std::invalid_argument if the shapes do not match.
+     */
+    template<typename T>
+    void multiply(const mySparseMatrix<T>& matrix, std::type_identity_t<myMatrixView<const T>> dense, std::type_identity_t<myMatrixView<T>> result)
+    {
+        if (matrix.cols() != dense.rows() || result.rows() != matrix.rows() || result.cols() != dense.cols())
+            throw std::invalid_argument("size must be equal");
+
+        const size_t cols = dense.cols();
+        const size_t* rowPointers = matrix.rowPointers().data();
+        const std::uint32_t* colIndices = matrix.colIndices().data();
+        const T* values = matrix.values().data();
+        const bool contiguous = dense.isRowContiguous() && result.isRowContiguous();
+
+        detail::forEachRowChunk(matrix, cols, [&](size_t firstRow, size_t lastRow)
+        {
+            for (size_t r = firstRow; r < lastRow; ++r)
+            {
+                if (contiguous)
+                {
+                    T* out = &result(r, 0);
+                    std::fill(out, out + cols, T(0));
+                    for (size_t k = rowPointers[r]; k < rowPointers[r + 1]; ++k)
+                    {
+                        const T a = values[k];
+                        const T* in = &dense(colIndices[k], 0);
+                        for (size_t c = 0; c < cols; ++c)
+                            out[c] += a * in[c];
+                    }
+                }
+                else
+                {
+                    for (size_t c = 0; c < cols; ++c)
+                        result(r, c) = T(0);
+                    for (size_t k = rowPointers[r]; k < rowPointers[r + 1]; ++k)
+                    {
+                        for (size_t c = 0; c < cols; ++c)
+                            result(r, c) += values[k] * dense(colIndices[k], c);
+                    }
+                }
+            }
+        });
+    }
+};
+
+/**
+ * @brief Sparse matrix-vector product, the matrix must be N x N.
+ * @throw std::invalid_argument if the matrix is not N x N.
+ */
+template<typename T, size_t N>
+myVectorND<T, N> operator*(const mySparseMatrix<T>& matrix, const myVectorND<T, N>& x)
+{
+    myVectorND<T, N> result(glg::uninitialized);
+    Math::multiply(matrix, x, result);
+    return result;
+}
+
+template<typename T, size_t N>
+myVector<T, N> operator*(const mySparseMatrix<T>& matrix, const myVector<T, N>& x)
+{
+    myVector<T, N> result;
+    Math::multiply(matrix, x, result);
+    return result;
+}
+
+/**
+ * @brief Sparse matrix-dense matrix product.
+ * @throw std::invalid_argument if the inner dimensions differ.
+ */
+template<typename T>
+myDynMatrix<T> operator*(const mySparseMatrix<T>& matrix, std::type_identity_t<myMatrixView<const T>> dense)
+{
+    myDynMatrix<T> result(matrix.rows(), dense.cols());
+    Math::multiply(matrix, dense, result.view());
+    return result;
+}
+
+template<typename T>
+myDynMatrix<T> operator*(const mySparseMatrix<T>& matrix, const myDynMatrix<T>& dense)
+{
+    return matrix * dense.view();
+}
+
+template<typename T, size_t height, size_t width>
+myDynMatrix<T> operator*(const mySparseMatrix<T>& matrix, const myMatrix<T, height, width>& dense)
+{
+    return matrix * myMatrixView<const T>(dense);
+}
@@ -0,0 +1,142 @@
+/**
+ * @file myThreadPool.h
+ * @brief Implementation of a fixed-size thread pool that partitions index ranges across its threads.
+ * @author Guillaume
+ * @date 18/10/2026
+ */
+
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace glg
+{
+    /**
+     * @class ThreadPool
+     * @brief Pool of worker threads executing data-parallel jobs.
+     *
+     * A job is a number of tasks indexed from 0. The calling thread takes part
+     * in its own job and the tasks are claimed one by one, so a job never waits
+     * on a task nobody is running: nested parallel calls made from inside a
+     * task are safe. A thread waiting for the end of its job runs the tasks
+     * of the other jobs meanwhile, so recursive fork-join algorithms such as
+     * glg::parallel_sort keep every thread busy.
+     */
+    class ThreadPool
+    {
+    public:
+        /**
+         * @brief Creates a pool running jobs on threadCount threads, the calling thread included.
+         * @param threadCount Number of threads taking part in a job (0 means one per hardware thread).
+         */
+        explicit ThreadPool(size_t threadCount = 0);
+
+        /**
+         * @brief Joins every worker.
+         */
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * @brief Returns the number of threads taking part in a job, the caller included.
+         * @return m_workers.size() + 1
+         */
+        size_t size() const
+        {
+            return m_workers.size() + 1;
+        }
+
+        /**
+         * @brief Runs func(task) for every task in [0, taskCount), in parallel, and waits for all of them.
+         * @tparam Func Callable taking a size_t task index.
+         * @param taskCount Number of tasks.
+         * @param func The task body.
+         */
+        template<typename Func>
+        void run(size_t taskCount, Func&& func)
+        {
+            if (taskCount == 0)
+                return;
+
+            if (taskCount == 1 || m_workers.empty())
+            {
+                for (size_t task = 0; task < taskCount; ++task)
+                    func(task);
+                return;
+            }
+
+            using FuncType = std::remove_reference_t<Func>;
+            dispatch(taskCount, [](void* context, size_t task) { (*static_cast<FuncType*>(context))(task); },
+                const_cast<void*>(static_cast<const void*>(&func)));
+        }
+
+        /**
+         * @brief Splits [first, last) into chunks of at least grain indices and runs func(begin, end) on each chunk in parallel.
+         * @tparam Func Callable taking the (begin, end) bounds of a chunk.
+         * @param first First index.
+         * @param last Past-the-end index.
+         * @param grain Minimum number of indices per chunk.
+         * @param func The chunk body.
+         */
+        template<typename Func>
+        void parallelFor(size_t first, size_t last, size_t grain, Func&& func)
+        {
+            if (first >= last)
+                return;
+
+            const size_t count = last - first;
+            grain = grain == 0 ? 1 : grain;
+
+            // A few chunks per thread balance uneven chunks without drowning in overhead
+            size_t chunks = (count + grain - 1) / grain;
+            chunks = chunks < 4 * size() ? chunks : 4 * size();
+            const size_t chunkSize = (count + chunks - 1) / chunks;
+            chunks = (count + chunkSize - 1) / chunkSize;
+
+            run(chunks, [&](size_t chunk)
+            {
+                const size_t begin = first + chunk * chunkSize;
+                const size_t end = begin + chunkSize < last ? begin + chunkSize : last;
+                func(begin, end);
+            });
+        }
+
+        /**
+         * @brief Returns the pool shared by the mylib algorithms, one thread per hardware thread.
+         * @return The global pool.
+         */
+        static ThreadPool& global();
+
+    private:
+        /** A job being executed, it lives on the stack of the thread that submitted it. */
+        struct Job
+        {
+            void (*invoke)(void*, size_t); ///< Type-erased task body
+            void* context;                 ///< Callable passed to invoke
+            size_t taskCount;              ///< Number of tasks
+            size_t nextTask = 0;           ///< Next task to claim, guarded by m_mutex
+            size_t finishedTasks = 0;      ///< Number of completed tasks, guarded by m_mutex
+            std::exception_ptr error;      ///< First exception thrown by a task, rethrown to the submitter
+        };
+
+        void dispatch(size_t taskCount, void (*invoke)(void*, size_t), void* context);
+        bool runOneTask(std::unique_lock<std::mutex>& lock, Job& job);
+        void workerLoop();
+
+        std::vector<std::thread> m_workers;   ///< Background threads
+        std::deque<Job*> m_jobs;              ///< Jobs that still have unclaimed tasks
+        std::mutex m_mutex;                   ///< Guards m_jobs and the job counters
+        std::condition_variable m_wakeUp;     ///< Signals new jobs to the workers
+        std::condition_variable m_jobDone;    ///< Signals finished tasks and new jobs to the submitters
+        bool m_stopping = false;              ///< Set when the pool is destroyed
+    };
+};
@@ -0,0 +1,412 @@
+/**
+ * @file myTransform.h
+ * @brief Closed-form 2x2, 3x3 and 4x4 determinant and inverse, and batched 4x4 transforms of points.
+ * @author Guillaume
+ * @date 18/10/2026
+ *
+ * Small matrices do not go through the LU factorization: their determinant
+ * and inverse are written out from cofactors. For myMatrix<float, 4, 4> the
+ * four rows are kept in SSE registers, the inverse is computed from the six
+ * 2x2 minors of the top rows and the six of the bottom rows, four lanes at a
+ * time. The 4x4 float product itself lives in gemmFixed (myGemm.h), so
+ * A * B and Math::multiply take the register path too.
+ *
+ * transformPoints() applies one 4x4 transform to a whole span of points,
+ * converting eight packed 3D points at a time to a structure of arrays with
+ * AVX shuffles, and splitting large spans over the global glg::ThreadPool.
+ */
+
+#pragma once
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include "myMatrix.h"
+#include "myThreadPool.h"
+#include "myVectorND.h"
+#include "simdConfig.h"
+
+namespace Math
+{
+    namespace detail
+    {
+        /** Spans with fewer points than this are transformed on the calling thread. */
+        constexpr size_t transformParallelThreshold = 1 << 16;
+
+#if GLG_HAS_SSE2
+        /**
+         * @brief Adjugate of a row-major 4x4 float matrix (inverse times determinant), and the determinant.
+         * @param m The 16 elements of the matrix.
+         * @param adjugate The four rows of the adjugate, may be null when only the determinant is needed.
+         * @return The determinant.
+         */
+        inline float adjugate4x4(const float* m, __m128* adjugate)
+        {
+            const __m128 r0 = _mm_loadu_ps(m);
+            const __m128 r1 = _mm_loadu_ps(m + 4);
+            const __m128 r2 = _mm_loadu_ps(m + 8);
+            const __m128 r3 = _mm_loadu_ps(m + 12);
+
+            // 2x2 minors of the top rows (s) and bottom rows (c), over the column pairs
+            // 01 02 03 12 | 13 23: s0..s3, c0..c3 and (s4, s5, c4, c5)
+            const __m128 s03 = _mm_sub_ps(
+                _mm_mul_ps(_mm_shuffle_ps(r0, r0, _MM_SHUFFLE(1, 0, 0, 0)), _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(2, 3, 2, 1))),
+                _mm_mul_ps(_mm_shuffle_ps(r1, r1, _MM_SHUFFLE(1, 0, 0, 0)), _mm_shuffle_ps(r0, r0, _MM_SHUFFLE(2, 3, 2, 1))));
+            const __m128 c03 = _mm_sub_ps(
+                _mm_mul_ps(_mm_shuffle_ps(r2, r2, _MM_SHUFFLE(1, 0, 0, 0)), _mm_shuffle_ps(r3, r3, _MM_SHUFFLE(2, 3, 2, 1))),
+                _mm_mul_ps(_mm_shuffle_ps(r3, r3, _MM_SHUFFLE(1, 0, 0, 0)), _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(2, 3, 2, 1))));
+            const __m128 sc45 = _mm_sub_ps(
+                _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(2, 1, 2, 1)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(3, 3, 3, 3))),
+                _mm_mul_ps(_mm_shuffle_ps(r1, r3, _MM_SHUFFLE(2, 1, 2, 1)), _mm_shuffle_ps(r0, r2, _MM_SHUFFLE(3, 3, 3, 3))));
+
+            // k_i = (c_i, c_i, s_i, s_i), the cofactors of the adjugate rows pair them this way
+            const __m128 k5 = _mm_shuffle_ps(sc45, sc45, _MM_SHUFFLE(1, 1, 3, 3));
+            const __m128 k4 = _mm_shuffle_ps(sc45, sc45, _MM_SHUFFLE(0, 0, 2, 2));
+            const __m128 k3 = _mm_shuffle_ps(c03, s03, _MM_SHUFFLE(3, 3, 3, 3));
+            const __m128 k2 = _mm_shuffle_ps(c03, s03, _MM_SHUFFLE(2, 2, 2, 2));
+            const __m128 k1 = _mm_shuffle_ps(c03, s03, _MM_SHUFFLE(1, 1, 1, 1));
+            const __m128 k0 = _mm_shuffle_ps(c03, s03, _MM_SHUFFLE(0, 0, 0, 0));
+
+            // a_j = (m1j, m0j, m3j, m2j)
+            __m128 c0 = r0, c1 = r1, c2 = r2, c3 = r3;
+            _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+            const __m128 a0 = _mm_shuffle_ps(c0, c0, _MM_SHUFFLE(2, 3, 0, 1));
+            const __m128 a1 = _mm_shuffle_ps(c1, c1, _MM_SHUFFLE(2, 3, 0, 1));
+            const __m128 a2 = _mm_shuffle_ps(c2, c2, _MM_SHUFFLE(2, 3, 0, 1));
+            const __m128 a3 = _mm_shuffle_ps(c3, c3, _MM_SHUFFLE(2, 3, 0, 1));
+
+            const __m128 evenSign = _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f);
+            const __m128 oddSign = _mm_setr_ps(-0.0f, 0.0f, -0.0f, 0.0f);
+            const __m128 row0 = _mm_xor_ps(evenSign, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a1, k5), _mm_mul_ps(a2, k4)), _mm_mul_ps(a3, k3)));
+
+            // det = row 0 of the adjugate . column 0 of the matrix
+            __m128 det = _mm_mul_ps(row0, c0);
+            det = _mm_add_ps(det, _mm_movehl_ps(det, det));
+            det = _mm_add_ss(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(1, 1, 1, 1)));
+
+            if (adjugate)
+            {
+                adjugate[0] = row0;
+                adjugate[1] = _mm_xor_ps(oddSign, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a0, k5), _mm_mul_ps(a2, k2)), _mm_mul_ps(a3, k1)));
+                adjugate[2] = _mm_xor_ps(evenSign, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a0, k4), _mm_mul_ps(a1, k2)), _mm_mul_ps(a3, k0)));
+                adjugate[3] = _mm_xor_ps(oddSign, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a0, k3), _mm_mul_ps(a1, k1)), _mm_mul_ps(a2, k0)));
+            }
+            return _mm_cvtss_f32(det);
+        }
+#endif
+
+        /**
+         * @brief p' = M * (p, 1), divided by w' unless affine is true.
+         */
+        template<bool affine>
+        void transformPointsScalar(const float* m, const myVectorND<float, 3>* src, myVectorND<float, 3>* dst, size_t count)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                const float x = src[i][0], y = src[i][1], z = src[i][2];
+                float rx = m[0] * x + m[1] * y + m[2] * z + m[3];
+                float ry = m[4] * x + m[5] * y + m[6] * z + m[7];
+                float rz = m[8] * x + m[9] * y + m[10] * z + m[11];
+                if constexpr (!affine)
+                {
+                    const float w = 1.0f / (m[12] * x + m[13] * y + m[14] * z + m[15]);
+                    rx *= w;
+                    ry *= w;
+                    rz *= w;
+                }
+                dst[i][0] = rx;
+                dst[i][1] = ry;
+                dst[i][2] = rz;
+            }
+        }
+
+        template<bool affine>
+        void transformPointsRange(const float* m, const myVectorND<float, 3>* src, myVectorND<float, 3>* dst, size_t count)
+        {
+            size_t i = 0;
+#if GLG_HAS_AVX2 && GLG_HAS_FMA
+            // Eight points are 24 packed floats: six 128-bit loads and five shuffles give x, y and z
+            __m256 mm[16];
+            for (size_t e = 0; e < 16; ++e)
+                mm[e] = _mm256_set1_ps(m[e]);
+
+            for (; i + 8 <= count; i += 8)
+            {
+                const float* in = src[i].data();
+                float* out = dst[i].data();
+                const __m256 m03 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(in)), _mm_loadu_ps(in + 12), 1);
+                const __m256 m14 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(in + 4)), _mm_loadu_ps(in + 16), 1);
+                const __m256 m25 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(in + 8)), _mm_loadu_ps(in + 20), 1);
+                const __m256 xy = _mm256_shuffle_ps(m14, m25, _MM_SHUFFLE(2, 1, 3, 2));
+                const __m256 yz = _mm256_shuffle_ps(m03, m14, _MM_SHUFFLE(1, 0, 2, 1));
+                const __m256 x = _mm256_shuffle_ps(m03, xy, _MM_SHUFFLE(2, 0, 3, 0));
+                const __m256 y = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+                const __m256 z = _mm256_shuffle_ps(yz, m25, _MM_SHUFFLE(3, 0, 3, 1));
+
+                __m256 rx = _mm256_fmadd_ps(mm[0], x, _mm256_fmadd_ps(mm[1], y, _mm256_fmadd_ps(mm[2], z, mm[3])));
+                __m256 ry = _mm256_fmadd_ps(mm[4], x, _mm256_fmadd_ps(mm[5], y, _mm256_fmadd_ps(mm[6], z, mm[7])));
+                __m256 rz = _mm256_fmadd_ps(mm[8], x, _mm256_fmadd_ps(mm[9], y, _mm256_fmadd_ps(mm[10], z, mm[11])));
+                if constexpr (!affine)
+                {
+                    const __m256 w = _mm256_fmadd_ps(mm[12], x, _mm256_fmadd_ps(mm[13], y, _mm256_fmadd_ps(mm[14], z, mm[15])));
+                    const __m256 inverse = _mm256_div_ps(_mm256_set1_ps(1.0f), w);
+                    rx = _mm256_mul_ps(rx, inverse);
+                    ry = _mm256_mul_ps(ry, inverse);
+                    rz = _mm256_mul_ps(rz, inverse);
+                }
+
+                const __m256 rxy = _mm256_shuffle_ps(rx, ry, _MM_SHUFFLE(2, 0, 2, 0));
+                const __m256 ryz = _mm256_shuffle_ps(ry, rz, _MM_SHUFFLE(3, 1, 3, 1));
+                const __m256 rzx = _mm256_shuffle_ps(rz, rx, _MM_SHUFFLE(3, 1, 2, 0));
+                const __m256 r03 = _mm256_shuffle_ps(rxy, rzx, _MM_SHUFFLE(2, 0, 2, 0));
+                const __m256 r14 = _mm256_shuffle_ps(ryz, rxy, _MM_SHUFFLE(3, 1, 2, 0));
+                const __m256 r25 = _mm256_shuffle_ps(rzx, ryz, _MM_SHUFFLE(3, 1, 3, 1));
+                _mm_storeu_ps(out, _mm256_castps256_ps128(r03));
+                _mm_storeu_ps(out + 4, _mm256_castps256_ps128(r14));
+                _mm_storeu_ps(out + 8, _mm256_castps256_ps128(r25));
+                _mm_storeu_ps(out + 12, _mm256_extractf128_ps(r03, 1));
+                _mm_storeu_ps(out + 16, _mm256_extractf128_ps(r14, 1));
+                _mm_storeu_ps(out + 20, _mm256_extractf128_ps(r25, 1));
+            }
+#endif
+            transformPointsScalar<affine>(m, src + i, dst + i, count - i);
+        }
+    }
+
+    /**
+     * @brief Determinant of a 2x2 matrix.
+     */
+    template<typename T>
+    T determinant(const myMatrix<T, 2, 2>& matrix)
+    {
+        const T* m = matrix.data();
+        return m[0] * m[3] - m[1] * m[2];
+    }
+
+    /**
+     * @brief Determinant of a 3x3 matrix, expanded along the first row.
+     */
+    template<typename T>
+    T determinant(const myMatrix<T, 3, 3>& matrix)
+    {
+        const T* m = matrix.data();
+        return m[0] * (m[4] * m[8] - m[5] * m[7]) - m[1] * (m[3] * m[8] - m[5] * m[6]) + m[2] * (m[3] * m[7] - m[4] * m[6]);
+    }
+
+    /**
+     * @brief Determinant of a 4x4 matrix, from the 2x2 minors of the top and bottom rows.
+     */
+    template<typename T>
+    T determinant(const myMatrix<T, 4, 4>& matrix)
+    {
+        const T* m = matrix.data();
+#if GLG_HAS_SSE2
+        if constexpr (std::is_same_v<T, float>)
+            return detail::adjugate4x4(m, nullptr);
+#endif
+        const T s0 = m[0] * m[5] - m[4] * m[1];
+        const T s1 = m[0] * m[6] - m[4] * m[2];
+        const T s2 = m[0] * m[7] - m[4] * m[3];
+        const T s3 = m[1] * m[6] - m[5] * m[2];
+        const T s4 = m[1] * m[7] - m[5] * m[3];
+        const T s5 = m[2] * m[7] - m[6] * m[3];
+        const T c0 = m[8] * m[13] - m[12] * m[9];
+        const T c1 = m[8] * m[14] - m[12] * m[10];
+        const T c2 = m[8] * m[15] - m[12] * m[11];
+        const T c3 = m[9] * m[14] - m[13] * m[10];
+        const T c4 = m[9] * m[15] - m[13] * m[11];
+        const T c5 = m[10] * m[15] - m[14] * m[11];
+        return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    }
+
+    /**
+     * @brief Inverse of a 2x2 matrix.
+     * @throw std::runtime_error if the matrix is singular.
+     */
+    template<typename T>
+    myMatrix<T, 2, 2> inverse(const myMatrix<T, 2, 2>& matrix)
+    {
+        const T det = determinant(matrix);
+        if (det == T(0))
+            throw std::runtime_error("matrix is singular");
+
+        const T* m = matrix.data();
+        const T inv = T(1) / det;
+        return { m[3] * inv, -m[1] * inv, -m[2] * inv, m[0] * inv };
+    }
+
+    /**
+     * @brief Inverse of a 3x3 matrix, the transposed cofactors over the determinant.
+     * @throw std::runtime_error if the matrix is singular.
+     */
+    template<typename T>
+    myMatrix<T, 3, 3> inverse(const myMatrix<T, 3, 3>& matrix)
+    {
+        const T* m = matrix.data();
+        const T c00 = m[4] * m[8] - m[5] * m[7];
+        const T c01 = m[5] * m[6] - m[3] * m[8];
+        const T c02 = m[3] * m[7] - m[4] * m[6];
+        const T det = m[0] * c00 + m[1] * c01 + m[2] * c02;
+        if (det == T(0))
+            throw std::runtime_error("matrix is singular");
+
+        const T inv = T(1) / det;
+        return { c00 * inv, (m[2] * m[7] - m[1] * m[8]) * inv, (m[1] * m[5] - m[2] * m[4]) * inv,
+                 c01 * inv, (m[0] * m[8] - m[2] * m[6]) * inv, (m[2] * m[3] - m[0] * m[5]) * inv,
+                 c02 * inv, (m[1] * m[6] - m[0] * m[7]) * inv, (m[0] * m[4] - m[1] * m[3]) * inv };
+    }
+
+    /**
+     * @brief Inverse of a general 4x4 matrix (projections included).
+     * @throw std::runtime_error if the matrix is singular.
+     */
+    template<typename T>
+    myMatrix<T, 4, 4> inverse(const myMatrix<T, 4, 4>& matrix)
+    {
+        const T* m = matrix.data();
+        myMatrix<T, 4, 4> result(glg::uninitialized);
+#if GLG_HAS_SSE2
+        if constexpr (std::is_same_v<T, float>)
+        {
+            __m128 adjugate[4];
+            const float det = detail::adjugate4x4(m, adjugate);
+            if (det == 0.0f)
+                throw std::runtime_error("matrix is singular");
+
+            const __m128 inv = _mm_set1_ps(1.0f / det);
+            for (size_t r = 0; r < 4; ++r)
+                _mm_storeu_ps(result.data() + 4 * r, _mm_mul_ps(adjugate[r], inv));
+            return result;
+        }
+#endif
+        const T s0 = m[0] * m[5] - m[4] * m[1];
+        const T s1 = m[0] * m[6] - m[4] * m[2];
+        const T s2 = m[0] * m[7] - m[4] * m[3];
+        const T s3 = m[1] * m[6] - m[5] * m[2];
+        const T s4 = m[1] * m[7] - m[5] * m[3];
+        const T s5 = m[2] * m[7] - m[6] * m[3];
+        const T c0 = m[8] * m[13] - m[12] * m[9];
+        const T c1 = m[8] * m[14] - m[12] * m[10];
+        const T c2 = m[8] * m[15] - m[12] * m[11];
+        const T c3 = m[9] * m[14] - m[13] * m[10];
+        const T c4 = m[9] * m[15] - m[13] * m[11];
+        const T c5 = m[10] * m[15] - m[14] * m[11];
+        const T det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+        if (det == T(0))
+            throw std::runtime_error("matrix is singular");
+
+        const T inv = T(1) / det;
+        T* r = result.data();
+        r[0] = (m[5] * c5 - m[6] * c4 + m[7] * c3) * inv;
+        r[1] = (-m[1] * c5 + m[2] * c4 - m[3] * c3) * inv;
+        r[2] = (m[13] * s5 - m[14] * s4 + m[15] * s3) * inv;
+        r[3] = (-m[9] * s5 + m[10] * s4 - m[11] * s3) * inv;
+        r[4] = (-m[4] * c5 + m[6] * c2 - m[7] * c1) * inv;
+        r[5] = (m[0] * c5 - m[2] * c2 + m[3] * c1) * inv;
+        r[6] = (-m[12] * s5 + m[14] * s2 - m[15] * s1) * inv;
+        r[7] = (m[8] * s5 - m[10] * s2 + m[11] * s1) * inv;
+        r[8] = (m[4] * c4 - m[5] * c2 + m[7] * c0) * inv;
+        r[9] = (-m[0] * c4 + m[1] * c2 - m[3] * c0) * inv;
+        r[10] = (m[12] * s4 - m[13] * s2 + m[15] * s0) * inv;
+        r[11] = (-m[8] * s4 + m[9] * s2 - m[11] * s0) * inv;
+        r[12] = (-m[4] * c3 + m[5] * c1 - m[6] * c0) * inv;
+        r[13] = (m[0] * c3 - m[1] * c1 + m[2] * c0) * inv;
+        r[14] = (-m[12] * s3 + m[13] * s1 - m[14] * s0) * inv;
+        r[15] = (m[8] * s3 - m[9] * s1 + m[10] * s0) * inv;
+        return result;
+    }
+
+    /**
+     * @brief Inverse of an affine 4x4 transform [R t; 0 1]: [R^-1, -R^-1 t; 0 1].
+     * Cheaper and more accurate than the general inverse for rotations, scales and translations.
+     * @throw std::invalid_argument if the last row is not (0, 0, 0, 1).
+     * @throw std::runtime_error if R is singular.
+     */
+    template<typename T>
+    myMatrix<T, 4, 4> inverseAffine(const myMatrix<T, 4, 4>& matrix)
+    {
+        const T* m = matrix.data();
+        if (m[12] != T(0) || m[13] != T(0) || m[14] != T(0) || m[15] != T(1))
+            throw std::invalid_argument("matrix is not affine");
+
+        const myMatrix<T, 3, 3> linear = inverse(myMatrix<T, 3, 3>{ m[0], m[1], m[2], m[4], m[5], m[6], m[8], m[9], m[10] });
+        const T* l = linear.data();
+        return { l[0], l[1], l[2], -(l[0] * m[3] + l[1] * m[7] + l[2] * m[11]),
+                 l[3], l[4], l[5], -(l[3] * m[3] + l[4] * m[7] + l[5] * m[11]),
+                 l[6], l[7], l[8], -(l[6] * m[3] + l[7] * m[7] + l[8] * m[11]),
+                 T(0), T(0), T(0), T(1) };
+    }
+
+    /**
+     * @brief Transforms 3D points: p' = M * (p, 1), divided by w' when the last row of M is not (0, 0, 0, 1).
+     * @param matrix The transform.
+     * @param src The points to transform.
+     * @param dst Receives the transformed points, it may be src itself.
+     * @throw std::invalid_argument if the spans differ in size.
+     */
+    inline void transformPoints(const myMatrix<float, 4, 4>& matrix, std::span<const myVectorND<float, 3>> src, std::span<myVectorND<float, 3>> dst)
+    {
+        static_assert(sizeof(myVectorND<float, 3>) == 3 * sizeof(float), "points must be packed");
+
+        if (src.size() != dst.size())
+            throw std::invalid_argument("size must be equal");
+
+        const float* m = matrix.data();
+        const bool affine = m[12] == 0.0f && m[13] == 0.0f && m[14] == 0.0f && m[15] == 1.0f;
+        const auto range = [&](size_t begin, size_t end)
+        {
+            if (affine)
+                detail::transformPointsRange<true>(m, src.data() + begin, dst.data() + begin, end - begin);
+            else
+                detail::transformPointsRange<false>(m, src.data() + begin, dst.data() + begin, end - begin);
+        };
+
+        if (src.size() < detail::transformParallelThreshold)
+            range(0, src.size());
+        else
+            glg::ThreadPool::global().parallelFor(0, src.size(), detail::transformParallelThreshold / 4, range);
+    }
+
+    /**
+     * @brief Transforms 3D points in place.
+     */
+    inline void transformPoints(const myMatrix<float, 4, 4>& matrix, std::span<myVectorND<float, 3>> points)
+    {
+        transformPoints(matrix, std::span<const myVectorND<float, 3>>(points), points);
+    }
+
+    /**
+     * @brief Transforms homogeneous 4D points in place: p' = M * p, no division.
+     */
+    inline void transformPoints(const myMatrix<float, 4, 4>& matrix, std::span<myVectorND<float, 4>> points)
+    {
+        static_assert(sizeof(myVectorND<float, 4>) == 4 * sizeof(float), "points must be packed");
+
+        if (points.empty())
+            return;
+
+        // p'^T = p^T M^T: every point is a row of a (count x 4) * (4 x 4) product, done in place
+        const float* m = matrix.data();
+        const float transposed[16] = { m[0], m[4], m[8], m[12], m[1], m[5], m[9], m[13],
+                                       m[2], m[6], m[10], m[14], m[3], m[7], m[11], m[15] };
+        const auto range = [&](size_t begin, size_t end)
+        {
+            float* data = points[0].data() + 4 * begin;
+#if GLG_HAS_SSE2
+            detail::gemmRows4x4(data, transposed, data, end - begin);
+#else
+            for (size_t i = begin; i < end; ++i, data += 4)
+            {
+                const float x = data[0], y = data[1], z = data[2], w = data[3];
+                for (size_t r = 0; r < 4; ++r)
+                    data[r] = m[4 * r] * x + m[4 * r + 1] * y + m[4 * r + 2] * z + m[4 * r + 3] * w;
+            }
+#endif
+        };
+
+        if (points.size() < detail::transformParallelThreshold)
+            range(0, points.size());
+        else
+            glg::ThreadPool::global().parallelFor(0, points.size(), detail::transformParallelThreshold / 4, range);
+    }
+};
@@ -0,0 +1,444 @@
+/**
+ * @file myTranspose.h
+ * @brief Implementation of cache-oblivious matrix transposition with SIMD register transposes.
+ * @author Guillaume
+ * @date 18/10/2026
+ *
+ * The matrix is split recursively along its larger dimension until a block
+ * fits in L1 whatever the cache sizes are, so both the reads and the strided
+ * writes stay in cache. Inside a block, full tiles are transposed in
+ * registers: 8x8 floats or 4x4 doubles with AVX, 4x4 floats with SSE. Any
+ * trivially copyable 4 or 8 byte type reuses these kernels.
+ */
+
+#pragma once
+#include <cstddef>
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include "myArray.h"
+#include "myLayout.h"
+#include "simdConfig.h"
+
+namespace Math
+{
+    namespace detail
+    {
+#if GLG_HAS_AVX2
+        /**
+         * @brief Transposes the 8x8 float tile at src into dst.
+         */
+        inline void transposeTile8x8(const float* src, size_t srcStride, float* dst, size_t dstStride)
+        {
+            const __m256 r0 = _mm256_loadu_ps(src);
+            const __m256 r1 = _mm256_loadu_ps(src + srcStride);
+            const __m256 r2 = _mm256_loadu_ps(src + 2 * srcStride);
+            const __m256 r3 = _mm256_loadu_ps(src + 3 * srcStride);
+            const __m256 r4 = _mm256_loadu_ps(src + 4 * srcStride);
+            const __m256 r5 = _mm256_loadu_ps(src + 5 * srcStride);
+            const __m256 r6 = _mm256_loadu_ps(src + 6 * srcStride);
+            const __m256 r7 = _mm256_loadu_ps(src + 7 * srcStride);
+
+            // Interleave pairs of rows, then pairs of pairs, then swap the 128-bit halves
+            const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+            const __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+            const __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+            const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+            const __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+            const __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+            const __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+            const __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+
+            const __m256 u0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+            const __m256 u1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+            const __m256 u2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+            const __m256 u3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+            const __m256 u4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+            const __m256 u5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+            const __m256 u6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+            const __m256 u7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+            _mm256_storeu_ps(dst, _mm256_permute2f128_ps(u0, u4, 0x20));
+            _mm256_storeu_ps(dst + dstStride, _mm256_permute2f128_ps(u1, u5, 0x20));
+            _mm256_storeu_ps(dst + 2 * dstStride, _mm256_permute2f128_ps(u2, u6, 0x20));
+            _mm256_storeu_ps(dst + 3 * dstStride, _mm256_permute2f128_ps(u3, u7, 0x20));
+            _mm256_storeu_ps(dst + 4 * dstStride, _mm256_permute2f128_ps(u0, u4, 0x31));
+            _mm256_storeu_ps(dst + 5 * dstStride, _mm256_permute2f128_ps(u1, u5, 0x31));
+            _mm256_storeu_ps(dst + 6 * dstStride, _mm256_permute2f128_ps(u2, u6, 0x31));
+            _mm256_storeu_ps(dst + 7 * dstStride, _mm256_permute2f128_ps(u3, u7, 0x31));
+        }
+
+        /**
+         * @brief Transposes the 4x4 double tile at src into dst.
+         */
+        inline void transposeTile4x4(const double* src, size_t srcStride, double* dst, size_t dstStride)
+        {
+            const __m256d r0 = _mm256_loadu_pd(src);
+            const __m256d r1 = _mm256_loadu_pd(src + srcStride);
+            const __m256d r2 = _mm256_loadu_pd(src + 2 * srcStride);
+            const __m256d r3 = _mm256_loadu_pd(src + 3 * srcStride);
+
+            const __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+            const __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+            const __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+            const __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+
+            _mm256_storeu_pd(dst, _mm256_permute2f128_pd(t0, t2, 0x20));
+            _mm256_storeu_pd(dst + dstStride, _mm256_permute2f128_pd(t1, t3, 0x20));
+            _mm256_storeu_pd(dst + 2 * dstStride, _mm256_permute2f128_pd(t0, t2, 0x31));
+            _mm256_storeu_pd(dst + 3 * dstStride, _mm256_permute2f128_pd(t1, t3, 0x31));
+        }
+#endif
+
+#if GLG_HAS_SSE2
+        /**
+         * @brief Transposes the 4x4 float tile at src into dst.
+         */
+        inline void transposeTile4x4(const float* src, size_t srcStride, float* dst, size_t dstStride)
+        {
+            __m128 r0 = _mm_loadu_ps(src);
+            __m128 r1 = _mm_loadu_ps(src + srcStride);
+            __m128 r2 = _mm_loadu_ps(src + 2 * srcStride);
+            __m128 r3 = _mm_loadu_ps(src + 3 * srcStride);
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            _mm_storeu_ps(dst, r0);
+            _mm_storeu_ps(dst + dstStride, r1);
+            _mm_storeu_ps(dst + 2 * dstStride, r2);
+            _mm_storeu_ps(dst + 3 * dstStride, r3);
+        }
+#endif
+
+        /**
+         * @brief Register tile of the transposition for one element type, Lane is the type the kernel works on.
+         *
+         * Only the bits are moved, so any trivially copyable type of the size of
+         * a float or a double is transposed by the float or double kernel.
+         */
+        template<typename T, typename = void>
+        struct TransposeTraits
+        {
+            using Lane = T;
+            static constexpr size_t tile = 1;
+        };
+
+        template<typename T>
+        struct TransposeTraits<T, std::enable_if_t<std::is_trivially_copyable_v<T> && sizeof(T) == sizeof(float)>>
+        {
+            using Lane = float;
+#if GLG_HAS_AVX2
+            static constexpr size_t tile = 8;
+#elif GLG_HAS_SSE2
+            static constexpr size_t tile = 4;
+#else
+            static constexpr size_t tile = 1;
+#endif
+        };
+
+        template<typename T>
+        struct TransposeTraits<T, std::enable_if_t<std::is_trivially_copyable_v<T> && sizeof(T) == sizeof(double)>>
+        {
+            using Lane = double;
+#if GLG_HAS_AVX2
+            static constexpr size_t tile = 4;
+#else
+            static constexpr size_t tile = 1;
+#endif
+        };
+
+        /** Blocks of at most transposeLeaf x transposeLeaf elements are transposed tile by tile (4 KB of floats). */
+        inline constexpr size_t transposeLeaf = 32;
+
+        template<typename T>
+        void transposeTile(const T* src, size_t srcStride, T* dst, size_t dstStride)
+        {
+            using Traits = TransposeTraits<T>;
+            using Lane = typename Traits::Lane;
+            if constexpr (Traits::tile == 8)
+                transposeTile8x8(reinterpret_cast<const Lane*>(src), srcStride, reinterpret_cast<Lane*>(dst), dstStride);
+            else if constexpr (Traits::tile == 4)
+                transposeTile4x4(reinterpret_cast<const Lane*>(src), srcStride, reinterpret_cast<Lane*>(dst), dstStride);
+            else
+                *dst = *src;
+        }
+
+        /**
+         * @brief Transposes a block small enough to stay in L1, full tiles in registers and the edges element by element.
+         */
+        template<typename T>
+        void transposeLeafBlock(const T* src, size_t srcStride, T* dst, size_t dstStride, size_t rows, size_t cols)
+        {
+            constexpr size_t tile = TransposeTraits<T>::tile;
+            const size_t fullRows = rows - rows % tile;
+            const size_t fullCols = cols - cols % tile;
+
+            for (size_t i = 0; i < fullRows; i += tile)
+            {
+                for (size_t j = 0; j < fullCols; j += tile)
+                    transposeTile(src + i * srcStride + j, srcStride, dst + j * dstStride + i, dstStride);
+            }
+            for (size_t i = 0; i < rows; ++i)
+            {
+                for (size_t j = i < fullRows ? fullCols : 0; j < cols; ++j)
+                    dst[j * dstStride + i] = src[i * srcStride + j];
+            }
+        }
+
+        /**
+         * @brief Splits a dimension in two halves, the first one being a multiple of the tile.
+         */
+        template<typename T>
+        size_t transposeSplit(size_t extent)
+        {
+            constexpr size_t tile = TransposeTraits<T>::tile;
+            const size_t half = extent / 2;
+            return half < tile ? half : half - half % tile;
+        }
+
+        template<typename T>
+        void transposeRecursive(const T* src, size_t srcStride, T* dst, size_t dstStride, size_t rows, size_t cols)
+        {
+            if (rows <= transposeLeaf && cols <= transposeLeaf)
+            {
+                transposeLeafBlock(src, srcStride, dst, dstStride, rows, cols);
+                return;
+            }
+
+            if (rows >= cols)
+            {
+                const size_t top = transposeSplit<T>(rows);
+                transposeRecursive(src, srcStride, dst, dstStride, top, cols);
+                transposeRecursive(src + top * srcStride, srcStride, dst + top, dstStride, rows - top, cols);
+            }
+            else
+            {
+                const size_t left = transposeSplit<T>(cols);
+                transposeRecursive(src, srcStride, dst, dstStride, rows, left);
+                transposeRecursive(src + left, srcStride, dst + left * dstStride, dstStride, rows, cols - left);
+            }
+        }
+
+        /**
+         * @brief Swaps the transposes of the blocks a (rows x cols) and b (cols x rows) of the same matrix.
+         */
+        template<typename T>
+        void transposeSwapLeaf(T* a, T* b, size_t stride, size_t rows, size_t cols)
+        {
+            constexpr size_t tile = TransposeTraits<T>::tile;
+            if constexpr (tile > 1)
+            {
+                // Full tiles go through a copy in registers/L1 so that neither block is overwritten too early
+                const size_t fullRows = rows - rows % tile;
+                const size_t fullCols = cols - cols % tile;
+                alignas(64) T copy[tile * tile];
+                for (size_t i = 0; i < fullRows; i += tile)
+                {
+                    for (size_t j = 0; j < fullCols; j += tile)
+                    {
+                        T* tileA = a + i * stride + j;
+                        T* tileB = b + j * stride + i;
+                        transposeTile(tileA, stride, copy, tile);
+                        transposeTile(tileB, stride, tileA, stride);
+                        for (size_t r = 0; r < tile; ++r)
+                            std::memcpy(tileB + r * stride, copy + r * tile, tile * sizeof(T));
+                    }
+                }
+                for (size_t i = 0; i < rows; ++i)
+                {
+                    for (size_t j = i < fullRows ? fullCols : 0; j < cols; ++j)
+                        std::swap(a[i * stride + j], b[j * stride + i]);
+                }
+            }
+            else
+            {
+                for (size_t i = 0; i < rows; ++i)
+                {
+                    for (size_t j = 0; j < cols; ++j)
+                        std::swap(a[i * stride + j], b[j * stride + i]);
+                }
+            }
+        }
+
+        template<typename T>
+        void transposeSwapRecursive(T* a, T* b, size_t stride, size_t rows, size_t cols)
+        {
+            if (rows <= transposeLeaf && cols <= transposeLeaf)
+            {
+                transposeSwapLeaf(a, b, stride, rows, cols);
+                return;
+            }
+
+            if (rows >= cols)
+            {
+                const size_t top = transposeSplit<T>(rows);
+                transposeSwapRecursive(a, b, stride, top, cols);
+                transposeSwapRecursive(a + top * stride, b + top, stride, rows - top, cols);
+            }
+            else
+            {
+                const size_t left = transposeSplit<T>(cols);
+                transposeSwapRecursive(a, b, stride, rows, left);
+                transposeSwapRecursive(a + left, b + left * stride, stride, rows, cols - left);
+            }
+        }
+
+        /**
+         * @brief In-place transposition of the n x n block at a: the diagonal quadrants recurse, the off-diagonal ones are swapped.
+         */
+        template<typename T>
+        void transposeInPlaceRecursive(T* a, size_t stride, size_t n)
+        {
+            if (n <= transposeLeaf)
+            {
+                constexpr size_t tile = TransposeTraits<T>::tile;
+                const size_t full = n - n % tile;
+                for (size_t i = 0; i < full; i += tile)
+                {
+                    T* diagonal = a + i * stride + i;
+                    if constexpr (tile > 1)
+                    {
+                        alignas(64) T copy[tile * tile];
+                        transposeTile(diagonal, stride, copy, tile);
+                        for (size_t r = 0; r < tile; ++r)
+                            std::memcpy(diagonal + r * stride, copy + r * tile, tile * sizeof(T));
+                    }
+                    transposeSwapLeaf(diagonal + tile, diagonal + tile * stride, stride, tile, n - i - tile);
+                }
+                for (size_t i = full; i < n; ++i)
+                {
+                    for (size_t j = i + 1; j < n; ++j)
+                        std::swap(a[i * stride + j], a[j * stride + i]);
+                }
+                return;
+            }
+
+            const size_t half = transposeSplit<T>(n);
+            transposeInPlaceRecursive(a, stride, half);
+            transposeInPlaceRecursive(a + half * stride + half, stride, n - half);
+            transposeSwapRecursive(a + half, a + half * stride, stride, half, n - half);
+        }
+    }
+
+    /**
+     * @brief Out-of-place transposition of a strided row-major matrix: dst(j, i) = src(i, j).
+     *
+     * @tparam T The type of elements.
+     * @param src First element of the rows x cols source.
+     * @param srcStride Distance between two rows of src, in elements.
+     * @param dst First element of the cols x rows destination, it must not overlap src.
+     * @param dstStride Distance between two rows of dst, in elements.
+     * @param rows Number of rows of src.
+     * @param cols Number of columns of src.
+     */
+    template<typename T>
+    void transpose(const T* src, size_t srcStride, T* dst, size_t dstStride, size_t rows, size_t cols)
+    {
+        detail::transposeRecursive(src, srcStride, dst, dstStride, rows, cols);
+    }
+
+    /**
+     * @brief In-place transposition of a strided n x n matrix.
+     *
+     * @tparam T The type of elements.
+     * @param data First element of the matrix.
+     * @param stride Distance between two rows, in elements.
+     * @param n Number of rows and columns.
+     */
+    template<typename T>
+    void transposeInPlace(T* data, size_t stride, size_t n)
+    {
+        detail::transposeInPlaceRecursive(data, stride, n);
+    }
+
+    /**
+     * @brief Copies a height x width matrix stored in the layout From into the layout To.
+     * Row-major to column-major and back is a transposition of the storage, other pairs go element by element.
+     *
+     * @tparam From The layout of src.
+     * @tparam To The layout of dst.
+     * @param src The source elements.
+     * @param dst The destination elements, it must not overlap src.
+     * @param height Number of rows of the matrix.
+     * @param width Number of columns of the matrix.
+     */
+    template<typename From, typename To, typename T>
+    void relayout(const T* src, T* dst, size_t height, size_t width)
+    {
+        if constexpr (std::is_same_v<From, To>)
+            std::copy(src, src + height * width, dst);
+        else if (height <= 1 || width <= 1)
+            std::copy(src, src + height * width, dst);
+        else if constexpr (std::is_same_v<From, glg::RowMajor> && std::is_same_v<To, glg::ColMajor>)
+            transpose(src, width, dst, height, height, width);
+        else if constexpr (std::is_same_v<From, glg::ColMajor> && std::is_same_v<To, glg::RowMajor>)
+            transpose(src, height, dst, width, width, height);
+        else
+            glg::relayoutElements<From, To>(src, dst, height, width);
+    }
+
+    /**
+     * @brief Returns the transpose of a matrix, in the same layout.
+     *
+     * @tparam T The type of elements in the matrix.
+     * @tparam H The height of the matrix.
+     * @tparam W The width of the matrix.
+     * @tparam L The layout of the matrix.
+     * @param matrix The matrix to transpose.
+     * @return The W x H transpose.
+     */
+    template<typename T, size_t H, size_t W, typename L>
+    myMatrix<T, W, H, L> transpose(const myMatrix<T, H, W, L>& matrix)
+    {
+        myMatrix<T, W, H, L> result(glg::uninitialized);
+        if constexpr (std::is_same_v<L, glg::RowMajor>)
+            transpose(matrix.data(), W, result.data(), H, H, W);
+        else if constexpr (std::is_same_v<L, glg::ColMajor>)
+            transpose(matrix.data(), H, result.data(), W, W, H);
+        else
+        {
+            for (size_t i = 0; i < H; ++i)
+            {
+                for (size_t j = 0; j < W; ++j)
+                    result(j, i) = matrix(i, j);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Returns the transpose of a matrix without moving any element: the storage of a
+     * row-major matrix is the storage of its column-major transpose, and the other way round.
+     *
+     * @tparam T The type of elements in the matrix.
+     * @tparam H The height of the matrix.
+     * @tparam W The width of the matrix.
+     * @tparam L The layout of the matrix, row-major or column-major.
+     * @param matrix The matrix to transpose.
+     * @return The W x H transpose, a plain copy of the storage in the other layout.
+     */
+    template<typename T, size_t H, size_t W, typename L> requires L::strided
+    auto transposeLayout(const myMatrix<T, H, W, L>& matrix)
+    {
+        using Other = std::conditional_t<std::is_same_v<L, glg::RowMajor>, glg::ColMajor, glg::RowMajor>;
+        myMatrix<T, W, H, Other> result(glg::uninitialized);
+        std::copy(matrix.data(), matrix.data() + H * W, result.data());
+        return result;
+    }
+
+    /**
+     * @brief Transposes a square matrix in place.
+     *
+     * @tparam T The type of elements in the matrix.
+     * @tparam N The height and width of the matrix.
+     * @tparam L The layout of the matrix.
+     * @param matrix The matrix to transpose.
+     */
+    template<typename T, size_t N, typename L>
+    void transposeInPlace(myMatrix<T, N, N, L>& matrix)
+    {
+        if constexpr (L::strided)
+            transposeInPlace(matrix.data(), N, N);
+        else
+            matrix = transpose(matrix);
+    }
+};
@@ -8,6 +8,7 @@
 #pragma once
 #include <iterator>
 #include <stdexcept>
+#include <utility>
 #include "helper.h"
 
  /**
@@ -26,11 +27,14 @@ struct myVector
 	{
 	public:
 		using iterator_category = std::random_access_iterator_tag;
+		using iterator_concept = std::contiguous_iterator_tag;
 		using value_type = T;
 		using difference_type = std::ptrdiff_t;
 		using pointer = T*;
 		using reference = T&;
 
+		iterator() = default;
+
 		/**
 	   * @brief Constructs iterator pointing to specific element
 	   * @param ptr Pointer to the element
@@ -41,7 +45,7 @@ struct myVector
 		* @brief Dereference operator
 		* @return Reference to the pointed element
 		*/
-		reference operator*()
+		reference operator*() const
 		{
 			return *m_ptr;
 		}
@@ -49,7 +53,7 @@ struct myVector
 		 * @brief Arrow operator for member access
 		 * @return Pointer to the element
 		 */
-		pointer operator->()
+		pointer operator->() const
 		{
 			return m_ptr;
 		}
@@ -76,6 +80,11 @@ struct myVector
 			return tmp += n;
 		}
 
+		friend iterator operator+(difference_type n, const iterator& it)
+		{
+			return it + n;
+		}
+
 		/**
 		* @brief Compound subtraction assignment operator
 		* @param n Number of positions to move backward
@@ -191,7 +200,7 @@ struct myVector
 		}
 
 	private:
-		pointer m_ptr;
+		pointer m_ptr = nullptr;
 	};
 
 	/**
@@ -202,11 +211,14 @@ struct myVector
 	{
 	public:
 		using iterator_category = std::random_access_iterator_tag;
+		using iterator_concept = std::contiguous_iterator_tag;
 		using value_type = T;
 		using difference_type = std::ptrdiff_t;
 		using pointer = const T*;
 		using reference = const T&;
 
+		const_iterator() = default;
+
 		/**
 		 * @brief Constructs const_iterator pointing to specific element
 		 * @param ptr Pointer to the element
@@ -244,6 +256,11 @@ struct myVector
 			return tmp += n;
 		}
 
+		friend const_iterator operator+(difference_type n, const const_iterator& it)
+		{
+			return it + n;
+		}
+
 		const_iterator& operator-=(difference_type n)
 		{
 			m_ptr -= n;
@@ -323,11 +340,11 @@ struct myVector
 		}
 
 	private:
-		pointer m_ptr;
+		pointer m_ptr = nullptr;
 	};
 
-	template<typename T, size_t N>
-	friend std::ostream& operator<<(std::ostream& os, const myVector<T, N>& vec);
+	template<typename Type, size_t Size>
+	friend std::ostream& operator<<(std::ostream& os, const myVector<Type, Size>& vec);
 
 	using value_type = T;
 	using size_type = size_t;
@@ -362,6 +379,15 @@ struct myVector
 		glg::copy(newVector.m_data, newVector.m_data + newVector.m_size, m_data);
 	}
 
+	/**
+	* @brief Move constructor, takes the storage without copying any element
+	* @param newVector Vector to move from, left empty with no capacity
+	*/
+	myVector(myVector&& newVector) noexcept
+	: m_data(std::exchange(newVector.m_data, nullptr))
+	, m_size(std::exchange(newVector.m_size, 0))
+	, m_capacity(std::exchange(newVector.m_capacity, 0)) {}
+
 	/**
 	 * @brief Initializer list constructor
 	 * @param init Initializer list of elements
@@ -396,6 +422,36 @@ struct myVector
 		return *this;
 	}
 
+	/**
+	* @brief Move assignment operator
+	* @param newVector Vector to move from, left empty with no capacity
+	* @return Reference to this vector
+	*/
+	myVector& operator=(myVector&& newVector) noexcept
+	{
+		myVector(std::move(newVector)).swap(*this);
+		return *this;
+	}
+
+	/**
+	* @brief Exchanges the contents with another vector in constant time
+	* @param other Vector to swap with
+	*/
+	void swap(myVector& other) noexcept
+	{
+		std::swap(m_data, other.m_data);
+		std::swap(m_size, other.m_size);
+		std::swap(m_capacity, other.m_capacity);
+	}
+
+	/**
+	* @brief Swap found by argument-dependent lookup, for callers of the using std::swap; swap(a, b) idiom
+	*/
+	friend void swap(myVector& first, myVector& second) noexcept
+	{
+		first.swap(second);
+	}
+
 	/**
 	 * @brief Destructor
 	 * Deallocates the internal array
@@ -445,7 +501,7 @@ struct myVector
 		if (new_capacity > m_capacity)
 		{
 			value_type* new_data = new value_type[new_capacity];
-			glg::copy(m_data, m_data + m_size, new_data);
+			glg::move(m_data, m_data + m_size, new_data);
 
 			delete[] m_data;
 			m_data = new_data;
@@ -562,7 +618,7 @@ struct myVector
 	void push_back(const T& value)
 	{
 		if (m_size >= m_capacity)
-			reserve(m_capacity * 2);
+			reserve(m_capacity ? m_capacity * 2 : 1);
 
 		m_data[m_size] = value;
 		++m_size;
@@ -592,13 +648,15 @@ struct myVector
 		if (index > end())
 			throw std::out_of_range("Index out of range");
 
+		// reserve reallocates, so the position is kept as an offset rather than an iterator
+		const size_t position = size_t(index - begin());
 		if (m_size >= m_capacity)
-			reserve(m_capacity * 2);
+			reserve(m_capacity ? m_capacity * 2 : 1);
 
-		glg::move_backward(index, end(), end() + 1);
-		*index = value;
+		glg::move_backward(m_data + position, m_data + m_size, m_data + m_size + 1);
+		m_data[position] = value;
 		++m_size;
-		return index;
+		return begin() + position;
 	}
 
 	/**
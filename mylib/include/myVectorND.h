@@ -10,6 +10,7 @@
 #include <initializer_list>
 #include <sstream>
 #include "myArray.h"
+#include "myExpr.h"
 #include "helper.h"
 
  /**
@@ -36,13 +37,13 @@ public:
      * @param list Initializer list of elements
      * @throw std::out_of_range if list size exceeds capacity
      */
-    myVectorND(std::initializer_list<type> list)
+    myVectorND(std::initializer_list<type> list) : m_data(glg::uninitialized)
     {
         if (list.size() > size)
             throw std::runtime_error("Out of Range");
 
         glg::copy(list.begin(), list.end(), m_data.data());
-    	glg::fill((m_data.begin() + list.size()), m_data.end(), type());
+    	glg::fill(m_data.data() + list.size(), m_data.data() + m_data.size(), type());
     }
 
     /**
@@ -51,7 +52,13 @@ public:
 	*/
     myVectorND()
     {
-        glg::fill(m_data.begin(), m_data.end(), type());
+    }
+
+    /**
+     * @brief Constructor leaving the elements uninitialised, for callers that overwrite all of them
+     */
+    explicit myVectorND(glg::uninitialized_t) : m_data(glg::uninitialized)
+    {
     }
 
     /**
@@ -59,12 +66,9 @@ public:
      * @param tab
 	 * @throw std::out_of_range if size of tab does not match size
      */
-    myVectorND(const myVectorND& tab)
+    myVectorND(const myVectorND& tab) : m_data(glg::uninitialized)
     {
-        if (tab.m_data.size() != size)
-            throw std::runtime_error("size must be equal");
-
-        glg::copy(tab.m_data.begin(), tab.m_data.end(), m_data.data());
+        glg::copy(tab.m_data.data(), tab.m_data.data() + tab.m_data.size(), m_data.data());
     }
     /**
      * @brief Copy assignment operator
@@ -78,11 +82,57 @@ public:
             throw std::out_of_range("size must be equal");
 
         if (this != &tab)
-            std::copy(tab.m_data.begin(), tab.m_data.end(), m_data.data());
+            glg::copy(tab.m_data.data(), tab.m_data.data() + tab.m_data.size(), m_data.data());
 
         return *this;
     }
 
+    /**
+     * @brief Evaluates an expression (u + v, M * v - w...) straight into the new vector
+     * @param expr An expression of size x 1 elements
+     */
+    template<glg::expr::Expression E> requires (E::rows == size && E::cols == 1)
+    myVectorND(const E& expr) : m_data(glg::uninitialized)
+    {
+        glg::expr::evaluate(expr, data());
+    }
+
+    /**
+     * @brief Evaluates an expression into the vector, the vector may appear in the expression
+     * @param expr An expression of size x 1 elements
+     * @return Reference to this vector
+     */
+    template<glg::expr::Expression E> requires (E::rows == size && E::cols == 1)
+    myVectorND& operator=(const E& expr)
+    {
+        glg::expr::evaluate(expr, data());
+        return *this;
+    }
+
+    template<glg::expr::Operand E>
+    myVectorND& operator+=(const E& expr)
+    {
+        return *this = *this + expr;
+    }
+
+    template<glg::expr::Operand E>
+    myVectorND& operator-=(const E& expr)
+    {
+        return *this = *this - expr;
+    }
+
+    template<glg::expr::Scalar S>
+    myVectorND& operator*=(const S& scalar)
+    {
+        return *this = *this * scalar;
+    }
+
+    template<glg::expr::Scalar S>
+    myVectorND& operator/=(const S& scalar)
+    {
+        return *this = *this / scalar;
+    }
+
     /**
      * @brief Subscript operator
      * @param idx Index of the element
@@ -137,7 +187,7 @@ public:
      */
     size_t Size()
     {
-        return m_data.Size();
+        return m_data.size();
     }
 
     /**
@@ -289,69 +339,6 @@ public:
         return const_reverse_iterator(data() - 1);
     }
 
-    /**
-     * @brief Addition operator for vectors
-     * @param data The vector to add
-     * @return New vector with the result of the addition
-     */
-    myVectorND<type, size> operator+(const myVectorND<type, size>& data)
-    {
-        myVectorND<type, size> result;
-        for (size_t i = 0; i < m_data.Size(); ++i)
-        {
-            result[i] = data[i] + m_data[i];
-        }
-        return result;
-    }
-
-    /**
-     * @brief Subtraction operator for vectors
-     * @param data The vector to subtract
-     * @return New vector with the result of the subtraction
-     */
-    myVectorND<type, size> operator-(const myVectorND<type, size>& data)
-    {
-        myVectorND<type, size> result;
-        for (size_t i = 0; i < m_data.Size(); ++i)
-        {
-            result[i] = data[i] - m_data[i];
-        }
-        return result;
-    }
-
-    /**
-     * @brief Multiplication operator for vector and scalar
-     * @param idx The scalar to multiply
-     * @return New vector with the result of the multiplication
-     */
-    myVectorND<type, size> operator*(const int& idx)
-    {
-        myVectorND<type, size> result;
-        for (size_t i = 0; i < m_data.Size(); ++i)
-        {
-            result[i] = m_data[i] * idx;
-        }
-        return result;
-    }
-
-    /**
-     * @brief Division operator for vector and scalar
-     * @param idx The scalar to divide
-     * @return New vector with the result of the division
-     * @throw std::runtime_error if division by zero is attempted
-     */
-    myVectorND<type, size> operator/(const int& idx)
-    {
-        if (idx == 0)
-            throw std::runtime_error("cannot divide by 0");
-        myVectorND<type, size> result;
-        for (size_t i = 0; i < m_data.Size(); ++i)
-        {
-            result[i] = m_data[i] / idx;
-        }
-        return result;
-    }
-
     /**
      * @brief Equality comparison operator
      * @param data The vector to compare
@@ -374,80 +361,7 @@ public:
      */
     bool operator !=(const myVectorND<type, size>& data)
     {
-        bool result;
-        for (size_t i = 0; i < m_data.size(); ++i)
-        {
-            if (data[i] == m_data[i])
-                result = false;
-            else
-                result = true;
-        }
-        return result;
-    }
-
-    /**
-     * @brief Addition operator for vectors (const version)
-     * @param data The vector to add
-     * @return New vector with the result of the addition
-     */
-    myVectorND<type, size> operator+(const myVectorND<type, size>& data) const
-    {
-        myVectorND<type, size> result;
-        for (size_t i = 0; i < m_data.size(); ++i)
-        {
-            result[i] = data[i] + m_data[i];
-        }
-        return result;
-    }
-
-    /**
-     * @brief Subtraction operator for vectors (const version)
-     * @param data The vector to subtract
-     * @return New vector with the result of the subtraction
-     */
-    myVectorND<type, size> operator-(const myVectorND<type, size>& data) const
-    {
-        myVectorND<type, size> result;
-        for (size_t i = 0; i < m_data.size(); ++i)
-        {
-            result[i] = data[i] - m_data[i];
-        }
-        return result;
-    }
-
-    /**
-     * @brief Multiplication operator for vector and scalar (const version)
-     * @param idx The scalar to multiply
-     * @return New vector with the result of the multiplication
-     */
-    myVectorND<type, size> operator*(const int& idx) const
-    {
-        myVectorND<type, size> result;
-        for (size_t i = 0; i < m_data.size(); ++i)
-        {
-            result[i] = m_data[i] * idx;
-        }
-        return result;
-    }
-
-    /**
-     * @brief Division operator for vector and scalar (const version)
-     * @param idx The scalar to divide
-     * @return New vector with the result of the division
-     * @throw std::runtime_error if division by zero is attempted
-     */
-    myVectorND<type, size> operator/(const int& idx) const
-    {
-        if (idx == 0)
-            throw std::runtime_error("cannot divide by 0");
-
-        myVectorND<type, size> result;
-        for (size_t i = 0; i < m_data.Size(); ++i)
-        {
-            result[i] = m_data[i] / idx;
-        }
-
-        return result;
+        return !(*this == data);
     }
 
     /**
@@ -457,7 +371,7 @@ public:
      */
     bool operator ==(const myVectorND<type, size>& data) const
     {
-        for (size_t i = 0; i < m_data.Size(); ++i)
+        for (size_t i = 0; i < m_data.size(); ++i)
         {
             if (data[i] != m_data[i])
                 return false;
@@ -472,15 +386,7 @@ public:
      */
     bool operator !=(const myVectorND<type, size>& data) const
     {
-        bool result;
-        for (size_t i = 0; i < m_data.Size(); ++i)
-        {
-            if (data[i] == m_data[i])
-                result = false;
-            else
-                result = true;
-        }
-        return result;
+        return !(*this == data);
     }
 
     template<typename T, size_t N>
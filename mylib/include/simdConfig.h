@@ -0,0 +1,49 @@
+/**
+ * @file simdConfig.h
+ * @brief Detection of the SIMD instruction sets available to the mylib kernels.
+ * @author Guillaume
+ * @date 18/10/2026
+ *
+ * Every kernel keeps a scalar fallback, the macros below only select the
+ * vectorised path when the compiler has been told it may use the instructions
+ * (see the MYLIB_ENABLE_AVX2 option in mylib/CMakeLists.txt).
+ */
+
+#pragma once
+
+// SSE2 is part of every x86-64 target.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define GLG_HAS_SSE2 1
+#else
+    #define GLG_HAS_SSE2 0
+#endif
+
+#if defined(__AVX2__)
+    #define GLG_HAS_AVX2 1
+#else
+    #define GLG_HAS_AVX2 0
+#endif
+
+// MSVC does not define __FMA__ / __F16C__, but /arch:AVX2 implies both.
+#if defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__))
+    #define GLG_HAS_FMA 1
+#else
+    #define GLG_HAS_FMA 0
+#endif
+
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+    #define GLG_HAS_F16C 1
+#else
+    #define GLG_HAS_F16C 0
+#endif
+
+// 8-bit dot products accumulated in 32 bits, from AVX-VNNI or from AVX-512 VNNI with its 256-bit forms (see MYLIB_ENABLE_VNNI).
+#if defined(__AVXVNNI__) || (defined(__AVX512VNNI__) && defined(__AVX512VL__))
+    #define GLG_HAS_VNNI 1
+#else
+    #define GLG_HAS_VNNI 0
+#endif
+
+#if GLG_HAS_SSE2 || GLG_HAS_AVX2 || GLG_HAS_FMA || GLG_HAS_F16C || GLG_HAS_VNNI
+    #include <immintrin.h>
+#endif
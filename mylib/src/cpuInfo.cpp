@@ -0,0 +1,66 @@
+/**
+ * @file cpuInfo.cpp
+ * @brief Platform-specific queries of the cache hierarchy.
+ * @author Guillaume
+ * @date 18/10/2026
+ */
+
+#include "cpuInfo.h"
+
+#if defined(_WIN32)
+    #include <vector>
+    #include <windows.h>
+#elif defined(__linux__)
+    #include <unistd.h>
+#endif
+
+namespace glg
+{
+    namespace
+    {
+        CacheInfo queryCacheInfo()
+        {
+            CacheInfo info;
+
+#if defined(_WIN32)
+            DWORD length = 0;
+            GetLogicalProcessorInformation(nullptr, &length);
+            std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> entries(length / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+            if (!entries.empty() && GetLogicalProcessorInformation(entries.data(), &length))
+            {
+                for (const auto& entry : entries)
+                {
+                    if (entry.Relationship != RelationCache)
+                        continue;
+
+                    const CACHE_DESCRIPTOR& cache = entry.Cache;
+                    if (cache.Level == 1 && cache.Type != CacheInstruction)
+                        info.l1 = cache.Size;
+                    else if (cache.Level == 2)
+                        info.l2 = cache.Size;
+                    else if (cache.Level == 3)
+                        info.l3 = cache.Size;
+                }
+            }
+#elif defined(__linux__)
+            const long l1 = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+            const long l2 = sysconf(_SC_LEVEL2_CACHE_SIZE);
+            const long l3 = sysconf(_SC_LEVEL3_CACHE_SIZE);
+            if (l1 > 0)
+                info.l1 = static_cast<size_t>(l1);
+            if (l2 > 0)
+                info.l2 = static_cast<size_t>(l2);
+            if (l3 > 0)
+                info.l3 = static_cast<size_t>(l3);
+#endif
+
+            return info;
+        }
+    }
+
+    const CacheInfo& cacheInfo()
+    {
+        static const CacheInfo info = queryCacheInfo();
+        return info;
+    }
+};
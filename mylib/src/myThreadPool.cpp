@@ -0,0 +1,110 @@
+/**
+ * @file myThreadPool.cpp
+ * @brief Implementation of the worker side of glg::ThreadPool.
+ * @author Guillaume
+ * @date 18/10/2026
+ */
+
+#include "myThreadPool.h"
+#include <algorithm>
+#include <exception>
+
+namespace glg
+{
+    ThreadPool::ThreadPool(size_t threadCount)
+    {
+        if (threadCount == 0)
+            threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+
+        m_workers.reserve(threadCount - 1);
+        for (size_t i = 1; i < threadCount; ++i)
+            m_workers.emplace_back([this] { workerLoop(); });
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wakeUp.notify_all();
+
+        for (std::thread& worker : m_workers)
+            worker.join();
+    }
+
+    ThreadPool& ThreadPool::global()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    bool ThreadPool::runOneTask(std::unique_lock<std::mutex>& lock, Job& job)
+    {
+        if (job.nextTask >= job.taskCount)
+            return false;
+
+        const size_t task = job.nextTask++;
+        if (job.nextTask == job.taskCount)
+            m_jobs.erase(std::find(m_jobs.begin(), m_jobs.end(), &job));
+
+        lock.unlock();
+        std::exception_ptr error;
+        try
+        {
+            job.invoke(job.context, task);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+        lock.lock();
+
+        if (error && !job.error)
+            job.error = error;
+
+        ++job.finishedTasks;
+        if (job.finishedTasks == job.taskCount)
+            m_jobDone.notify_all();
+
+        return true;
+    }
+
+    void ThreadPool::dispatch(size_t taskCount, void (*invoke)(void*, size_t), void* context)
+    {
+        Job job{ invoke, context, taskCount, 0, 0, nullptr };
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_jobs.push_back(&job);
+        m_wakeUp.notify_all();
+        m_jobDone.notify_all();
+
+        while (runOneTask(lock, job)) {}
+
+        // Rather than sleeping while other threads finish this job, help with the pending ones, the most recent (the
+        // most deeply nested) first: a fork-join recursion keeps every thread busy
+        while (job.finishedTasks != job.taskCount)
+        {
+            if (m_jobs.empty())
+                m_jobDone.wait(lock);
+            else
+                runOneTask(lock, *m_jobs.back());
+        }
+
+        if (job.error)
+            std::rethrow_exception(job.error);
+    }
+
+    void ThreadPool::workerLoop()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+            m_wakeUp.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+            if (m_jobs.empty())
+                return;
+
+            runOneTask(lock, *m_jobs.front());
+        }
+    }
+};